@@ -0,0 +1,326 @@
+// librvsim: the C API of librvsim.h on top of the simulator's functions. The simulator keeps one machine in its
+// globals; every call first makes its machine the current one. The registers, CSRs and timer of the machine
+// that was current are saved with captureState and the new one's restored, memory is pointed at the new
+// machine's RAM and guestFds swapped with the machine's files, so switching does not copy memory. A program that ends goes through endHook, which unwinds to
+// rvsim_run instead of ending the process.
+//
+//   g++ -O2 -fPIC -fvisibility=hidden -shared -o librvsim.so librvsim.cpp
+#define RVSIM_NO_MAIN
+#include "rvsim.cpp"
+#include "librvsim.h"
+
+// what the program prints, to the machine's callback or the host's stdout
+class MachineOutput : public streambuf
+{
+  public:
+    rvsim_machine *machine;
+
+  protected:
+    streamsize xsputn(const char *s, streamsize n);
+    int overflow(int c)
+    {
+        if (c != EOF)
+        {
+            char ch = c;
+            xsputn(&ch, 1);
+        }
+        return c;
+    }
+};
+
+struct rvsim_machine
+{
+    vector<unsigned char> ram;
+    ReverseCheckpoint state; // while another machine is current; without memory
+    unsigned int heapStart;
+    vector<int> fds; // guestFds while another machine is current
+    bool ended;
+    int status;
+    stringbuf messages;
+    string messagesText;
+    MachineOutput output;
+    rvsim_ecall_fn ecall;
+    void *ecallUser;
+    rvsim_mmio_read_fn mmioRead;
+    rvsim_mmio_write_fn mmioWrite;
+    void *mmioUser;
+    rvsim_output_fn print;
+    void *printUser;
+};
+
+streamsize MachineOutput::xsputn(const char *s, streamsize n)
+{
+    if (machine->print != NULL)
+        machine->print(machine, machine->printUser, s, n);
+    else
+        fwrite(s, 1, n, stdout);
+    return n;
+}
+
+struct ProgramEnd
+{
+    int status;
+};
+
+recursive_mutex libraryLock; // callbacks run with it held and may call back in
+rvsim_machine *currentMachine = NULL;
+ReverseCheckpoint resetState; // a machine before a program is loaded
+
+void libraryEnd(int status)
+{
+    throw ProgramEnd{status};
+}
+
+bool libraryEcall()
+{
+    rvsim_machine *m = currentMachine;
+    return m->ecall != NULL && m->ecall(m, m->ecallUser) != 0;
+}
+
+bool libraryMmioRead(unsigned int addr, int size, unsigned int &data)
+{
+    rvsim_machine *m = currentMachine;
+    return m->mmioRead != NULL && m->mmioRead(m, m->mmioUser, addr, size, &data) != 0;
+}
+
+bool libraryMmioWrite(unsigned int addr, int size, unsigned int data)
+{
+    rvsim_machine *m = currentMachine;
+    return m->mmioWrite != NULL && m->mmioWrite(m, m->mmioUser, addr, size, data) != 0;
+}
+
+// the settings of rvsim.exe --quiet, once per process
+void libraryInit()
+{
+    static bool done = false;
+    if (done)
+        return;
+    done = true;
+    quietMode = true;
+    asyncIo = false; // host writes are done before the call that made them returns
+    endHook = libraryEnd;
+    ecallHook = libraryEcall;
+    mmioReadHook = libraryMmioRead;
+    mmioWriteHook = libraryMmioWrite;
+    vecSelectKernel();
+    predecodeInit(0x00010000);
+    captureState(resetState, false);
+}
+
+void machineEnter(rvsim_machine *m)
+{
+    if (currentMachine == m)
+        return;
+    if (currentMachine != NULL)
+    {
+        captureState(currentMachine->state, false);
+        currentMachine->heapStart = heapStart;
+        currentMachine->fds.swap(guestFds);
+    }
+    restoreState(m->state);
+    memory = &m->ram[0];
+    heapStart = m->heapStart;
+    guestFds.swap(m->fds);
+    idleDistance = IDLE_MIN_PERIOD;
+    currentMachine = m;
+}
+
+// the files the program opened, as rvfuzz's fuzzReset closes them; the host's stdin, stdout and stderr stay
+void closeFiles(vector<int> &fds)
+{
+    for (unsigned int fd = 3; fd < fds.size(); fd++)
+        if (fds[fd] >= 0)
+            close(fds[fd]);
+    fds.resize(3);
+}
+
+extern "C" {
+
+rvsim_machine *rvsim_create(void)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    libraryInit();
+    rvsim_machine *m = new rvsim_machine();
+    m->ram.assign(MEMORY_SIZE, 0);
+    m->state = resetState;
+    m->heapStart = 0x00010000;
+    for (int fd = 0; fd < 3; fd++)
+        m->fds.push_back(fd);
+    m->ended = false;
+    m->status = 0;
+    m->output.machine = m;
+    return m;
+}
+
+void rvsim_destroy(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    if (m == NULL)
+        return;
+    if (currentMachine == m)
+    {
+        currentMachine = NULL;
+        memory = mainMemory;
+        m->fds.swap(guestFds);
+    }
+    closeFiles(m->fds);
+    delete m;
+}
+
+int rvsim_load(rvsim_machine *m, const void *text, size_t text_size, const void *data, size_t data_size)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    if (text_size > 0x00010000 || data_size > MEMORY_SIZE - 0x00010000)
+        return -1;
+    machineEnter(m);
+    restoreState(resetState);
+    closeFiles(guestFds);
+    fill(m->ram.begin(), m->ram.end(), 0);
+    loadProgram(vector<unsigned char>((const unsigned char *)text, (const unsigned char *)text + text_size),
+                vector<unsigned char>((const unsigned char *)data, (const unsigned char *)data + data_size));
+    m->ended = false;
+    m->status = 0;
+    m->messages.str("");
+    return 0;
+}
+
+int rvsim_load_files(rvsim_machine *m, const char *text_path, const char *data_path)
+{
+    vector<unsigned char> files[2];
+    const char *paths[2] = {text_path, data_path};
+    for (int i = 0; i < 2; i++)
+    {
+        if (paths[i] == NULL)
+            continue;
+        ifstream file(paths[i], ios::in | ios::binary);
+        if (!file.is_open())
+            return -1;
+        files[i].assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    return rvsim_load(m, files[0].data(), files[0].size(), files[1].data(), files[1].size());
+}
+
+int rvsim_run(rvsim_machine *m, uint64_t instructions)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    if (m->ended)
+        return RVSIM_EXITED;
+
+    // the trace is dropped and the simulator's messages are kept for rvsim_messages
+    streambuf *trace = cout.rdbuf(&m->messages);
+    ios::iostate traceState = cout.rdstate();
+    cout.setstate(ios::badbit);
+    guestOut.rdbuf(&m->output);
+    guestOut.clear();
+    runStopRequested = false;
+
+    int event = RVSIM_BUDGET;
+    try
+    {
+        if (!runUntil(instructions > ~0ULL - instCount ? ~0ULL : instCount + instructions))
+        {
+            m->ended = true;
+            event = RVSIM_EXITED;
+        }
+        else if (runStopRequested)
+            event = RVSIM_STOPPED;
+    }
+    catch (const ProgramEnd &end)
+    {
+        m->ended = true;
+        m->status = end.status;
+        event = RVSIM_EXITED;
+    }
+    runStopRequested = false;
+    cout.rdbuf(trace);
+    cout.clear(traceState);
+    guestOut.rdbuf(NULL);
+    return event;
+}
+
+void rvsim_stop(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    if (currentMachine == m)
+        runStopRequested = true;
+}
+
+int rvsim_exit_status(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    return m->status;
+}
+
+uint64_t rvsim_instret(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    return instCount;
+}
+
+const char *rvsim_messages(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    m->messagesText = m->messages.str();
+    return m->messagesText.c_str();
+}
+
+uint32_t rvsim_get_pc(rvsim_machine *m)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    return pc;
+}
+
+void rvsim_set_pc(rvsim_machine *m, uint32_t value)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    pc = value;
+}
+
+uint32_t rvsim_get_reg(rvsim_machine *m, unsigned int n)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    return n == 0 || n >= 32 ? 0 : reg[n];
+}
+
+void rvsim_set_reg(rvsim_machine *m, unsigned int n, uint32_t value)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    machineEnter(m);
+    if (n != 0 && n < 32)
+        reg[n] = value;
+}
+
+uint8_t *rvsim_memory(rvsim_machine *m, size_t *size)
+{
+    if (size != NULL)
+        *size = MEMORY_SIZE;
+    return &m->ram[0];
+}
+
+void rvsim_on_ecall(rvsim_machine *m, rvsim_ecall_fn fn, void *user)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    m->ecall = fn;
+    m->ecallUser = user;
+}
+
+void rvsim_on_mmio(rvsim_machine *m, rvsim_mmio_read_fn read, rvsim_mmio_write_fn write, void *user)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    m->mmioRead = read;
+    m->mmioWrite = write;
+    m->mmioUser = user;
+}
+
+void rvsim_on_output(rvsim_machine *m, rvsim_output_fn fn, void *user)
+{
+    lock_guard<recursive_mutex> lock(libraryLock);
+    m->print = fn;
+    m->printUser = user;
+}
+}
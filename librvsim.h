@@ -0,0 +1,74 @@
+/* librvsim: the simulator as a library, for host programs that run many short simulations without starting a
+ * process for each. Build it from librvsim.cpp (see the README) and link with -lstdc++ -lpthread.
+ *
+ *   rvsim_machine *m = rvsim_create();
+ *   if (rvsim_load_files(m, "t1.bin", "t1-d.bin") == 0 && rvsim_run(m, 1000000) == RVSIM_EXITED)
+ *       printf("exit %d after %llu instructions\n", rvsim_exit_status(m), (unsigned long long)rvsim_instret(m));
+ *   rvsim_destroy(m);
+ *
+ * Machines are independent: each has its own memory, registers, CSRs and timer. The calls may come from any
+ * thread, but only one machine runs at a time. A callback runs in the middle of an instruction and may only
+ * use the machine it is called for. */
+#ifndef LIBRVSIM_H
+#define LIBRVSIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RVSIM_EXPORT __attribute__((visibility("default")))
+
+typedef struct rvsim_machine rvsim_machine;
+
+/* why rvsim_run returned */
+enum rvsim_event
+{
+    RVSIM_BUDGET = 0,  /* the instructions asked for have run */
+    RVSIM_EXITED = 1,  /* the program ended: exit, a fault with no trap handler, a zero instruction, an endless loop */
+    RVSIM_STOPPED = 2  /* a callback called rvsim_stop */
+};
+
+/* return nonzero when handled; an ECALL that is not handled goes to the simulator's own system calls */
+typedef int (*rvsim_ecall_fn)(rvsim_machine *m, void *user);
+/* loads and stores outside RAM (0 to 0x13fff) and the CLINT; unhandled ones are access faults */
+typedef int (*rvsim_mmio_read_fn)(rvsim_machine *m, void *user, uint32_t addr, int size, uint32_t *value);
+typedef int (*rvsim_mmio_write_fn)(rvsim_machine *m, void *user, uint32_t addr, int size, uint32_t value);
+/* what the program prints on stdout and stderr; without one it goes to the host's stdout */
+typedef void (*rvsim_output_fn)(rvsim_machine *m, void *user, const char *text, size_t size);
+
+RVSIM_EXPORT rvsim_machine *rvsim_create(void);
+RVSIM_EXPORT void rvsim_destroy(rvsim_machine *m);
+
+/* reset the machine and load a program: the text at 0, the data at 0x10000; 0, or -1 if it does not fit */
+RVSIM_EXPORT int rvsim_load(rvsim_machine *m, const void *text, size_t text_size, const void *data, size_t data_size);
+/* the same from files, as rvsim.exe takes them; data_path may be NULL; -1 if a file cannot be read */
+RVSIM_EXPORT int rvsim_load_files(rvsim_machine *m, const char *text_path, const char *data_path);
+
+/* run at least the given number of instructions (a loop run natively may go a little past) or until an event */
+RVSIM_EXPORT int rvsim_run(rvsim_machine *m, uint64_t instructions);
+/* from a callback: rvsim_run returns RVSIM_STOPPED after the current instruction */
+RVSIM_EXPORT void rvsim_stop(rvsim_machine *m);
+RVSIM_EXPORT int rvsim_exit_status(rvsim_machine *m);
+RVSIM_EXPORT uint64_t rvsim_instret(rvsim_machine *m);
+/* what the simulator reported for the machine, e.g. an access fault; valid until the next call for it */
+RVSIM_EXPORT const char *rvsim_messages(rvsim_machine *m);
+
+RVSIM_EXPORT uint32_t rvsim_get_pc(rvsim_machine *m);
+RVSIM_EXPORT void rvsim_set_pc(rvsim_machine *m, uint32_t pc);
+RVSIM_EXPORT uint32_t rvsim_get_reg(rvsim_machine *m, unsigned int n);
+RVSIM_EXPORT void rvsim_set_reg(rvsim_machine *m, unsigned int n, uint32_t value);
+/* the machine's RAM itself, guest address 0 at index 0; valid until rvsim_destroy */
+RVSIM_EXPORT uint8_t *rvsim_memory(rvsim_machine *m, size_t *size);
+
+RVSIM_EXPORT void rvsim_on_ecall(rvsim_machine *m, rvsim_ecall_fn fn, void *user);
+RVSIM_EXPORT void rvsim_on_mmio(rvsim_machine *m, rvsim_mmio_read_fn read, rvsim_mmio_write_fn write, void *user);
+RVSIM_EXPORT void rvsim_on_output(rvsim_machine *m, rvsim_output_fn fn, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+// librvsim_test: checks that two machines of librvsim keep their own state while they take turns, including
+// the files their programs open. It exits with 1 and names the first check that failed.
+//
+//   g++ -O2 -o librvsim_test librvsim_test.cpp librvsim.cpp
+//   librvsim_test
+#include <cstdio>
+#include <string>
+#include <dirent.h>
+#include "librvsim.h"
+
+using namespace std;
+
+// opens /dev/null twice and prints each guest fd it gets, then exits with 0
+const uint32_t openTwice[] = {
+    0xf9c00513, // li a0, -100 (AT_FDCWD)
+    0x000105b7, // lui a1, 0x10 (the path, at the start of the data)
+    0x00000613, // li a2, 0 (O_RDONLY)
+    0x03800893, // li a7, 56 (openat)
+    0x00000073, // ecall
+    0x00100893, // li a7, 1
+    0x00000073, // ecall
+    0xf9c00513, // li a0, -100
+    0x000105b7, // lui a1, 0x10
+    0x00000613, // li a2, 0
+    0x03800893, // li a7, 56
+    0x00000073, // ecall
+    0x00100893, // li a7, 1
+    0x00000073, // ecall
+    0x00000513, // li a0, 0
+    0x05d00893, // li a7, 93 (exit)
+    0x00000073, // ecall
+};
+const char path[] = "/dev/null";
+const int FIRST_PRINT = 7; // instructions up to the first print
+
+int failures = 0;
+
+void collect(rvsim_machine *, void *user, const char *text, size_t size)
+{
+    ((string *)user)->append(text, size);
+}
+
+void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("librvsim_test: %s\n", what);
+        failures++;
+    }
+}
+
+// the host's open descriptors
+int openFds()
+{
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == NULL)
+        return -1;
+    int count = 0;
+    while (readdir(dir) != NULL)
+        count++;
+    closedir(dir);
+    return count;
+}
+
+int main()
+{
+    int fdsBefore = openFds();
+    string outA, outB;
+    rvsim_machine *a = rvsim_create();
+    rvsim_machine *b = rvsim_create();
+    rvsim_on_output(a, collect, &outA);
+    rvsim_on_output(b, collect, &outB);
+
+    // a opens its first file, then b runs all the way, then a finishes
+    check(rvsim_load(a, openTwice, sizeof(openTwice), path, sizeof(path)) == 0, "loading a failed");
+    check(rvsim_load(b, openTwice, sizeof(openTwice), path, sizeof(path)) == 0, "loading b failed");
+    check(rvsim_run(a, FIRST_PRINT) == RVSIM_BUDGET, "a ended early");
+    check(rvsim_run(b, 1000) == RVSIM_EXITED && rvsim_exit_status(b) == 0, "b did not exit with 0");
+    check(rvsim_run(a, 1000) == RVSIM_EXITED && rvsim_exit_status(a) == 0, "a did not exit with 0");
+    check(outA == "3\n4\n", "a's files were not numbered 3 and 4");
+    check(outB == "3\n4\n", "b's files were not numbered 3 and 4: b shares a's file table");
+    check(rvsim_get_pc(a) == rvsim_get_pc(b) && rvsim_instret(a) == rvsim_instret(b), "a and b ended differently");
+
+    // loading a program again closes the files of the last one; a is left with its files open
+    outA.clear();
+    check(rvsim_load(a, openTwice, sizeof(openTwice), path, sizeof(path)) == 0, "reloading a failed");
+    check(rvsim_run(a, FIRST_PRINT) == RVSIM_BUDGET && outA == "3\n", "a reloaded did not get fd 3 again");
+
+    // destroying a machine, current or not, closes its files
+    rvsim_destroy(b);
+    rvsim_destroy(a);
+    check(openFds() == fdsBefore, "host descriptors were left open");
+
+    if (failures == 0)
+        printf("librvsim_test: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
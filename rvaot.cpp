@@ -0,0 +1,357 @@
+// Ahead-of-time translator: turns the text of a program into C++ that is built together with the simulator.
+// The control flow is followed from the entry point (and from the functions of --elf): branch and jump
+// targets, the return address after every call, and the instruction after every jump, which also finds jump
+// tables and code only reached through pointers. Each address found starts a block that runs on through
+// not-taken branches up to the next jump, taken branch or BLOCK_MAX instructions. RV32I computation, loads,
+// stores, branches and jumps become C++; everything else (M, Zba/Zbb, V, CSRs, ECALL, ...) calls instDecExec()
+// with the decoded word, so it behaves exactly as when interpreted. Indirect jumps go back to simulateStep,
+// which looks the target up in aotBlocks and interprets what the translation did not find.
+//
+//   g++ -O2 -o rvaot rvaot.cpp
+//   rvaot <text.bin> [--elf <file>] [-o <out.cpp>]
+//   g++ -O2 -I<simulator directory> -o prog_aot prog_aot.cpp
+//   prog_aot <text.bin> [<data.bin>] --quiet
+#define RVSIM_NO_MAIN
+#include "rvsim.cpp"
+
+const unsigned int BLOCK_MAX = 64;
+
+struct AotInst
+{
+    unsigned int addr, next;
+    unsigned int word; // a compressed instruction as decompress() expands it
+    bool compressed;
+    string mnemonic;
+};
+
+unsigned int textEnd = 0;
+
+// false where the interpreter would stop or fault
+bool aotDecode(unsigned int addr, AotInst &in)
+{
+    if (addr & 1 || addr + 2 > textEnd)
+        return false;
+    unsigned int h = memory[addr] | (memory[addr + 1] << 8);
+    in.addr = addr;
+    in.compressed = (h & 3) != 3;
+    if (in.compressed)
+    {
+        if (h == 0)
+            return false;
+        const char *base;
+        in.mnemonic = rvcMnemonic(h, &base);
+        pc = addr + 2;
+        in.word = decompress(h);
+        in.next = addr + 2;
+        return in.word != 0; // the interpreter stops at an illegal compressed instruction
+    }
+    if (addr + 4 > textEnd)
+        return false;
+    in.word = fetchWord(addr);
+    const char *m = baseMnemonic(in.word);
+    in.mnemonic = m != NULL ? m : "?";
+    in.next = addr + 4;
+    return true;
+}
+
+enum AotKind
+{
+    AOT_ALU,
+    AOT_LOAD,
+    AOT_STORE,
+    AOT_BRANCH,
+    AOT_JAL,
+    AOT_JALR,
+    AOT_OTHER // run by instDecExec()
+};
+
+// the cases of instDecExec() that are translated, checked in the same order
+AotKind aotKind(unsigned int w)
+{
+    unsigned int opcode = w & 0x7F, funct3 = (w >> 12) & 7, funct7 = w >> 25;
+    if ((opcode == 0x33 && funct7 == 0x01) || bitmanipMnemonic(w) != NULL)
+        return AOT_OTHER;
+    switch (opcode)
+    {
+    case 0x33:
+        if (funct3 == 0)
+            return funct7 == 0x00 || funct7 == 0x20 ? AOT_ALU : AOT_OTHER;
+        return funct7 == 0x00 ? AOT_ALU : AOT_OTHER; // SRA is left to the interpreter
+    case 0x13:
+        return funct3 != 5 || funct7 == 0x00 || funct7 == 0x20 ? AOT_ALU : AOT_OTHER;
+    case 0x37:
+    case 0x17:
+        return AOT_ALU;
+    case 0x03:
+        return funct3 == 3 || funct3 > 5 ? AOT_OTHER : AOT_LOAD;
+    case 0x23:
+        return funct3 > 2 ? AOT_OTHER : AOT_STORE;
+    case 0x63:
+        return funct3 == 2 || funct3 == 3 ? AOT_OTHER : AOT_BRANCH;
+    case 0x6F:
+        return AOT_JAL;
+    case 0x67:
+        return funct3 == 0 ? AOT_JALR : AOT_OTHER;
+    }
+    return AOT_OTHER;
+}
+
+string aotHex(unsigned int value)
+{
+    ostringstream s;
+    s << "0x" << hex << value << "u";
+    return s.str();
+}
+
+string aotReg(unsigned int r)
+{
+    return r == 0 ? "0u" : "reg[" + to_string(r) + "]";
+}
+
+// the C++ expression for an ALU instruction
+string aotAlu(const AotInst &in)
+{
+    unsigned int w = in.word, opcode = w & 0x7F, funct3 = (w >> 12) & 7, funct7 = w >> 25;
+    unsigned int I_imm, S_imm, B_imm, U_imm, J_imm;
+    extractImmediates(w, I_imm, S_imm, B_imm, U_imm, J_imm);
+    string a = aotReg((w >> 15) & 0x1F);
+    string b = opcode == 0x33 ? aotReg((w >> 20) & 0x1F) : aotHex(I_imm);
+
+    if (opcode == 0x37)
+        return aotHex(U_imm);
+    if (opcode == 0x17)
+        return aotHex(in.addr + U_imm);
+    switch (funct3)
+    {
+    case 0:
+        return a + (opcode == 0x33 && funct7 == 0x20 ? " - " : " + ") + b;
+    case 1:
+        return a + " << (" + b + " & 31)";
+    case 2:
+        return "((int)" + a + " < (int)" + b + " ? 1u : 0u)";
+    case 3:
+        return "(" + a + " < " + b + " ? 1u : 0u)";
+    case 4:
+        return a + " ^ " + b;
+    case 5:
+        if (funct7 == 0x20) // SRAI
+            return "(unsigned int)((int)" + a + " >> (" + b + " & 31))";
+        return a + " >> (" + b + " & 31)";
+    case 6:
+        return a + " | " + b;
+    default:
+        return a + " & " + b;
+    }
+}
+
+// one block as a function; false if there is no instruction at addr
+bool aotBlock(ostream &out, unsigned int start)
+{
+    vector<AotInst> body;
+    AotInst in;
+    for (unsigned int addr = start; body.size() < BLOCK_MAX && aotDecode(addr, in); addr = in.next)
+    {
+        body.push_back(in);
+        AotKind kind = aotKind(in.word);
+        if (kind == AOT_JAL || kind == AOT_JALR)
+            break;
+    }
+    if (body.empty())
+        return false;
+
+    unsigned int end = body.back().next;
+    out << "\n// 0x" << hex << start << "-0x" << end - 1 << "\n";
+    out << "static int aot_" << setfill('0') << setw(8) << start << setfill(' ') << "()\n{\n";
+    out << "    static const unsigned char code[] = {";
+    for (unsigned int addr = start; addr < end; addr++)
+        out << (addr == start ? "" : ", ") << dec << (unsigned int)memory[addr];
+    out << "};\n";
+    out << "    if (memcmp(memory + " << aotHex(start) << ", code, sizeof(code)) != 0)\n";
+    out << "        return AOT_CHANGED;\n";
+    for (unsigned int i = 0; i < body.size(); i++)
+        if (aotKind(body[i].word) == AOT_LOAD)
+        {
+            out << "    unsigned int t;\n";
+            break;
+        }
+
+    unsigned int pending = 0; // instructions not yet added to instCount
+    for (unsigned int i = 0; i < body.size(); i++)
+    {
+        const AotInst &in = body[i];
+        unsigned int w = in.word, rd = (w >> 7) & 0x1F, funct3 = (w >> 12) & 7;
+        unsigned int I_imm, S_imm, B_imm, U_imm, J_imm;
+        extractImmediates(w, I_imm, S_imm, B_imm, U_imm, J_imm);
+        string rs1 = aotReg((w >> 15) & 0x1F), rs2 = aotReg((w >> 20) & 0x1F), next = aotHex(in.next);
+        AotKind kind = aotKind(w);
+
+        out << "    // 0x" << hex << in.addr << ": " << in.mnemonic << "\n";
+        pending++;
+        if (kind == AOT_ALU)
+        {
+            if (rd != 0)
+                out << "    reg[" << dec << rd << "] = " << aotAlu(in) << ";\n";
+            continue;
+        }
+
+        // instCount and currentPC as the interpreter has them, for the timer, traps and loop idioms
+        out << "    instCount += " << dec << pending << ";\n";
+        out << "    currentPC = " << aotHex(in.addr) << ";\n";
+        pending = 0;
+        switch (kind)
+        {
+        case AOT_LOAD:
+        {
+            static const char *extend[6] = {"(unsigned int)(int)(signed char)t", "(unsigned int)(int)(short)t", "t", "", "t & 0xFF", "t & 0xFFFF"};
+            out << "    t = memRead(" << rs1 << " + " << aotHex(I_imm) << ", " << (1 << (funct3 & 3)) << ");\n";
+            out << "    if (memFault)\n        return aotEnd(" << next << ");\n";
+            if (rd != 0)
+                out << "    reg[" << rd << "] = " << extend[funct3] << ";\n";
+            break;
+        }
+        case AOT_STORE:
+        {
+            static const char *mask[3] = {" & 0xFF", " & 0xFFFF", ""};
+            out << "    memWrite(" << rs1 << " + " << aotHex(S_imm) << ", " << (1 << funct3) << ", " << rs2 << mask[funct3] << ");\n";
+            out << "    if (memFault)\n        return aotEnd(" << next << ");\n";
+            break;
+        }
+        case AOT_BRANCH:
+        {
+            static const char *compare[8] = {"==", "!=", "", "", "<", ">=", "<", ">="};
+            bool sign = funct3 == 4 || funct3 == 5;
+            out << "    if (" << (sign ? "(int)" : "") << rs1 << " " << compare[funct3] << " " << (sign ? "(int)" : "") << rs2 << ")\n";
+            out << "    {\n        pc = " << aotHex(in.addr + B_imm) << ";\n        return aotEnd(" << next << ");\n    }\n";
+            break;
+        }
+        case AOT_JAL:
+            if (rd != 0)
+                out << "    reg[" << rd << "] = " << next << ";\n";
+            out << "    pc = " << aotHex(in.addr + J_imm) << ";\n";
+            out << "    return aotEnd(" << next << ");\n";
+            break;
+        case AOT_JALR:
+            // the target is read before the link is written
+            out << "    pc = " << rs1 << " + " << aotHex(I_imm) << ";\n";
+            if (rd != 0)
+                out << "    reg[" << rd << "] = " << next << ";\n";
+            out << "    return aotEnd(" << next << ");\n";
+            break;
+        default:
+            out << "    pc = " << next << ";\n";
+            out << "    instDecExec(" << aotHex(w) << ", " << (in.compressed ? "1" : "0") << ");\n";
+            out << "    reg[0] = 0;\n";
+            out << "    if (pc != " << next << ")\n        return aotEnd(" << next << ");\n";
+            break;
+        }
+    }
+
+    AotKind last = aotKind(body.back().word);
+    if (last != AOT_JAL && last != AOT_JALR)
+    {
+        if (pending != 0)
+            out << "    instCount += " << dec << pending << ";\n";
+        out << "    pc = " << aotHex(end) << ";\n";
+        out << "    return AOT_CONTINUE;\n";
+    }
+    out << "}\n";
+    return true;
+}
+
+// the start of every block: the entry point, the functions from --elf, and what the control flow reaches
+set<unsigned int> aotFindBlocks()
+{
+    set<unsigned int> starts, walked;
+    vector<unsigned int> work(1, 0);
+    for (map<unsigned int, Symbol>::iterator it = symbols.begin(); it != symbols.end(); it++)
+        if (it->second.isFunction)
+            work.push_back(it->first);
+
+    while (!work.empty())
+    {
+        unsigned int addr = work.back();
+        work.pop_back();
+        AotInst in;
+        if (starts.count(addr) || !aotDecode(addr, in))
+            continue;
+        starts.insert(addr);
+        for (; !walked.count(addr) && aotDecode(addr, in); addr = in.next)
+        {
+            walked.insert(addr);
+            unsigned int I_imm, S_imm, B_imm, U_imm, J_imm;
+            extractImmediates(in.word, I_imm, S_imm, B_imm, U_imm, J_imm);
+            AotKind kind = aotKind(in.word);
+            if (kind == AOT_BRANCH)
+                work.push_back(in.addr + B_imm);
+            if (kind == AOT_JAL)
+                work.push_back(in.addr + J_imm);
+            if (kind == AOT_JAL || kind == AOT_JALR)
+            {
+                work.push_back(in.next); // the return address, or whatever follows a jump
+                break;
+            }
+        }
+    }
+    return starts;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *textName = NULL;
+    string outName;
+    const char *usage = "use: rvaot <text.bin> [--elf <file>] [-o <out.cpp>]\n"
+                        "  --elf <file>  also start blocks at the functions of the ELF symbol table\n"
+                        "  -o <file>     the C++ file to write (default: <text>_aot.cpp)\n";
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--elf" && i + 1 < argc)
+            loadSymbols(argv[++i]);
+        else if (arg == "-o" && i + 1 < argc)
+            outName = argv[++i];
+        else if (textName == NULL && arg[0] != '-')
+            textName = argv[i];
+        else
+            emitError(usage);
+    }
+    if (textName == NULL)
+        emitError(usage);
+    if (outName.empty())
+    {
+        outName = textName;
+        if (outName.size() > 4 && outName.compare(outName.size() - 4, 4, ".bin") == 0)
+            outName.erase(outName.size() - 4);
+        outName += "_aot.cpp";
+    }
+
+    ifstream textFile(textName, ios::in | ios::binary);
+    if (!textFile.is_open())
+        emitError("Cannot open the text file\n");
+    textFile.read((char *)memory, 0x10000); // the text ends where the data section starts
+    textEnd = textFile.gcount();
+
+    quietMode = true;
+    cout.setstate(ios::badbit); // decompress() traces
+    set<unsigned int> starts = aotFindBlocks();
+
+    ofstream out(outName.c_str());
+    if (!out.is_open())
+        emitError("Cannot create the output file\n");
+    out << "// Translated by rvaot from " << textName << ": " << dec << starts.size() << " blocks in " << textEnd
+        << " bytes of text. Build it with the simulator and run it like rvsim, with --quiet:\n"
+        << "//   g++ -O2 -I<simulator directory> -o prog_aot " << outName << "\n"
+        << "#define RVSIM_AOT\n"
+        << "#include \"rvsim.cpp\"\n";
+    for (set<unsigned int>::iterator it = starts.begin(); it != starts.end(); it++)
+        aotBlock(out, *it);
+    out << "\nvoid aotRegister()\n{\n";
+    for (set<unsigned int>::iterator it = starts.begin(); it != starts.end(); it++)
+        out << "    aotBlocks[0x" << hex << *it << " >> 1] = aot_" << setfill('0') << setw(8) << *it << setfill(' ') << ";\n";
+    out << "}\n";
+    if (!out)
+        emitError("Cannot write the output file\n");
+
+    cout.clear();
+    cout << outName << ": " << dec << starts.size() << " blocks\n";
+    return 0;
+}
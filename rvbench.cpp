@@ -0,0 +1,651 @@
+// Host-side microbenchmarks for the simulator's hot paths:
+// - decompress() over every 16-bit encoding;
+// - the immediate extraction done by instDecExec();
+// - instruction fetch from memory[];
+// - whole-loop dispatch (simulateStep) on synthetic instruction streams.
+// Each benchmark is calibrated to about 20 ms per repetition, warmed up, and then timed over --reps
+// repetitions. The median and the 10th/90th percentiles are printed; --json also saves them, to diff
+// between commits.
+// With --guest it instead runs the guest benchmark corpus (dhrystone, coremark, ... in tests-rv32i and
+// tests-rv32ic) through a simulator binary in each mode, and reports instret, time and MIPS.
+//
+//   g++ -O2 -o rvbench rvbench.cpp
+//   rvbench [--reps <N>] [--json <file>] [--filter <text>]
+//   rvbench --guest [--sim <rvsim>] [--reps <N>] [--json <file>] [--filter <text>]
+// rvbench --check-rvc is a correctness check instead: it compares decompress() with the spec's RVC tables.
+#define RVSIM_NO_MAIN
+#include "rvsim.cpp"
+
+const int BENCH_WARMUP = 3;
+const double BENCH_TARGET_NS = 20e6; // per repetition
+const unsigned long long DISPATCH_PASS = 100000;
+
+struct Benchmark
+{
+    const char *name;
+    const char *unit;
+    void (*setup)();
+    unsigned long long (*run)(); // one pass; returns the number of units done
+};
+
+struct BenchResult
+{
+    string name, unit;
+    unsigned long long units; // per repetition
+    double medianNs, p10Ns, p90Ns, minNs; // per unit
+};
+
+volatile unsigned int benchSink; // keeps the compiler from dropping the measured work
+vector<unsigned short> rvcEncodings;
+vector<unsigned int> randomWords;
+vector<unsigned int> randomAddrs;
+
+// a fixed xorshift sequence, so every run measures the same inputs
+unsigned int benchRandom()
+{
+    static unsigned int x = 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+void setupDecompress()
+{
+    rvcEncodings.clear();
+    for (unsigned int h = 0; h < 0x10000; h++)
+        if ((h & 0x3) != 0x3)
+            rvcEncodings.push_back(h);
+    pc = 2; // decompress traces pc - 2
+}
+
+unsigned long long runDecompress()
+{
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < rvcEncodings.size(); i++)
+        sum += decompress(rvcEncodings[i]);
+    benchSink = sum;
+    return rvcEncodings.size();
+}
+
+void setupImmediates()
+{
+    randomWords.resize(1 << 16);
+    for (unsigned int i = 0; i < randomWords.size(); i++)
+        randomWords[i] = benchRandom() | 0x3;
+}
+
+unsigned long long runImmediates()
+{
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < randomWords.size(); i++)
+    {
+        unsigned int I_imm, S_imm, B_imm, U_imm, J_imm;
+        extractImmediates(randomWords[i], I_imm, S_imm, B_imm, U_imm, J_imm);
+        sum += I_imm ^ S_imm ^ B_imm ^ U_imm ^ J_imm;
+    }
+    benchSink = sum;
+    return randomWords.size();
+}
+
+void setupFetch()
+{
+    for (unsigned int i = 0; i < MEMORY_SIZE; i++)
+        memory[i] = benchRandom();
+    randomAddrs.resize(1 << 16);
+    for (unsigned int i = 0; i < randomAddrs.size(); i++)
+        randomAddrs[i] = (benchRandom() % (MEMORY_SIZE - 4)) & ~1u;
+}
+
+unsigned long long runFetchSequential()
+{
+    unsigned int sum = 0;
+    for (unsigned int addr = 0; addr <= MEMORY_SIZE - 4; addr += 4)
+        sum += fetchWord(addr);
+    benchSink = sum;
+    return MEMORY_SIZE / 4;
+}
+
+unsigned long long runFetchRandom()
+{
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < randomAddrs.size(); i++)
+        sum += fetchWord(randomAddrs[i]);
+    benchSink = sum;
+    return randomAddrs.size();
+}
+
+// Synthetic instruction streams. Each is an endless loop at address 0 that changes some register or memory
+// on every iteration, so idle detection never stops it.
+unsigned int encR(unsigned int funct7, unsigned int rs2, unsigned int rs1, unsigned int funct3, unsigned int rd, unsigned int opcode)
+{
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+unsigned int encI(int imm, unsigned int rs1, unsigned int funct3, unsigned int rd, unsigned int opcode)
+{
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+unsigned int encS(int imm, unsigned int rs2, unsigned int rs1, unsigned int funct3)
+{
+    return (((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((imm & 0x1F) << 7) | 0x23;
+}
+
+unsigned int encB(int imm, unsigned int rs2, unsigned int rs1, unsigned int funct3)
+{
+    return (((imm >> 12) & 1) << 31) | (((imm >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           (((imm >> 1) & 0xF) << 8) | (((imm >> 11) & 1) << 7) | 0x63;
+}
+
+unsigned int encJ(int imm, unsigned int rd)
+{
+    return (((imm >> 20) & 1) << 31) | (((imm >> 1) & 0x3FF) << 21) | (((imm >> 11) & 1) << 20) |
+           (((imm >> 12) & 0xFF) << 12) | (rd << 7) | 0x6F;
+}
+
+// C.J
+unsigned short encCJ(int imm)
+{
+    return (0x5 << 13) | (((imm >> 11) & 1) << 12) | (((imm >> 4) & 1) << 11) | (((imm >> 8) & 3) << 9) |
+           (((imm >> 10) & 1) << 8) | (((imm >> 6) & 1) << 7) | (((imm >> 7) & 1) << 6) | (((imm >> 1) & 7) << 3) |
+           (((imm >> 5) & 1) << 2) | 0x1;
+}
+
+// clears the machine and places the stream at 0, closed by a jump back to its start
+void loadStream(const vector<unsigned int> &words)
+{
+    memset(memory, 0, MEMORY_SIZE);
+    memset(reg, 0, sizeof(reg));
+    for (unsigned int i = 0; i < words.size(); i++)
+        for (int b = 0; b < 4; b++)
+            memory[4 * i + b] = words[i] >> (8 * b);
+    unsigned int end = 4 * words.size();
+    unsigned int jump = encJ(-(int)end, 0);
+    for (int b = 0; b < 4; b++)
+        memory[end + b] = jump >> (8 * b);
+    pc = 0;
+    reg[2] = MEMORY_SIZE - 64;
+    reg[8] = 0x10000;
+    idleSnapshot.valid = false;
+    idleDistance = IDLE_MIN_PERIOD;
+}
+
+void setupDispatchAlu()
+{
+    vector<unsigned int> w;
+    w.push_back(encI(1, 5, 0, 5, 0x13));         // addi t0, t0, 1
+    w.push_back(encR(0x00, 5, 6, 0, 6, 0x33));    // add t1, t1, t0
+    w.push_back(encR(0x00, 6, 7, 4, 7, 0x33));    // xor t2, t2, t1
+    w.push_back(encI(3, 7, 1, 28, 0x13));         // slli t3, t2, 3
+    w.push_back(encI(1, 28, 5, 29, 0x13));        // srli t4, t3, 1
+    w.push_back(encR(0x00, 29, 30, 6, 30, 0x33)); // or t5, t5, t4
+    w.push_back(encR(0x20, 30, 31, 0, 31, 0x33)); // sub t6, t6, t5
+    w.push_back(encR(0x00, 6, 31, 3, 10, 0x33));  // sltu a0, t6, t1
+    w.push_back(encR(0x01, 5, 6, 0, 11, 0x33));   // mul a1, t1, t0
+    loadStream(w);
+}
+
+void setupDispatchMemory()
+{
+    vector<unsigned int> w;
+    w.push_back(encI(0, 8, 2, 5, 0x03));  // lw t0, 0(s0)
+    w.push_back(encI(1, 5, 0, 5, 0x13));  // addi t0, t0, 1
+    w.push_back(encS(0, 5, 8, 2));        // sw t0, 0(s0)
+    w.push_back(encI(4, 8, 2, 6, 0x03));  // lw t1, 4(s0)
+    w.push_back(encR(0, 5, 6, 0, 6, 0x33)); // add t1, t1, t0
+    w.push_back(encS(4, 6, 8, 2));        // sw t1, 4(s0)
+    w.push_back(encI(8, 8, 4, 7, 0x03));  // lbu t2, 8(s0)
+    w.push_back(encS(9, 7, 8, 0));        // sb t2, 9(s0)
+    w.push_back(encI(-4, 2, 2, 28, 0x03)); // lw t3, -4(sp)
+    w.push_back(encS(-8, 28, 2, 2));      // sw t3, -8(sp)
+    loadStream(w);
+}
+
+void setupDispatchBranch()
+{
+    vector<unsigned int> w;
+    w.push_back(encI(1, 5, 0, 5, 0x13));  // addi t0, t0, 1
+    w.push_back(encI(3, 5, 7, 6, 0x13));  // andi t1, t0, 3
+    w.push_back(encB(8, 0, 6, 0));        // beq t1, zero, +8
+    w.push_back(encI(1, 7, 0, 7, 0x13));  // addi t2, t2, 1
+    w.push_back(encI(1, 5, 7, 28, 0x13)); // andi t3, t0, 1
+    w.push_back(encB(8, 0, 28, 1));       // bne t3, zero, +8
+    w.push_back(encI(1, 29, 0, 29, 0x13)); // addi t4, t4, 1
+    w.push_back(encB(-28, 0, 0, 1));      // bne zero, zero, -28 (never taken)
+    loadStream(w);
+}
+
+void setupDispatchRvc()
+{
+    static const unsigned short h[] = {
+        0x0285, // c.addi t0, 1
+        0x9316, // c.add t1, t0
+        0x839A, // c.mv t2, t1
+        0x0386, // c.slli t2, 1
+        0x0485, // c.addi s1, 1
+        0x8C25, // c.xor s0, s1
+        0xC016, // c.swsp t0, 0(sp)
+        0x4502, // c.lwsp a0, 0(sp)
+    };
+    loadStream(vector<unsigned int>());
+    unsigned int n = sizeof(h) / sizeof(h[0]);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        memory[2 * i] = h[i] & 0xFF;
+        memory[2 * i + 1] = h[i] >> 8;
+    }
+    unsigned short jump = encCJ(-(int)(2 * n));
+    memory[2 * n] = jump & 0xFF;
+    memory[2 * n + 1] = jump >> 8;
+}
+
+unsigned long long runDispatch()
+{
+    for (unsigned long long i = 0; i < DISPATCH_PASS; i++)
+        if (!simulateStep())
+        {
+            cout.clear();
+            cout << "The " << hex << pc << " stream stopped\n";
+            exit(1);
+        }
+    return DISPATCH_PASS;
+}
+
+const Benchmark benchmarks[] = {
+    {"decompress.all", "encoding", setupDecompress, runDecompress},
+    {"immediates.random", "word", setupImmediates, runImmediates},
+    {"fetch.sequential", "fetch", setupFetch, runFetchSequential},
+    {"fetch.random", "fetch", setupFetch, runFetchRandom},
+    {"dispatch.alu", "instruction", setupDispatchAlu, runDispatch},
+    {"dispatch.memory", "instruction", setupDispatchMemory, runDispatch},
+    {"dispatch.branch", "instruction", setupDispatchBranch, runDispatch},
+    {"dispatch.rvc", "instruction", setupDispatchRvc, runDispatch},
+};
+
+double percentile(const vector<double> &sorted, double p)
+{
+    double pos = p * (sorted.size() - 1);
+    unsigned int i = (unsigned int)pos;
+    if (i + 1 >= sorted.size())
+        return sorted.back();
+    return sorted[i] + (pos - i) * (sorted[i + 1] - sorted[i]);
+}
+
+BenchResult measure(const Benchmark &b, int reps)
+{
+    typedef chrono::steady_clock Clock;
+    b.setup();
+
+    // enough passes per repetition for about BENCH_TARGET_NS, found while warming up
+    unsigned long long passes = 1;
+    for (int w = 0; w < BENCH_WARMUP || w < 20; w++)
+    {
+        Clock::time_point start = Clock::now();
+        for (unsigned long long i = 0; i < passes; i++)
+            b.run();
+        double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+        if (w >= BENCH_WARMUP - 1 && ns >= BENCH_TARGET_NS / 2)
+            break;
+        if (ns < BENCH_TARGET_NS / 2)
+            passes *= 2;
+    }
+
+    vector<double> samples;
+    unsigned long long units = 0;
+    for (int r = 0; r < reps; r++)
+    {
+        units = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned long long i = 0; i < passes; i++)
+            units += b.run();
+        samples.push_back(chrono::duration<double, nano>(Clock::now() - start).count() / units);
+    }
+    sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = b.name;
+    result.unit = b.unit;
+    result.units = units;
+    result.medianNs = percentile(samples, 0.5);
+    result.p10Ns = percentile(samples, 0.1);
+    result.p90Ns = percentile(samples, 0.9);
+    result.minNs = samples[0];
+    return result;
+}
+
+void writeJson(const char *name, const vector<BenchResult> &results, int reps)
+{
+    ofstream out(name);
+    if (!out.is_open())
+        emitError("Cannot write the JSON file\n");
+    out << fixed << setprecision(3);
+    out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"repetitions\": " << reps << ",\n  \"benchmarks\": [\n";
+    for (unsigned int i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit << "\", \"units_per_rep\": " << r.units
+            << ", \"median_ns\": " << r.medianNs << ", \"p10_ns\": " << r.p10Ns << ", \"p90_ns\": " << r.p90Ns
+            << ", \"min_ns\": " << r.minNs << ", \"millions_per_s\": " << 1e3 / r.medianNs << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// The guest corpus: every program is run from both ISA builds in every mode. Each prints a checksum, which
+// must not depend on the build or the mode.
+const char *guestPrograms[] = {"dhrystone", "coremark", "crc32", "qsort", "matmult"};
+const char *guestDirs[] = {"tests-rv32i", "tests-rv32ic"};
+
+struct GuestMode
+{
+    const char *name;
+    const char *options;
+};
+
+const GuestMode guestModes[] = {
+    {"interpreter", ""},
+    {"idioms", "--idioms"},
+    {"cosim", "--idioms --cosim"},
+};
+
+struct GuestResult
+{
+    string name, checksum;
+    unsigned long long instret;
+    double medianS, minS;
+};
+
+// one run of the simulator; false if it failed or printed no --timing line
+bool guestRun(const string &command, string &checksum, unsigned long long &instret, double &seconds)
+{
+    FILE *p = popen(command.c_str(), "r");
+    if (p == NULL)
+        return false;
+    char line[256];
+    bool timed = false;
+    checksum.clear();
+    while (fgets(line, sizeof(line), p) != NULL)
+    {
+        string text = line;
+        if (text.compare(0, 8, "Timing: ") == 0)
+            timed = sscanf(line, "Timing: %llu instructions, %lf s", &instret, &seconds) == 2;
+        else if (checksum.empty() && text != "\n")
+            checksum = text.substr(0, text.find('\n'));
+    }
+    return pclose(p) == 0 && timed;
+}
+
+int runGuest(const string &sim, int reps, const string &filter, const char *jsonName)
+{
+    vector<GuestResult> results;
+    bool mismatch = false;
+    cout << left << setfill(' ') << setw(32) << "program" << right << setw(12) << "instret" << setw(10) << "median s"
+         << setw(10) << "min s" << setw(10) << "MIPS" << "  checksum\n";
+    for (unsigned int p = 0; p < sizeof(guestPrograms) / sizeof(guestPrograms[0]); p++)
+    {
+        string expected;
+        for (unsigned int d = 0; d < sizeof(guestDirs) / sizeof(guestDirs[0]); d++)
+            for (unsigned int m = 0; m < sizeof(guestModes) / sizeof(guestModes[0]); m++)
+            {
+                string dir = guestDirs[d];
+                GuestResult r;
+                r.name = string(guestPrograms[p]) + "/" + dir.substr(dir.find('-') + 1) + "/" + guestModes[m].name;
+                if (!filter.empty() && r.name.find(filter) == string::npos)
+                    continue;
+                string command = sim + " " + dir + "/" + guestPrograms[p] + ".bin --quiet --timing " + guestModes[m].options + " 2>&1";
+
+                vector<double> samples;
+                for (int i = 0; i < reps; i++)
+                {
+                    double seconds;
+                    if (!guestRun(command, r.checksum, r.instret, seconds))
+                    {
+                        cout << "Cannot run \"" << command << "\" (see --sim)\n";
+                        return 1;
+                    }
+                    samples.push_back(seconds);
+                }
+                sort(samples.begin(), samples.end());
+                r.medianS = percentile(samples, 0.5);
+                r.minS = samples[0];
+                if (expected.empty())
+                    expected = r.checksum;
+                results.push_back(r);
+
+                cout << left << setw(32) << r.name << right << setw(12) << dec << r.instret << fixed << setprecision(3)
+                     << setw(10) << r.medianS << setw(10) << r.minS << setw(10) << r.instret / r.medianS / 1e6 << "  "
+                     << r.checksum;
+                if (r.checksum != expected)
+                {
+                    cout << " (differs from " << expected << ")";
+                    mismatch = true;
+                }
+                cout << "\n";
+                cout.flush();
+            }
+    }
+
+    if (jsonName != NULL)
+    {
+        ofstream out(jsonName);
+        if (!out.is_open())
+            emitError("Cannot write the JSON file\n");
+        out << fixed << setprecision(6);
+        out << "{\n  \"simulator\": \"" << sim << "\",\n  \"repetitions\": " << reps << ",\n  \"programs\": [\n";
+        for (unsigned int i = 0; i < results.size(); i++)
+        {
+            const GuestResult &r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"instret\": " << r.instret << ", \"median_s\": " << r.medianS
+                << ", \"min_s\": " << r.minS << ", \"mips\": " << r.instret / r.medianS / 1e6 << ", \"checksum\": \""
+                << r.checksum << "\"}" << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+    return mismatch ? 1 : 0;
+}
+
+// The RV32C expansions, straight from the tables of the spec, for --check-rvc; 0 for the encodings it leaves
+// reserved, the hints and the floating-point loads and stores, which are not compared
+unsigned int rvcEncI(int imm, unsigned int rs1, unsigned int f3, unsigned int rd, unsigned int op)
+{
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+unsigned int rvcEncS(int imm, unsigned int rs2, unsigned int rs1, unsigned int f3, unsigned int op)
+{
+    return (((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | ((imm & 0x1F) << 7) | op;
+}
+
+unsigned int rvcEncR(unsigned int f7, unsigned int rs2, unsigned int rs1, unsigned int f3, unsigned int rd)
+{
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | 0x33;
+}
+
+unsigned int rvcEncB(int imm, unsigned int rs1, unsigned int f3)
+{
+    return (((imm >> 12) & 1) << 31) | (((imm >> 5) & 0x3F) << 25) | (rs1 << 15) | (f3 << 12) |
+           (((imm >> 1) & 0xF) << 8) | (((imm >> 11) & 1) << 7) | 0x63;
+}
+
+unsigned int rvcEncJ(int imm, unsigned int rd)
+{
+    return (((imm >> 20) & 1) << 31) | (((imm >> 1) & 0x3FF) << 21) | (((imm >> 11) & 1) << 20) |
+           (((imm >> 12) & 0xFF) << 12) | (rd << 7) | 0x6F;
+}
+
+int rvcSext(unsigned int value, int bits)
+{
+    return (int)(value << (32 - bits)) >> (32 - bits);
+}
+
+unsigned int rvcReference(unsigned int h)
+{
+    unsigned int f3 = (h >> 13) & 7, rd = (h >> 7) & 0x1F, rs2 = (h >> 2) & 0x1F;
+    unsigned int rdp = 8 + ((h >> 2) & 7), rs1p = 8 + ((h >> 7) & 7);
+    unsigned int b12 = (h >> 12) & 1;
+    int ci = rvcSext((b12 << 5) | rs2, 6);
+    int jimm = rvcSext((b12 << 11) | (((h >> 11) & 1) << 4) | (((h >> 9) & 3) << 8) | (((h >> 8) & 1) << 10) |
+                           (((h >> 7) & 1) << 6) | (((h >> 6) & 1) << 7) | (((h >> 3) & 7) << 1) | (((h >> 2) & 1) << 5),
+                       12);
+    unsigned int clImm = (((h >> 10) & 7) << 3) | (((h >> 6) & 1) << 2) | (((h >> 5) & 1) << 6);
+
+    switch (((h & 3) << 3) | f3)
+    {
+    case 000: // C.ADDI4SPN
+    {
+        unsigned int imm = (((h >> 11) & 3) << 4) | (((h >> 7) & 0xF) << 6) | (((h >> 6) & 1) << 2) | (((h >> 5) & 1) << 3);
+        return imm == 0 ? 0 : rvcEncI(imm, 2, 0, rdp, 0x13);
+    }
+    case 002: // C.LW
+        return rvcEncI(clImm, rs1p, 2, rdp, 0x03);
+    case 006: // C.SW
+        return rvcEncS(clImm, rdp, rs1p, 2, 0x23);
+    case 010: // C.NOP, C.ADDI
+        return (rd == 0) != (ci == 0) ? 0 : rvcEncI(ci, rd, 0, rd, 0x13);
+    case 011: // C.JAL
+        return rvcEncJ(jimm, 1);
+    case 012: // C.LI
+        return rd == 0 ? 0 : rvcEncI(ci, 0, 0, rd, 0x13);
+    case 013: // C.ADDI16SP, C.LUI
+        if (rd == 2)
+        {
+            int imm = rvcSext((b12 << 9) | (((h >> 6) & 1) << 4) | (((h >> 5) & 1) << 6) | (((h >> 3) & 3) << 7) |
+                                  (((h >> 2) & 1) << 5),
+                              10);
+            return imm == 0 ? 0 : rvcEncI(imm, 2, 0, 2, 0x13);
+        }
+        return rd == 0 || ci == 0 ? 0 : (((unsigned int)ci & 0xFFFFF) << 12) | (rd << 7) | 0x37;
+    case 014:
+        switch ((h >> 10) & 3)
+        {
+        case 0: // C.SRLI
+            return b12 || rs2 == 0 ? 0 : rvcEncI(rs2, rs1p, 5, rs1p, 0x13);
+        case 1: // C.SRAI
+            return b12 || rs2 == 0 ? 0 : rvcEncI(0x400 | rs2, rs1p, 5, rs1p, 0x13);
+        case 2: // C.ANDI
+            return rvcEncI(ci, rs1p, 7, rs1p, 0x13);
+        default: // C.SUB, C.XOR, C.OR, C.AND
+        {
+            static const unsigned int f7[4] = {0x20, 0, 0, 0}, op3[4] = {0, 4, 6, 7};
+            unsigned int k = (h >> 5) & 3;
+            return b12 ? 0 : rvcEncR(f7[k], rdp, rs1p, op3[k], rs1p);
+        }
+        }
+    case 015: // C.J
+        return rvcEncJ(jimm, 0);
+    case 016: // C.BEQZ
+    case 017: // C.BNEZ
+    {
+        int imm = rvcSext((b12 << 8) | (((h >> 10) & 3) << 3) | (((h >> 5) & 3) << 6) | (((h >> 3) & 3) << 1) |
+                              (((h >> 2) & 1) << 5),
+                          9);
+        return rvcEncB(imm, rs1p, f3 == 6 ? 0 : 1);
+    }
+    case 020: // C.SLLI
+        return b12 || rd == 0 || rs2 == 0 ? 0 : rvcEncI(rs2, rd, 1, rd, 0x13);
+    case 022: // C.LWSP
+        return rd == 0 ? 0 : rvcEncI((b12 << 5) | (((h >> 4) & 7) << 2) | (((h >> 2) & 3) << 6), 2, 2, rd, 0x03);
+    case 024:
+        if (!b12)
+        {
+            if (rs2 == 0) // C.JR
+                return rd == 0 ? 0 : rvcEncI(0, rd, 0, 0, 0x67);
+            return rd == 0 ? 0 : rvcEncR(0, rs2, 0, 0, rd); // C.MV
+        }
+        if (rs2 == 0) // C.EBREAK, C.JALR
+            return rd == 0 ? 0x00100073 : rvcEncI(0, rd, 0, 1, 0x67);
+        return rd == 0 ? 0 : rvcEncR(0, rs2, rd, 0, rd); // C.ADD
+    case 026: // C.SWSP
+        return rvcEncS((((h >> 9) & 0xF) << 2) | (((h >> 7) & 3) << 6), rs2, 2, 2, 0x23);
+    }
+    return 0;
+}
+
+// --check-rvc: decompress() against rvcReference for every 16-bit encoding that expands to something
+int checkRvc()
+{
+    cout.setstate(ios::badbit);
+    pc = 2; // decompress traces pc - 2
+    unsigned int checked = 0, wrong = 0;
+    for (unsigned int h = 0; h < 0x10000; h++)
+    {
+        unsigned int want = (h & 0x3) != 0x3 ? rvcReference(h) : 0;
+        if (want == 0)
+            continue;
+        checked++;
+        unsigned int got = decompress(h);
+        if (got != want && wrong++ < 20)
+            cerr << "rvbench: 0x" << hex << setfill('0') << setw(4) << h << " expands to 0x" << setw(8) << got
+                 << ", not 0x" << setw(8) << want << setfill(' ') << "\n";
+    }
+    cout.clear();
+    cout << dec << setfill(' ') << setw(0) << checked - wrong << " of " << checked << " RVC encodings expand as the spec says\n";
+    return wrong == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int reps = 0;
+    const char *jsonName = NULL;
+    string filter;
+    bool guest = false;
+    string sim = "./rvsim";
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--reps" && i + 1 < argc)
+            reps = max(1, atoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonName = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--guest")
+            guest = true;
+        else if (arg == "--sim" && i + 1 < argc)
+            sim = argv[++i];
+        else if (arg == "--check-rvc")
+            return checkRvc();
+        else
+            emitError("use: rvbench [--reps <N>] [--json <file>] [--filter <text>]\n"
+                      "       rvbench --guest [--sim <rvsim>] [--reps <N>] [--json <file>] [--filter <text>]\n"
+                      "       rvbench --check-rvc\n"
+                      "  --reps <N>       timed repetitions per benchmark (default 15, with --guest 3)\n"
+                      "  --json <file>    also write the results as JSON\n"
+                      "  --filter <text>  only run benchmarks whose name contains text\n"
+                      "  --guest          run the guest corpus in tests-rv32i and tests-rv32ic through the simulator\n"
+                      "  --sim <rvsim>    the simulator binary for --guest (default ./rvsim)\n"
+                      "  --check-rvc      check decompress() against the spec for every 16-bit encoding\n");
+    }
+
+    if (guest)
+        return runGuest(sim, reps != 0 ? reps : 3, filter, jsonName);
+    if (reps == 0)
+        reps = 15;
+
+    // as with --quiet: trace output is dropped before it is formatted
+    ios::sync_with_stdio(false);
+    quietMode = true;
+    idleDetect = true;
+    guestOut.setstate(ios::badbit);
+
+    vector<BenchResult> results;
+    cout << left << setfill(' ') << setw(20) << "benchmark" << right << setw(12) << "units/rep" << setw(12) << "median ns" << setw(10)
+         << "p10" << setw(10) << "p90" << setw(12) << "M/s" << "\n";
+    for (unsigned int i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+    {
+        if (!filter.empty() && string(benchmarks[i].name).find(filter) == string::npos)
+            continue;
+        cout.setstate(ios::badbit);
+        BenchResult r = measure(benchmarks[i], reps);
+        cout.clear();
+        results.push_back(r);
+        cout << left << setfill(' ') << setw(20) << r.name << right << setw(12) << dec << r.units << fixed << setprecision(3) << setw(12)
+             << r.medianNs << setw(10) << r.p10Ns << setw(10) << r.p90Ns << setw(12) << 1e3 / r.medianNs << "\n";
+        cout.flush();
+    }
+
+    if (jsonName != NULL)
+        writeJson(jsonName, results, reps);
+    return 0;
+}
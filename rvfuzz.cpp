@@ -0,0 +1,202 @@
+// rvfuzz: an in-process fuzzing harness for guest firmware, with libFuzzer's entry points. The program is
+// loaded once and its initial state kept. For each input:
+// - the input is written to a buffer in the guest;
+// - a0 is set to the buffer and a1 to the input's length;
+// - the program runs from its start until it exits, stops or uses up the instruction budget;
+// - the RAM pages it wrote (dirtyPages in rvsim.cpp) are copied back from the initial state, with the
+//   registers, CSRs and timer.
+// The edges of the guest's branches and jumps (edgeCounters) are libFuzzer's extra counters. An illegal
+// instruction or an access fault with no trap handler to take it is a crash.
+//
+//   clang++ -O2 -fsanitize=fuzzer -o rvfuzz rvfuzz.cpp
+//   RVFUZZ_TEXT=fw.bin RVFUZZ_BUFFER=0x12000 RVFUZZ_SIZE=256 ./rvfuzz -max_len=256 corpus/
+// Without libFuzzer (g++ -O2 -DRVFUZZ_MAIN -o rvfuzz rvfuzz.cpp), it runs the input files given, --runs
+// times each, and prints the executions per second and the edges seen.
+//
+// libFuzzer owns the command line, so the settings come from the environment:
+//   RVFUZZ_TEXT, RVFUZZ_DATA   the program, as rvsim.exe takes it (RVFUZZ_DATA is optional)
+//   RVFUZZ_ELF                 its symbols, to give RVFUZZ_BUFFER by name
+//   RVFUZZ_BUFFER              the address or the symbol of the buffer (default 0x12000)
+//   RVFUZZ_SIZE                the buffer's size; longer inputs are cut to it (default 4096)
+//   RVFUZZ_BUDGET              instructions per input (default 1000000)
+#define RVSIM_NO_MAIN
+#include "rvsim.cpp"
+
+__attribute__((section("__libfuzzer_extra_counters"))) unsigned char rvfuzzEdges[EDGE_COUNTERS];
+
+struct FuzzEnd
+{
+    bool fault;
+    unsigned int cause, value;
+};
+
+vector<unsigned char> fuzzRam; // RAM after the program is loaded
+ReverseCheckpoint fuzzState;   // the rest of the machine then
+unsigned char fuzzDirty[MEMORY_SIZE >> WATCH_PAGE_SHIFT];
+unsigned int fuzzBuffer = 0x00012000;
+unsigned int fuzzSize = 4096;
+unsigned long long fuzzBudget = 1000000;
+stringbuf fuzzMessages;
+
+void fuzzEnd(int)
+{
+    throw FuzzEnd{false, 0, 0};
+}
+
+// exit ends the run without unwinding through the interpreter, which costs more than a short run
+bool fuzzEcall()
+{
+    if (reg[17] != 10 && reg[17] != 93 && reg[17] != 94)
+        return false;
+    runStopRequested = true;
+    return true;
+}
+
+void fuzzFault(unsigned int cause, unsigned int value)
+{
+    throw FuzzEnd{true, cause, value};
+}
+
+unsigned int fuzzAddress(const char *text)
+{
+    for (map<unsigned int, Symbol>::iterator it = symbols.begin(); it != symbols.end(); it++)
+        if (it->second.name == text)
+            return it->first;
+    char *end;
+    unsigned int addr = strtoul(text, &end, 0);
+    if (*end != 0)
+        emitError("RVFUZZ_BUFFER is neither an address nor a symbol of RVFUZZ_ELF\n");
+    return addr;
+}
+
+vector<unsigned char> fuzzReadFile(const char *path)
+{
+    ifstream file(path, ios::in | ios::binary);
+    if (!file.is_open())
+        emitError((string("Cannot open ") + path + "\n").c_str());
+    return vector<unsigned char>(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+// the settings of rvsim.exe --quiet, the program and its initial state, once
+extern "C" int LLVMFuzzerInitialize(int *, char ***)
+{
+    const char *text = getenv("RVFUZZ_TEXT");
+    if (text == NULL)
+        emitError("RVFUZZ_TEXT must name the program to fuzz\n");
+    if (getenv("RVFUZZ_ELF") != NULL)
+        loadSymbols(getenv("RVFUZZ_ELF"));
+    if (getenv("RVFUZZ_BUFFER") != NULL)
+        fuzzBuffer = fuzzAddress(getenv("RVFUZZ_BUFFER"));
+    if (getenv("RVFUZZ_SIZE") != NULL)
+        fuzzSize = strtoul(getenv("RVFUZZ_SIZE"), NULL, 0);
+    if (getenv("RVFUZZ_BUDGET") != NULL)
+        fuzzBudget = strtoull(getenv("RVFUZZ_BUDGET"), NULL, 0);
+    if (fuzzSize == 0 || !ramRange(fuzzBuffer, fuzzSize))
+        emitError("The RVFUZZ_BUFFER and RVFUZZ_SIZE range is not in RAM\n");
+
+    // the guest's output is dropped and its reads of stdin see an empty file
+    quietMode = true;
+    asyncIo = false;
+    endHook = fuzzEnd;
+    ecallHook = fuzzEcall;
+    faultHook = fuzzFault;
+    int null = open("/dev/null", O_RDWR);
+    guestFds.push_back(null);
+    guestFds.push_back(1);
+    guestFds.push_back(null);
+    guestOut.rdbuf(NULL);
+    cout.rdbuf(&fuzzMessages);
+    cout.setstate(ios::badbit);
+    vecSelectKernel();
+
+    vector<unsigned char> textImage = fuzzReadFile(text);
+    vector<unsigned char> data;
+    if (getenv("RVFUZZ_DATA") != NULL)
+        data = fuzzReadFile(getenv("RVFUZZ_DATA"));
+    loadProgram(textImage, data);
+    predecodeInit(textImage.size());
+    fuzzRam.assign(memory, memory + MEMORY_SIZE);
+    captureState(fuzzState, false);
+    edgeCounters = rvfuzzEdges;
+    dirtyPages = fuzzDirty;
+    return 0;
+}
+
+// the pages written by the last run and the rest of the machine, as they were after loading
+void fuzzReset()
+{
+    for (unsigned int page = 0; page < sizeof(fuzzDirty); page++)
+        if (fuzzDirty[page])
+        {
+            memcpy(memory + (page << WATCH_PAGE_SHIFT), &fuzzRam[page << WATCH_PAGE_SHIFT], 1 << WATCH_PAGE_SHIFT);
+            fuzzDirty[page] = 0;
+        }
+    restoreState(fuzzState);
+    for (unsigned int fd = 3; fd < guestFds.size(); fd++)
+        if (guestFds[fd] >= 0)
+            close(guestFds[fd]);
+    guestFds.resize(3);
+    idleDistance = IDLE_MIN_PERIOD;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    size = min(size, (size_t)fuzzSize);
+    memDirty(fuzzBuffer, size);
+    memcpy(memory + fuzzBuffer, data, size);
+    reg[10] = fuzzBuffer;
+    reg[11] = size;
+
+    try
+    {
+        runUntil(fuzzBudget);
+    }
+    catch (const FuzzEnd &end)
+    {
+        if (end.fault)
+        {
+            cerr << "rvfuzz: " << (end.cause == 2 ? "illegal instruction 0x" : "access fault at address 0x") << hex
+                 << end.value << " (pc = 0x" << currentPC << ") after " << dec << instCount << " instructions\n";
+            abort(); // libFuzzer saves the input
+        }
+    }
+    runStopRequested = false;
+    fuzzMessages.str("");
+    cout.clear();
+    cout.setstate(ios::badbit);
+    fuzzReset();
+    return 0;
+}
+
+#ifdef RVFUZZ_MAIN
+// rvfuzz [--runs <N>] <input files>: libFuzzer's way of running inputs, without libFuzzer
+int main(int argc, char *argv[])
+{
+    unsigned long long runs = 1;
+    vector<vector<unsigned char>> inputs;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc)
+            runs = strtoull(argv[++i], NULL, 0);
+        else
+            inputs.push_back(fuzzReadFile(argv[i]));
+    }
+    if (inputs.empty())
+        emitError("use: rvfuzz [--runs <N>] <input files> (the program is in RVFUZZ_TEXT)\n");
+    LLVMFuzzerInitialize(&argc, &argv);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (unsigned long long n = 0; n < runs; n++)
+        for (unsigned int i = 0; i < inputs.size(); i++)
+            LLVMFuzzerTestOneInput(inputs[i].data(), inputs[i].size());
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    unsigned int edges = 0;
+    for (unsigned int i = 0; i < EDGE_COUNTERS; i++)
+        edges += rvfuzzEdges[i] != 0;
+    cerr << "rvfuzz: " << runs * inputs.size() << " executions in " << fixed << setprecision(3) << seconds << " s, "
+         << setprecision(0) << runs * inputs.size() / max(seconds, 1e-9) << " per second, " << edges << " edges\n";
+    return 0;
+}
+#endif
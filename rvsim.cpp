@@ -6,49 +6,5070 @@
 #include <cstdint>
 #include <bitset>
 #include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RVSIM_X86_SIMD
+#include <immintrin.h>
+#endif
 using namespace std;
 
+const unsigned int MEMORY_SIZE = (16 + 64) * 1024;
+
 unsigned int pc = 0;
-unsigned char memory[(16 + 64) * 1024] = {0};
+unsigned char mainMemory[MEMORY_SIZE] = {0};
+unsigned char *memory = mainMemory; // librvsim.cpp points it at the memory of the machine that runs
 unsigned int reg[32] = {0};
+const unsigned int MAX_VLEN = 1024;
+unsigned int vlen = 128;                     // bits per vector register, set with --vlen
+unsigned char vreg[32 * MAX_VLEN / 8] = {0}; // v0..v31, register n starts at byte n * vlen / 8
+unsigned int vl = 0;
+unsigned int vtype = 0x80000000; // vill until the first vsetvli
+unsigned int vstart = 0;
 string name[32] = {"zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"};
 vector<unsigned int> symbol_table;
-int instCount = 0;
+unsigned long long instCount = 0;
+bool mExtension = true; // RV32M, disabled with --no-m
+bool zbExtension = true; // Zba/Zbb, disabled with --no-zb
 bool isSWSP = false;
 bool isAddi4spn = false;
 bool isAddI16SP = false;
 bool isNop = false;
 string filename;
 
-void emitError(const char *s)
+void emitError(const char *s)
+{
+    cout.clear(); // also shown with --quiet
+    cout << s;
+    exit(0);
+}
+
+void printPrefix(unsigned int instA, unsigned int instW)
+{
+    cout << "0x" << hex << std::setfill('0') << std::setw(8) << instA << "\t0x" << std::setw(8) << instW;
+}
+
+void printRegisterValues()
+{
+    cout << "\n\nRegister Values:\n";
+    for (int i = 0; i < 32; i++)
+        cout << name[i] << " = 0x" << hex << reg[i] << endl;
+
+    cout << "pc = 0x" << hex << pc << endl;
+}
+
+void printMemoryValues()
+{
+    cout << "\n\n\n";
+    for (unsigned int i = 0; i < MEMORY_SIZE; i++)
+    {
+        if (memory[i] != 0)
+            cout << "memory[" << i << "] = " << hex << (int)memory[i] << endl;
+    }
+    cout << "\n\n\n";
+}
+
+// ELF symbols (optional, loaded with --elf) used to name functions in reports
+struct Symbol
+{
+    string name;
+    unsigned int size;
+    bool isFunction;
+};
+map<unsigned int, Symbol> symbols;
+string symbolsFile; // the ELF file of --elf
+
+unsigned int readLE(const vector<unsigned char> &buf, unsigned int off, int bytes)
+{
+    unsigned int value = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+        value = (value << 8) | buf[off + i];
+    return value;
+}
+
+// Section headers and strings of a 32-bit ELF image of at least 52 bytes, checked against the file size so that
+// a damaged or truncated file loses what is not in it rather than being read past its end.
+
+// the offset of section header index, or 0 when it is not inside the file
+unsigned int elfSectionHeader(const vector<unsigned char> &elf, unsigned int index)
+{
+    unsigned int shoff = readLE(elf, 0x20, 4);
+    unsigned int shentsize = readLE(elf, 0x2E, 2);
+    unsigned int shnum = readLE(elf, 0x30, 2);
+    unsigned long long sh = shoff + (unsigned long long)index * shentsize;
+    return (index < shnum && sh + 40 <= elf.size()) ? sh : 0;
+}
+
+// [offset, offset + size) is inside the file
+bool elfRange(const vector<unsigned char> &elf, unsigned int offset, unsigned int size)
+{
+    return offset <= elf.size() && size <= elf.size() - offset;
+}
+
+// the string at off in the string table [table, table + size), or NULL unless it ends inside the table
+const char *elfString(const vector<unsigned char> &elf, unsigned int table, unsigned int size, unsigned long long off)
+{
+    if (!elfRange(elf, table, size) || off >= size || memchr(&elf[table + off], 0, size - off) == NULL)
+        return NULL;
+    return (const char *)&elf[table + off];
+}
+
+void loadSymbols(const char *elfName)
+{
+    symbolsFile = elfName;
+    ifstream elfFile(elfName, ios::in | ios::binary);
+    if (!elfFile.is_open())
+        emitError("Cannot open ELF file\n");
+
+    vector<unsigned char> elf((istreambuf_iterator<char>(elfFile)), istreambuf_iterator<char>());
+
+    // only 32-bit little-endian images are expected here
+    if (elf.size() < 52 || elf[0] != 0x7F || elf[1] != 'E' || elf[2] != 'L' || elf[3] != 'F' || elf[4] != 1 || elf[5] != 1)
+        emitError("Not a 32-bit little-endian ELF file\n");
+
+    unsigned int shnum = readLE(elf, 0x30, 2);
+    for (unsigned int i = 0; i < shnum; i++)
+    {
+        unsigned int sh = elfSectionHeader(elf, i);
+        if (sh == 0 || readLE(elf, sh + 4, 4) != 2) // SHT_SYMTAB
+            continue;
+
+        unsigned int symOff = readLE(elf, sh + 16, 4);
+        unsigned int symSize = readLE(elf, sh + 20, 4);
+        unsigned int strSh = elfSectionHeader(elf, readLE(elf, sh + 24, 4));
+        if (strSh == 0 || !elfRange(elf, symOff, symSize))
+            continue;
+        unsigned int strOff = readLE(elf, strSh + 16, 4);
+        unsigned int strSize = readLE(elf, strSh + 20, 4);
+
+        for (unsigned int s = symOff; s + 16 <= symOff + symSize; s += 16)
+        {
+            unsigned int nameOff = readLE(elf, s, 4);
+            unsigned int value = readLE(elf, s + 4, 4);
+            unsigned int size = readLE(elf, s + 8, 4);
+            unsigned int type = elf[s + 12] & 0xF;
+            unsigned int bind = elf[s + 12] >> 4;
+            unsigned int shndx = readLE(elf, s + 14, 2);
+
+            if (shndx == 0 || (type != 0 && type != 1 && type != 2)) // skip undefined, section and file symbols
+                continue;
+
+            const char *nameText = elfString(elf, strOff, strSize, nameOff);
+            if (nameText == NULL)
+                continue;
+            string symName = nameText;
+            if (symName.empty() || symName[0] == '$') // mapping symbols such as $xrv32i2p1
+                continue;
+
+            // functions and global labels (e.g. _start) win over local labels at the same address
+            bool isFunction = (type == 2) || (type == 0 && bind == 1);
+            if (symbols.count(value) && symbols[value].isFunction && !isFunction)
+                continue;
+            symbols[value] = {symName, size, isFunction};
+        }
+    }
+}
+
+string symbolName(unsigned int addr)
+{
+    map<unsigned int, Symbol>::iterator it = symbols.find(addr);
+    if (it != symbols.end())
+        return it->second.name;
+
+    stringstream ss;
+    ss << "0x" << hex << setfill('0') << setw(8) << addr;
+    return ss.str();
+}
+
+// the symbol addr is in, as name+0xoffset, or "" when none is known
+string symbolAt(unsigned int addr)
+{
+    map<unsigned int, Symbol>::iterator it = symbols.upper_bound(addr);
+    if (it == symbols.begin())
+        return "";
+    --it;
+    if (it->second.size != 0 && addr >= it->first + it->second.size)
+        return "";
+
+    stringstream ss;
+    ss << it->second.name;
+    if (addr != it->first)
+        ss << "+0x" << hex << addr - it->first;
+    return ss.str();
+}
+
+bool isFunctionEntry(unsigned int addr)
+{
+    map<unsigned int, Symbol>::iterator it = symbols.find(addr);
+    return it != symbols.end() && it->second.isFunction;
+}
+
+// Call-graph profiler: a shadow call stack built from JAL/JALR link writes
+struct CallNode
+{
+    unsigned int func;
+    CallNode *parent;
+    map<unsigned int, CallNode *> children;
+    unsigned long long self;
+};
+
+struct CallFrame
+{
+    CallNode *node;
+    unsigned int returnAddr;
+};
+
+const unsigned int MAX_CALL_DEPTH = 4096;
+
+bool profileEnabled = false;
+string profileFile = "rvsim.folded";
+unsigned int profileSampleRate = 1;
+unsigned int profileCountdown = 1;
+CallNode profileRoot = {0, NULL, map<unsigned int, CallNode *>(), 0};
+CallNode *profileNode = &profileRoot;
+vector<CallFrame> callStack;
+
+CallNode *profileChild(CallNode *node, unsigned int func)
+{
+    CallNode *&child = node->children[func];
+    if (child == NULL)
+        child = new CallNode{func, node, map<unsigned int, CallNode *>(), 0};
+    return child;
+}
+
+void profileTick()
+{
+    // with sampling, every Nth instruction is charged N to the current call path
+    if (--profileCountdown == 0)
+    {
+        profileNode->self += profileSampleRate;
+        profileCountdown = profileSampleRate;
+    }
+}
+
+// the same as n calls to profileTick
+void profileSkip(unsigned long long n)
+{
+    if (n < profileCountdown)
+    {
+        profileCountdown -= n;
+        return;
+    }
+    n -= profileCountdown;
+    profileNode->self += profileSampleRate * (1 + n / profileSampleRate);
+    profileCountdown = profileSampleRate - n % profileSampleRate;
+}
+
+void profileJump(unsigned int target, unsigned int rd, unsigned int rs1, unsigned int returnAddr)
+{
+    if (rd == 1 || rd == 5)
+    {
+        // call: link register written
+        if (callStack.size() < MAX_CALL_DEPTH)
+        {
+            callStack.push_back({profileNode, returnAddr});
+            profileNode = profileChild(profileNode, target);
+        }
+    }
+    else if (rd == 0 && (rs1 == 1 || rs1 == 5))
+    {
+        // return: unwind to the frame expecting this address; anything else is an indirect jump
+        for (int i = (int)callStack.size() - 1; i >= 0; i--)
+        {
+            if (callStack[i].returnAddr == target)
+            {
+                profileNode = callStack[i].node;
+                callStack.resize(i);
+                break;
+            }
+        }
+    }
+    else if (rd == 0 && profileNode->parent != NULL && target != profileNode->func && isFunctionEntry(target))
+    {
+        // tail call: the callee replaces the current frame and returns to our caller
+        profileNode = profileChild(profileNode->parent, target);
+    }
+}
+
+unsigned long long profileTotal(CallNode *node)
+{
+    unsigned long long total = node->self;
+    for (map<unsigned int, CallNode *>::iterator it = node->children.begin(); it != node->children.end(); it++)
+        total += profileTotal(it->second);
+    return total;
+}
+
+void profileDump(CallNode *node, string path, ofstream &folded)
+{
+    path = path.empty() ? symbolName(node->func) : path + ";" + symbolName(node->func);
+    unsigned long long inclusive = profileTotal(node);
+
+    if (node->self != 0)
+        folded << path << " " << dec << node->self << "\n";
+    if (inclusive != 0)
+        cout << std::setfill(' ') << std::setw(12) << dec << inclusive << std::setw(12) << node->self << "  " << path << "\n";
+
+    for (map<unsigned int, CallNode *>::iterator it = node->children.begin(); it != node->children.end(); it++)
+        profileDump(it->second, path, folded);
+}
+
+void writeProfile()
+{
+    ofstream folded(profileFile.c_str());
+    if (!folded.is_open())
+        emitError("Cannot write profile file\n");
+
+    cout << "\n\nCall-graph profile (" << dec << instCount << " instructions";
+    if (profileSampleRate > 1)
+        cout << ", sampled every " << profileSampleRate;
+    cout << ", folded stacks in " << profileFile << "):\n";
+    cout << "   inclusive   exclusive  call path\n";
+    profileDump(&profileRoot, "", folded);
+}
+
+// Dynamic instruction mix: executions are counted per halfword PC and classified at exit
+bool statsEnabled = false;
+string statsFile;
+vector<unsigned long long> pcCount;
+
+// Zba/Zbb instructions, NULL for anything else
+const char *bitmanipMnemonic(unsigned int w)
+{
+    unsigned int opcode = w & 0x7F;
+    unsigned int funct3 = (w >> 12) & 0x7;
+    unsigned int funct7 = w >> 25;
+    unsigned int rs2 = (w >> 20) & 0x1F;
+    unsigned int imm = w >> 20;
+
+    if (opcode == 0x33)
+    {
+        switch ((funct7 << 3) | funct3)
+        {
+        case (0x10 << 3) | 0x2: return "SH1ADD";
+        case (0x10 << 3) | 0x4: return "SH2ADD";
+        case (0x10 << 3) | 0x6: return "SH3ADD";
+        case (0x20 << 3) | 0x7: return "ANDN";
+        case (0x20 << 3) | 0x6: return "ORN";
+        case (0x20 << 3) | 0x4: return "XNOR";
+        case (0x05 << 3) | 0x4: return "MIN";
+        case (0x05 << 3) | 0x5: return "MINU";
+        case (0x05 << 3) | 0x6: return "MAX";
+        case (0x05 << 3) | 0x7: return "MAXU";
+        case (0x30 << 3) | 0x1: return "ROL";
+        case (0x30 << 3) | 0x5: return "ROR";
+        case (0x04 << 3) | 0x4: return (rs2 == 0) ? "ZEXT.H" : NULL;
+        }
+    }
+    else if (opcode == 0x13 && funct3 == 0x1)
+    {
+        switch (imm)
+        {
+        case 0x600: return "CLZ";
+        case 0x601: return "CTZ";
+        case 0x602: return "CPOP";
+        case 0x604: return "SEXT.B";
+        case 0x605: return "SEXT.H";
+        }
+    }
+    else if (opcode == 0x13 && funct3 == 0x5)
+    {
+        if (funct7 == 0x30)
+            return "RORI";
+        if (imm == 0x287)
+            return "ORC.B";
+        if (imm == 0x698)
+            return "REV8";
+    }
+    return NULL;
+}
+
+// the encodings bitmanipMnemonic names, told by their fields alone: the interpreter tests this for every
+// instruction that is not an M one, and only the trace needs the name
+inline bool bitmanipEncoding(unsigned int w)
+{
+    unsigned int opcode = w & 0x7F;
+    unsigned int funct3 = (w >> 12) & 0x7;
+    unsigned int imm = w >> 20;
+
+    if (opcode == 0x33)
+    {
+        switch (w >> 25)
+        {
+        case 0x10: return funct3 == 0x2 || funct3 == 0x4 || funct3 == 0x6; // SH1ADD, SH2ADD, SH3ADD
+        case 0x20: return funct3 == 0x4 || funct3 == 0x6 || funct3 == 0x7; // XNOR, ORN, ANDN
+        case 0x05: return funct3 >= 0x4;                                   // MIN, MINU, MAX, MAXU
+        case 0x30: return funct3 == 0x1 || funct3 == 0x5;                  // ROL, ROR
+        case 0x04: return funct3 == 0x4 && (imm & 0x1F) == 0;              // ZEXT.H
+        }
+        return false;
+    }
+    if (opcode == 0x13 && funct3 == 0x1)
+        return imm == 0x600 || imm == 0x601 || imm == 0x602 || imm == 0x604 || imm == 0x605;
+    if (opcode == 0x13 && funct3 == 0x5)
+        return (w >> 25) == 0x30 || imm == 0x287 || imm == 0x698;
+    return false;
+}
+
+// length of the usual RV32I sequence a Zba/Zbb instruction stands for
+unsigned int bitmanipBaseLength(const char *m)
+{
+    static const char *names[] = {"SH1ADD", "SH2ADD", "SH3ADD", "ANDN", "ORN", "XNOR", "MIN", "MINU", "MAX", "MAXU",
+                                  "ROL", "ROR", "RORI", "ZEXT.H", "SEXT.B", "SEXT.H", "CLZ", "CTZ", "CPOP", "ORC.B", "REV8"};
+    // slli+add, not+op, slt+branch+mv, sll/srl/sub/or, slli+srli, binary-search clz/ctz, SWAR popcount, byte loops
+    static const unsigned int lengths[] = {2, 2, 2, 2, 2, 2, 3, 3, 3, 3,
+                                           4, 4, 3, 2, 2, 2, 15, 15, 15, 12, 11};
+
+    for (unsigned int i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        if (strcmp(names[i], m) == 0)
+            return lengths[i];
+    return 1;
+}
+
+// RVV subset mnemonics (with the .VV/.VX/.VI form), empty for encodings the vector unit does not implement
+string vectorMnemonic(unsigned int w)
+{
+    static const char *reductions[8] = {"VREDSUM", "VREDAND", "VREDOR", "VREDXOR", "VREDMINU", "VREDMIN", "VREDMAXU", "VREDMAX"};
+    static const char *maskLogical[8] = {"VMANDN", "VMAND", "VMOR", "VMXOR", "VMORN", "VMNAND", "VMNOR", "VMXNOR"};
+    static const char *compares[8] = {"VMSEQ", "VMSNE", "VMSLTU", "VMSLT", "VMSLEU", "VMSLE", "VMSGTU", "VMSGT"};
+    static const char *forms[5] = {".VV", "", "", ".VI", ".VX"};
+
+    unsigned int opcode = w & 0x7F;
+    unsigned int funct3 = (w >> 12) & 0x7;
+    unsigned int vs1 = (w >> 15) & 0x1F;
+    unsigned int vs2 = (w >> 20) & 0x1F;
+    unsigned int vm = (w >> 25) & 0x1;
+    unsigned int funct6 = w >> 26;
+
+    if (opcode == 0x07 || opcode == 0x27)
+    {
+        string eew = (funct3 == 0x0) ? "8" : (funct3 == 0x5) ? "16" : (funct3 == 0x6) ? "32" : "";
+        string op = (opcode == 0x07) ? "VL" : "VS";
+        unsigned int mop = (w >> 26) & 0x3;
+
+        if (eew.empty() || (w >> 28) != 0) // no segments, no 64-bit or extended widths
+            return "";
+        if (mop == 0x0 && vs2 == 0x00)
+            return op + "E" + eew + ".V";
+        if (mop == 0x0 && vs2 == 0x0B && funct3 == 0x0 && vm)
+            return op + "M.V";
+        if (mop == 0x0 && vs2 == 0x10 && opcode == 0x07)
+            return op + "E" + eew + "FF.V";
+        if (mop == 0x2)
+            return op + "SE" + eew + ".V";
+        return "";
+    }
+
+    if (opcode != 0x57)
+        return "";
+
+    switch (funct3)
+    {
+    case 0x7:
+        if ((w >> 31) == 0)
+            return "VSETVLI";
+        if ((w >> 30) == 0x3)
+            return "VSETIVLI";
+        if ((w >> 25) == 0x40)
+            return "VSETVL";
+        return "";
+
+    case 0x0: // OPIVV
+    case 0x3: // OPIVI
+    case 0x4: // OPIVX
+    {
+        string form = forms[funct3];
+        switch (funct6)
+        {
+        case 0x00: return "VADD" + form;
+        case 0x02: return (funct3 != 0x3) ? "VSUB" + form : "";
+        case 0x03: return (funct3 != 0x0) ? "VRSUB" + form : "";
+        case 0x04: return (funct3 != 0x3) ? "VMINU" + form : "";
+        case 0x05: return (funct3 != 0x3) ? "VMIN" + form : "";
+        case 0x06: return (funct3 != 0x3) ? "VMAXU" + form : "";
+        case 0x07: return (funct3 != 0x3) ? "VMAX" + form : "";
+        case 0x09: return "VAND" + form;
+        case 0x0A: return "VOR" + form;
+        case 0x0B: return "VXOR" + form;
+        case 0x17:
+            if (!vm)
+                return "VMERGE" + form + "M";
+            return (vs2 == 0) ? "VMV.V." + form.substr(2) : "";
+        case 0x25: return "VSLL" + form;
+        case 0x28: return "VSRL" + form;
+        case 0x29: return "VSRA" + form;
+        }
+        if (funct6 >= 0x18 && funct6 <= 0x1F)
+        {
+            if ((funct6 == 0x1A || funct6 == 0x1B) && funct3 == 0x3) // no vmslt(u).vi
+                return "";
+            if ((funct6 == 0x1E || funct6 == 0x1F) && funct3 == 0x0) // no vmsgt(u).vv
+                return "";
+            return compares[funct6 - 0x18] + form;
+        }
+        return "";
+    }
+
+    case 0x2: // OPMVV
+        if (funct6 <= 0x07)
+            return string(reductions[funct6]) + ".VS";
+        if (funct6 >= 0x18 && funct6 <= 0x1F)
+            return vm ? string(maskLogical[funct6 - 0x18]) + ".MM" : "";
+        switch (funct6)
+        {
+        case 0x25: return "VMUL.VV";
+        case 0x2D: return "VMACC.VV";
+        case 0x10:
+            if (vs1 == 0x00)
+                return vm ? "VMV.X.S" : "";
+            if (vs1 == 0x10)
+                return "VCPOP.M";
+            if (vs1 == 0x11)
+                return "VFIRST.M";
+            return "";
+        case 0x14:
+            if (vs1 == 0x01)
+                return "VMSBF.M";
+            if (vs1 == 0x02)
+                return "VMSOF.M";
+            if (vs1 == 0x03)
+                return "VMSIF.M";
+            if (vs1 == 0x10)
+                return "VIOTA.M";
+            if (vs1 == 0x11 && vs2 == 0)
+                return "VID.V";
+            return "";
+        }
+        return "";
+
+    case 0x6: // OPMVX
+        if (funct6 == 0x25)
+            return "VMUL.VX";
+        if (funct6 == 0x2D)
+            return "VMACC.VX";
+        if (funct6 == 0x10 && vs2 == 0 && vm)
+            return "VMV.S.X";
+        return "";
+    }
+    return "";
+}
+
+const char *baseMnemonic(unsigned int w)
+{
+    static const char *alu[8] = {"ADD", "SLL", "SLT", "SLTU", "XOR", "SRL", "OR", "AND"};
+    static const char *mul[8] = {"MUL", "MULH", "MULHSU", "MULHU", "DIV", "DIVU", "REM", "REMU"};
+    static const char *alui[8] = {"ADDI", "SLLI", "SLTI", "SLTIU", "XORI", "SRLI", "ORI", "ANDI"};
+    static const char *loads[8] = {"LB", "LH", "LW", NULL, "LBU", "LHU", NULL, NULL};
+    static const char *stores[8] = {"SB", "SH", "SW", NULL, NULL, NULL, NULL, NULL};
+    static const char *branches[8] = {"BEQ", "BNE", NULL, NULL, "BLT", "BGE", "BLTU", "BGEU"};
+    static const char *csrs[8] = {NULL, "CSRRW", "CSRRS", "CSRRC", NULL, "CSRRWI", "CSRRSI", "CSRRCI"};
+
+    unsigned int opcode = w & 0x7F;
+    unsigned int funct3 = (w >> 12) & 0x7;
+    unsigned int funct7 = w >> 25;
+    const char *m = bitmanipMnemonic(w);
+    if (m != NULL)
+        return m;
+    if (opcode == 0x57 || opcode == 0x07 || opcode == 0x27)
+    {
+        static set<string> vectorNames; // keeps the returned pointers valid
+        string v = vectorMnemonic(w);
+        return v.empty() ? "UNKNOWN" : vectorNames.insert(v).first->c_str();
+    }
+
+    switch (opcode)
+    {
+    case 0x33:
+        if (funct7 == 0x00)
+            m = alu[funct3];
+        else if (funct7 == 0x01)
+            m = mul[funct3];
+        else if (funct7 == 0x20 && funct3 == 0x0)
+            m = "SUB";
+        else if (funct7 == 0x20 && funct3 == 0x5)
+            m = "SRA";
+        break;
+    case 0x13:
+        m = (funct3 == 0x5 && funct7 == 0x20) ? "SRAI" : alui[funct3];
+        break;
+    case 0x03:
+        m = loads[funct3];
+        break;
+    case 0x23:
+        m = stores[funct3];
+        break;
+    case 0x63:
+        m = branches[funct3];
+        break;
+    case 0x37:
+        m = "LUI";
+        break;
+    case 0x17:
+        m = "AUIPC";
+        break;
+    case 0x6F:
+        m = "JAL";
+        break;
+    case 0x67:
+        m = "JALR";
+        break;
+    case 0x0F:
+        m = "FENCE";
+        break;
+    case 0x73:
+        if (funct3 != 0x0)
+            m = csrs[funct3];
+        else
+            m = (w == 0x00100073) ? "EBREAK" : (w == 0x00000073) ? "ECALL" : (w == 0x30200073) ? "MRET" : (w == 0x10500073) ? "WFI" : NULL;
+        break;
+    }
+    return m ? m : "UNKNOWN";
+}
+
+// mnemonic of a 16-bit instruction and of the base instruction it expands to
+const char *rvcMnemonic(unsigned int h, const char **base)
+{
+    unsigned int quadrant = h & 0x3;
+    unsigned int funct3 = (h >> 13) & 0x7;
+    unsigned int rd = (h >> 7) & 0x1F;
+    unsigned int rs2 = (h >> 2) & 0x1F;
+    const char *m = "C.UNKNOWN";
+    *base = "UNKNOWN";
+
+    if (quadrant == 0x0)
+    {
+        if (funct3 == 0x0 && h != 0)
+            m = "C.ADDI4SPN", *base = "ADDI";
+        else if (funct3 == 0x2)
+            m = "C.LW", *base = "LW";
+        else if (funct3 == 0x6)
+            m = "C.SW", *base = "SW";
+    }
+    else if (quadrant == 0x1)
+    {
+        switch (funct3)
+        {
+        case 0x0:
+            m = (rd == 0) ? "C.NOP" : "C.ADDI", *base = "ADDI";
+            break;
+        case 0x1:
+            m = "C.JAL", *base = "JAL";
+            break;
+        case 0x2:
+            m = "C.LI", *base = "ADDI";
+            break;
+        case 0x3:
+            if (rd == 2)
+                m = "C.ADDI16SP", *base = "ADDI";
+            else
+                m = "C.LUI", *base = "LUI";
+            break;
+        case 0x4:
+        {
+            static const char *ops[4] = {"C.SUB", "C.XOR", "C.OR", "C.AND"};
+            static const char *opsBase[4] = {"SUB", "XOR", "OR", "AND"};
+            unsigned int funct2 = (h >> 10) & 0x3;
+            if (funct2 == 0x0)
+                m = "C.SRLI", *base = "SRLI";
+            else if (funct2 == 0x1)
+                m = "C.SRAI", *base = "SRAI";
+            else if (funct2 == 0x2)
+                m = "C.ANDI", *base = "ANDI";
+            else if (((h >> 12) & 0x1) == 0)
+                m = ops[(h >> 5) & 0x3], *base = opsBase[(h >> 5) & 0x3];
+            break;
+        }
+        case 0x5:
+            m = "C.J", *base = "JAL";
+            break;
+        case 0x6:
+            m = "C.BEQZ", *base = "BEQ";
+            break;
+        case 0x7:
+            m = "C.BNEZ", *base = "BNE";
+            break;
+        }
+    }
+    else if (quadrant == 0x2)
+    {
+        if (funct3 == 0x0)
+            m = "C.SLLI", *base = "SLLI";
+        else if (funct3 == 0x2)
+            m = "C.LWSP", *base = "LW";
+        else if (funct3 == 0x6)
+            m = "C.SWSP", *base = "SW";
+        else if (funct3 == 0x4 && ((h >> 12) & 0x1) == 0)
+        {
+            if (rs2 == 0)
+                m = "C.JR", *base = "JALR";
+            else
+                m = "C.MV", *base = "ADD";
+        }
+        else if (funct3 == 0x4)
+        {
+            if (rd == 0 && rs2 == 0)
+                m = "C.EBREAK", *base = "EBREAK";
+            else if (rs2 == 0)
+                m = "C.JALR", *base = "JALR";
+            else
+                m = "C.ADD", *base = "ADD";
+        }
+    }
+    return m;
+}
+
+bool isCReg(unsigned int r)
+{
+    return r >= 8 && r <= 15;
+}
+
+// RVC form a 32-bit instruction could have been encoded as, or NULL
+const char *rvcCandidate(unsigned int w)
+{
+    unsigned int opcode = w & 0x7F;
+    unsigned int rd = (w >> 7) & 0x1F;
+    unsigned int funct3 = (w >> 12) & 0x7;
+    unsigned int rs1 = (w >> 15) & 0x1F;
+    unsigned int rs2 = (w >> 20) & 0x1F;
+    unsigned int funct7 = w >> 25;
+    int immI = (int)w >> 20;
+    int immS = (((int)w >> 25) << 5) | ((w >> 7) & 0x1F);
+    int immB = (((int)w >> 31) << 12) | ((w & 0x80) << 4) | ((w >> 20) & 0x7E0) | ((w >> 7) & 0x1E);
+    int immJ = (((int)w >> 31) << 20) | (w & 0xFF000) | ((w >> 9) & 0x800) | ((w >> 20) & 0x7FE);
+
+    switch (opcode)
+    {
+    case 0x13:
+        if (funct3 == 0x0)
+        {
+            if (w == 0x00000013)
+                return "C.NOP";
+            if (rd != 0 && rs1 == 0 && immI >= -32 && immI <= 31)
+                return "C.LI";
+            if (rd == 2 && rs1 == 2 && immI != 0 && immI % 16 == 0 && immI >= -512 && immI <= 496)
+                return "C.ADDI16SP";
+            if (isCReg(rd) && rs1 == 2 && immI > 0 && immI % 4 == 0 && immI <= 1020)
+                return "C.ADDI4SPN";
+            if (rd != 0 && rd == rs1 && immI != 0 && immI >= -32 && immI <= 31)
+                return "C.ADDI";
+            if (rd != 0 && rs1 != 0 && immI == 0)
+                return "C.MV";
+        }
+        else if (funct3 == 0x1 && funct7 == 0x00 && rd != 0 && rd == rs1)
+            return "C.SLLI";
+        else if (funct3 == 0x5 && rd == rs1 && isCReg(rd) && funct7 == 0x00)
+            return "C.SRLI";
+        else if (funct3 == 0x5 && rd == rs1 && isCReg(rd) && funct7 == 0x20)
+            return "C.SRAI";
+        else if (funct3 == 0x7 && rd == rs1 && isCReg(rd) && immI >= -32 && immI <= 31)
+            return "C.ANDI";
+        break;
+    case 0x33:
+        if (funct7 == 0x00 && funct3 == 0x0 && rd != 0 && rs2 != 0 && rs1 == 0)
+            return "C.MV";
+        if (funct7 == 0x00 && funct3 == 0x0 && rd != 0 && ((rd == rs1 && rs2 != 0) || (rd == rs2 && rs1 != 0)))
+            return "C.ADD";
+        if (funct7 == 0x20 && funct3 == 0x0 && isCReg(rd) && rd == rs1 && isCReg(rs2))
+            return "C.SUB";
+        if (funct7 == 0x00 && isCReg(rd) && ((rd == rs1 && isCReg(rs2)) || (rd == rs2 && isCReg(rs1))))
+        {
+            if (funct3 == 0x4)
+                return "C.XOR";
+            if (funct3 == 0x6)
+                return "C.OR";
+            if (funct3 == 0x7)
+                return "C.AND";
+        }
+        break;
+    case 0x03:
+        if (funct3 == 0x2 && rs1 == 2 && rd != 0 && immI >= 0 && immI <= 252 && immI % 4 == 0)
+            return "C.LWSP";
+        if (funct3 == 0x2 && isCReg(rd) && isCReg(rs1) && immI >= 0 && immI <= 124 && immI % 4 == 0)
+            return "C.LW";
+        break;
+    case 0x23:
+        if (funct3 == 0x2 && rs1 == 2 && immS >= 0 && immS <= 252 && immS % 4 == 0)
+            return "C.SWSP";
+        if (funct3 == 0x2 && isCReg(rs1) && isCReg(rs2) && immS >= 0 && immS <= 124 && immS % 4 == 0)
+            return "C.SW";
+        break;
+    case 0x63:
+        if ((funct3 == 0x0 || funct3 == 0x1) && immB >= -256 && immB <= 254 &&
+            ((rs2 == 0 && isCReg(rs1)) || (rs1 == 0 && isCReg(rs2))))
+            return funct3 == 0x0 ? "C.BEQZ" : "C.BNEZ";
+        break;
+    case 0x37:
+        if (rd != 0 && rd != 2 && ((int)w >> 12) != 0 && ((int)w >> 12) >= -32 && ((int)w >> 12) <= 31)
+            return "C.LUI";
+        break;
+    case 0x6F:
+        if (immJ >= -2048 && immJ <= 2046 && rd == 0)
+            return "C.J";
+        if (immJ >= -2048 && immJ <= 2046 && rd == 1)
+            return "C.JAL";
+        break;
+    case 0x67:
+        if (funct3 == 0x0 && immI == 0 && rs1 != 0 && rd == 0)
+            return "C.JR";
+        if (funct3 == 0x0 && immI == 0 && rs1 != 0 && rd == 1)
+            return "C.JALR";
+        break;
+    case 0x73:
+        if (w == 0x00100073)
+            return "C.EBREAK";
+        break;
+    }
+    return NULL;
+}
+
+bool compareCounts(const pair<string, unsigned long long> &a, const pair<string, unsigned long long> &b)
+{
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+}
+
+void writeStats()
+{
+    map<string, unsigned long long> counts;
+    vector<pair<unsigned long long, unsigned int> > hot; // (executions, pc) of compressible 32-bit instructions
+    unsigned long long total = 0, compressed = 0, fetched = 0, candidateBytes = 0;
+    unsigned long long bitmanip = 0, bitmanipReplaced = 0;
+
+    for (unsigned int i = 0; i < pcCount.size(); i++)
+    {
+        unsigned long long n = pcCount[i];
+        if (n == 0)
+            continue;
+
+        unsigned int addr = i << 1;
+        unsigned int half = memory[addr] | (memory[addr + 1] << 8);
+        total += n;
+
+        if ((half & 0x3) != 0x3)
+        {
+            const char *base;
+            counts[string("mnemonic.") + rvcMnemonic(half, &base)] += n;
+            counts[string("base.") + base] += n;
+            compressed += n;
+            fetched += 2 * n;
+        }
+        else
+        {
+            unsigned int word = half | (memory[addr + 2] << 16) | (memory[addr + 3] << 24);
+            counts[string("mnemonic.") + baseMnemonic(word)] += n;
+            counts[string("base.") + baseMnemonic(word)] += n;
+            fetched += 4 * n;
+            if (bitmanipMnemonic(word) != NULL)
+            {
+                bitmanip += n;
+                bitmanipReplaced += n * bitmanipBaseLength(bitmanipMnemonic(word));
+            }
+            if (rvcCandidate(word) != NULL)
+            {
+                hot.push_back(make_pair(n, addr));
+                candidateBytes += 2 * n;
+            }
+        }
+    }
+
+    vector<pair<string, unsigned long long> > mix;
+    for (map<string, unsigned long long>::iterator it = counts.begin(); it != counts.end(); it++)
+        if (it->first.compare(0, 9, "mnemonic.") == 0)
+            mix.push_back(make_pair(it->first.substr(9), it->second));
+    sort(mix.begin(), mix.end(), compareCounts);
+    sort(hot.rbegin(), hot.rend());
+
+    cout << "\n\nDynamic instruction mix (" << dec << total << " instructions):\n";
+    for (unsigned int i = 0; i < mix.size(); i++)
+        cout << "  " << left << setfill(' ') << setw(12) << mix[i].first << right << setw(12) << mix[i].second
+             << setw(8) << fixed << setprecision(2) << 100.0 * mix[i].second / total << "%\n";
+
+    cout << fixed << setprecision(2) << "\nFetch bandwidth:\n"; // also when the mix above is empty
+    cout << "  compressed instructions        " << setw(12) << compressed << setw(8) << (total > 0 ? 100.0 * compressed / total : 0.0) << "%\n";
+    cout << "  fetched bytes                  " << setw(12) << fetched << "\n";
+    cout << "  uncompressed-equivalent bytes  " << setw(12) << 4 * total << setw(8) << (total > 0 ? 100.0 * (4 * total - fetched) / (4 * total) : 0.0) << "% saved\n";
+    cout << "  still compressible bytes       " << setw(12) << candidateBytes << setw(8) << (fetched > 0 ? 100.0 * candidateBytes / fetched : 0.0) << "% of fetched\n";
+
+    if (!hot.empty())
+    {
+        cout << "\nHot 32-bit instructions encodable as RVC:\n";
+        cout << "  pc          word        mnemonic    rvc form      executions   bytes saved\n";
+        for (unsigned int i = 0; i < hot.size() && i < 20; i++)
+        {
+            unsigned int addr = hot[i].second;
+            unsigned int word = memory[addr] | (memory[addr + 1] << 8) | (memory[addr + 2] << 16) | (memory[addr + 3] << 24);
+            cout << "  0x" << hex << setfill('0') << setw(8) << addr << "  0x" << setw(8) << word << setfill(' ') << dec
+                 << "  " << left << setw(10) << baseMnemonic(word) << "  " << setw(10) << rvcCandidate(word) << right
+                 << setw(14) << hot[i].first << setw(14) << 2 * hot[i].first << "\n";
+        }
+    }
+
+    if (bitmanip > 0)
+    {
+        cout << "\nBit manipulation (Zba/Zbb):\n";
+        cout << "  instructions executed          " << setw(12) << bitmanip << setw(8) << 100.0 * bitmanip / total << "%\n";
+        cout << "  RV32I instructions replaced    " << setw(12) << bitmanipReplaced << "\n";
+        cout << "  instructions saved (estimate)  " << setw(12) << bitmanipReplaced - bitmanip << "\n";
+    }
+    cout.unsetf(ios::fixed);
+
+    if (!statsFile.empty())
+    {
+        ofstream out(statsFile.c_str());
+        if (!out.is_open())
+            emitError("Cannot write stats file\n");
+        out << "program " << filename << "\n";
+        out << "instructions " << total << "\n";
+        out << "compressed " << compressed << "\n";
+        out << "fetched_bytes " << fetched << "\n";
+        out << "equivalent_bytes " << 4 * total << "\n";
+        out << "compressible_bytes " << candidateBytes << "\n";
+        out << "bitmanip " << bitmanip << "\n";
+        out << "bitmanip_replaced " << bitmanipReplaced << "\n";
+        for (map<string, unsigned long long>::iterator it = counts.begin(); it != counts.end(); it++)
+            out << it->first << " " << it->second << "\n";
+    }
+}
+
+map<string, string> readStats(const char *statsName)
+{
+    ifstream in(statsName);
+    if (!in.is_open())
+        emitError("Cannot read stats file\n");
+
+    map<string, string> values;
+    string key, value;
+    while (in >> key >> value)
+        values[key] = value;
+    return values;
+}
+
+// side-by-side view of two --stats-out files, e.g. the rv32i and rv32ic build of one program
+void compareStats(const char *first, const char *second)
+{
+    map<string, string> a = readStats(first);
+    map<string, string> b = readStats(second);
+    const char *summary[] = {"instructions", "compressed", "fetched_bytes", "equivalent_bytes", "compressible_bytes",
+                             "bitmanip", "bitmanip_replaced"};
+
+    cout << left << setfill(' ') << setw(24) << "" << setw(20) << a["program"] << setw(20) << b["program"] << "ratio\n";
+    for (int pass = 0; pass < 3; pass++)
+    {
+        vector<string> keys;
+        if (pass == 0)
+            keys.assign(summary, summary + 7);
+        else
+        {
+            // base.* rows line up C.ADDI with ADDI etc.; mnemonic.* rows keep the encodings apart
+            string prefix = (pass == 1) ? "base." : "mnemonic.";
+            cout << "\n";
+            for (map<string, string>::iterator it = a.begin(); it != a.end(); it++)
+                if (it->first.compare(0, prefix.size(), prefix) == 0)
+                    keys.push_back(it->first);
+            for (map<string, string>::iterator it = b.begin(); it != b.end(); it++)
+                if (it->first.compare(0, prefix.size(), prefix) == 0 && !a.count(it->first))
+                    keys.push_back(it->first);
+            sort(keys.begin(), keys.end());
+        }
+
+        for (unsigned int i = 0; i < keys.size(); i++)
+        {
+            double x = atof(a[keys[i]].c_str());
+            double y = atof(b[keys[i]].c_str());
+            cout << left << setw(24) << keys[i] << setw(20) << (a[keys[i]].empty() ? "0" : a[keys[i]])
+                 << setw(20) << (b[keys[i]].empty() ? "0" : b[keys[i]]);
+            if (x != 0)
+                cout << fixed << setprecision(3) << y / x;
+            cout << "\n";
+        }
+    }
+    cout << right;
+}
+
+void hleReport();
+void idiomReport();
+void lastWriteReport();
+void recordFinish(int status);
+void gdbExit(int status);
+bool cosimFinish();
+void aotReport();
+void decodeCacheFinish();
+void coverageFinish();
+void sanitizerReport();
+
+// --timing: host time and speed of the run, from the first instruction to the end
+bool timingEnabled = false;
+chrono::steady_clock::time_point timingStart;
+
+void timingReport()
+{
+    if (!timingEnabled)
+        return;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - timingStart).count();
+    cout << "\nTiming: " << dec << instCount << " instructions, " << fixed << setprecision(3) << seconds << " s, "
+         << (seconds > 0 ? instCount / seconds / 1e6 : 0.0) << " MIPS\n";
+    cout.unsetf(ios::floatfield);
+}
+
+// librvsim.cpp's hooks: a program that ends returns to the caller of rvsim_run instead of ending the process,
+// and ECALLs and accesses outside RAM and the CLINT can be handled by the host
+void (*endHook)(int status) = NULL; // does not return
+bool (*ecallHook)() = NULL;
+bool (*mmioReadHook)(unsigned int addr, int size, unsigned int &data) = NULL;
+bool (*mmioWriteHook)(unsigned int addr, int size, unsigned int data) = NULL;
+// rvfuzz.cpp's: an illegal instruction or an access fault with no trap handler to take it
+void (*faultHook)(unsigned int cause, unsigned int value) = NULL;
+
+// called on every way out of the simulation loop
+void finishSimulation(int status = 0)
+{
+    cout.clear(); // reports are printed even with --quiet
+    bool diverged = cosimFinish();
+    if (profileEnabled)
+        writeProfile();
+    if (statsEnabled)
+        writeStats();
+    hleReport();
+    idiomReport();
+    sanitizerReport();
+    lastWriteReport();
+    recordFinish(status);
+    timingReport();
+    aotReport();
+    decodeCacheFinish();
+    coverageFinish();
+    cout.flush();
+    gdbExit(status);
+    if (diverged)
+        exit(1);
+}
+
+// the program has ended with status
+[[noreturn]] void endSimulation(int status)
+{
+    finishSimulation(status);
+    if (endHook != NULL)
+        endHook(status);
+    exit(status);
+}
+
+// Guest code coverage (--coverage <file>), in bitmaps over RAM: a bit per halfword where a block started (the
+// pc after a jump, a taken branch, a trap, an MRET, an ECALL or an EBREAK) and two bits per halfword for the directions a branch
+// there went. Straight-line code costs nothing; coverageReport expands the block starts into the instructions
+// that ran.
+bool coverageEnabled = false;
+unsigned char coverBlocks[MEMORY_SIZE / 16];
+unsigned char coverBranches[MEMORY_SIZE / 8];
+
+inline void coverBlock(unsigned int addr)
+{
+    if (addr < MEMORY_SIZE)
+        coverBlocks[addr >> 4] |= 1 << ((addr >> 1) & 7);
+}
+
+// ECALL and EBREAK end a block: the program may end there, so what follows needs a block start of its own
+inline bool coverBlockEnd(unsigned int addr)
+{
+    unsigned int word = memory[addr] | (memory[addr + 1] << 8);
+    if ((word & 3) == 3)
+        word |= (memory[addr + 2] << 16) | (memory[addr + 3] << 24);
+    return word == 0x00000073 || word == 0x00100073 || word == 0x9002;
+}
+
+// bit 0 taken, bit 1 not taken
+inline void coverBranch(unsigned int addr, bool taken)
+{
+    coverBranches[addr >> 3] |= (taken ? 1 : 2) << (((addr >> 1) & 3) * 2);
+}
+
+const unsigned int MSTATUS_MIE = 1 << 3;
+const unsigned int MSTATUS_MPIE = 1 << 7;
+const unsigned int MSTATUS_MPP = 3 << 11;
+const unsigned int MIP_MSIP = 1 << 3;
+const unsigned int MIP_MTIP = 1 << 7;
+const unsigned int MIP_MEIP = 1 << 11;
+
+const unsigned int CLINT_BASE = 0x02000000;
+const unsigned int CLINT_SIZE = 0x10000;
+const unsigned int CLINT_MSIP = 0x0000;
+const unsigned int CLINT_MTIMECMP = 0x4000;
+const unsigned int CLINT_MTIME = 0xBFF8;
+
+unsigned int currentPC = 0; // address of the instruction being executed
+unsigned int mstatus = MSTATUS_MPP;
+unsigned int mie = 0;
+unsigned int mtvec = 0;
+unsigned int mscratch = 0;
+unsigned int mepc = 0;
+unsigned int mcause = 0;
+unsigned int mtval = 0;
+unsigned int msip = 0;
+unsigned long long mtimecmp = ~0ULL;
+unsigned long long mtimeOffset = 0;
+unsigned long long cycleOffset = 0;
+unsigned long long instretOffset = 0;
+unsigned long long nextEventAt = ~0ULL; // instCount at which an enabled interrupt can become pending
+unsigned long long externalReads = 0;   // reads of the time or of host state and guest output, see idleCheck
+bool memFault = false;
+
+bool gdbException(unsigned int cause);
+void gdbWatchTriggered(char type, unsigned int addr);
+
+unsigned long long mtime()
+{
+    return instCount + mtimeOffset;
+}
+
+unsigned int mip()
+{
+    return (msip ? MIP_MSIP : 0) | (mtime() >= mtimecmp ? MIP_MTIP : 0);
+}
+
+// interrupts are only looked at when instCount reaches this, at block boundaries
+void updateNextEvent()
+{
+    nextEventAt = ~0ULL;
+    if (!(mstatus & MSTATUS_MIE))
+        return;
+    if ((mie & MIP_MSIP) && msip)
+        nextEventAt = 0;
+    else if (mie & MIP_MTIP)
+        nextEventAt = (mtime() >= mtimecmp) ? 0 : instCount + (mtimecmp - mtime()); // modulo 2^64: mtime may be set below instCount
+}
+
+void takeTrap(unsigned int cause, unsigned int tval, unsigned int epc)
+{
+    mepc = epc;
+    mcause = cause;
+    mtval = tval;
+    mstatus = (mstatus & ~(MSTATUS_MIE | MSTATUS_MPIE)) | ((mstatus & MSTATUS_MIE) ? MSTATUS_MPIE : 0) | MSTATUS_MPP;
+
+    pc = mtvec & ~0x3;
+    if ((cause & 0x80000000) && (mtvec & 0x1)) // vectored mode
+        pc += 4 * (cause & 0x7FFFFFFF);
+    if (coverageEnabled)
+        coverBlock(pc); // also when an interrupt is taken between blocks
+
+    cout << "\t-> trap: mcause = 0x" << hex << cause << ", mepc = 0x" << epc << ", mtvec = 0x" << mtvec << "\n";
+    updateNextEvent();
+}
+
+// until the guest installs a trap vector, exceptions keep the simulator's old behaviour
+bool trapHandlerInstalled()
+{
+    return mtvec != 0;
+}
+
+// ECALLs the simulator services itself never reach the guest's trap handler
+bool isHostService(unsigned int a7)
+{
+    static const unsigned int services[] = {1, 4, 10, 56, 57, 62, 63, 64, 80, 93, 94, 113, 169, 214};
+    for (unsigned int i = 0; i < sizeof(services) / sizeof(services[0]); i++)
+        if (services[i] == a7)
+            return true;
+    return false;
+}
+
+void illegalInstruction(const char *message, unsigned int instWord, unsigned int instPC)
+{
+    cout << message;
+    if (trapHandlerInstalled())
+        takeTrap(2, instWord, instPC);
+    else if (!gdbException(2) && faultHook != NULL)
+        faultHook(2, instWord);
+}
+
+void accessFault(unsigned int cause, unsigned int addr)
+{
+    memFault = true;
+    if (trapHandlerInstalled())
+    {
+        takeTrap(cause, addr, currentPC);
+        return;
+    }
+
+    if (gdbException(cause))
+        return;
+    if (faultHook != NULL)
+        faultHook(cause, addr);
+    cout.clear();
+    cout << "\nAccess fault at address 0x" << hex << addr << " (pc = 0x" << currentPC << ")\n";
+    endSimulation(1);
+}
+
+void checkInterrupts()
+{
+    unsigned int pending = mip() & mie;
+    if (!(mstatus & MSTATUS_MIE) || pending == 0)
+    {
+        updateNextEvent();
+        return;
+    }
+
+    // pc already holds the next instruction, which is where the handler returns to
+    if (pending & MIP_MEIP)
+        takeTrap(0x80000000 | 11, 0, pc);
+    else if (pending & MIP_MSIP)
+        takeTrap(0x80000000 | 3, 0, pc);
+    else
+        takeTrap(0x80000000 | 7, 0, pc);
+}
+
+const char *csrName(unsigned int csr)
+{
+    switch (csr)
+    {
+    case 0x300: return "mstatus";
+    case 0x301: return "misa";
+    case 0x304: return "mie";
+    case 0x305: return "mtvec";
+    case 0x340: return "mscratch";
+    case 0x341: return "mepc";
+    case 0x342: return "mcause";
+    case 0x343: return "mtval";
+    case 0x344: return "mip";
+    case 0xB00: return "mcycle";
+    case 0xB02: return "minstret";
+    case 0xB80: return "mcycleh";
+    case 0xB82: return "minstreth";
+    case 0xC00: return "cycle";
+    case 0xC01: return "time";
+    case 0xC02: return "instret";
+    case 0xC80: return "cycleh";
+    case 0xC81: return "timeh";
+    case 0xC82: return "instreth";
+    case 0xF11: return "mvendorid";
+    case 0xF12: return "marchid";
+    case 0xF13: return "mimpid";
+    case 0xF14: return "mhartid";
+    case 0x008: return "vstart";
+    case 0xC20: return "vl";
+    case 0xC21: return "vtype";
+    case 0xC22: return "vlenb";
+    }
+    return NULL;
+}
+
+bool csrRead(unsigned int csr, unsigned int &value)
+{
+    // counters read as the count before the current instruction retires
+    unsigned long long cycle = instCount - 1 + cycleOffset;
+    unsigned long long instret = instCount - 1 + instretOffset;
+    unsigned long long time = instCount - 1 + mtimeOffset;
+
+    if (csr == 0x344 || (csr & 0xF7C) == 0xB00 || (csr & 0xF7C) == 0xC00)
+        externalReads++;
+    switch (csr)
+    {
+    case 0x300: value = mstatus; break;
+    case 0x301: value = 0x40000000 | (1 << ('I' - 'A')) | (1 << ('C' - 'A')) | (mExtension ? 1 << ('M' - 'A') : 0); break;
+    case 0x304: value = mie; break;
+    case 0x305: value = mtvec; break;
+    case 0x340: value = mscratch; break;
+    case 0x341: value = mepc; break;
+    case 0x342: value = mcause; break;
+    case 0x343: value = mtval; break;
+    case 0x344: value = mip(); break;
+    case 0xB00: case 0xC00: value = (unsigned int)cycle; break;
+    case 0xB02: case 0xC02: value = (unsigned int)instret; break;
+    case 0xC01: value = (unsigned int)time; break;
+    case 0xB80: case 0xC80: value = (unsigned int)(cycle >> 32); break;
+    case 0xB82: case 0xC82: value = (unsigned int)(instret >> 32); break;
+    case 0xC81: value = (unsigned int)(time >> 32); break;
+    case 0xF11: case 0xF12: case 0xF13: case 0xF14: value = 0; break;
+    case 0x008: value = vstart; break;
+    case 0xC20: value = vl; break;
+    case 0xC21: value = vtype; break;
+    case 0xC22: value = vlen / 8; break;
+    default: return false;
+    }
+    return true;
+}
+
+bool csrWrite(unsigned int csr, unsigned int value)
+{
+    unsigned long long now = instCount; // the write takes effect from the next instruction
+
+    if ((csr >> 10) == 0x3) // read-only range
+        return false;
+
+    switch (csr)
+    {
+    case 0x300: mstatus = (value & (MSTATUS_MIE | MSTATUS_MPIE)) | MSTATUS_MPP; break;
+    case 0x301: break; // misa is not writable here
+    case 0x304: mie = value & (MIP_MSIP | MIP_MTIP | MIP_MEIP); break;
+    case 0x305: mtvec = value & ~0x2; break;
+    case 0x340: mscratch = value; break;
+    case 0x341: mepc = value & ~0x1; break;
+    case 0x342: mcause = value; break;
+    case 0x343: mtval = value; break;
+    case 0x344: break; // MSIP and MTIP are driven by the CLINT
+    case 0x008: vstart = value & (MAX_VLEN - 1); break;
+    case 0xB00: cycleOffset = (((now + cycleOffset) & ~0xFFFFFFFFULL) | value) - now; break;
+    case 0xB02: instretOffset = (((now + instretOffset) & ~0xFFFFFFFFULL) | value) - now; break;
+    case 0xB80: cycleOffset = (((unsigned long long)value << 32) | ((now + cycleOffset) & 0xFFFFFFFF)) - now; break;
+    case 0xB82: instretOffset = (((unsigned long long)value << 32) | ((now + instretOffset) & 0xFFFFFFFF)) - now; break;
+    default: return false;
+    }
+    updateNextEvent();
+    return true;
+}
+
+// CLINT registers are 32 or 64 bits wide; narrower accesses pick bytes out of them
+bool clintRead(unsigned int offset, int size, unsigned int &value)
+{
+    unsigned long long reg64;
+    unsigned int base;
+
+    if (offset < CLINT_MSIP + 4)
+        reg64 = msip, base = CLINT_MSIP;
+    else if (offset >= CLINT_MTIMECMP && offset < CLINT_MTIMECMP + 8)
+        reg64 = mtimecmp, base = CLINT_MTIMECMP;
+    else if (offset >= CLINT_MTIME && offset < CLINT_MTIME + 8)
+        reg64 = mtime(), base = CLINT_MTIME, externalReads++;
+    else
+        return false;
+
+    value = (unsigned int)(reg64 >> (8 * (offset - base)));
+    if (size < 4)
+        value &= (1u << (8 * size)) - 1;
+    return true;
+}
+
+bool clintWrite(unsigned int offset, int size, unsigned int value)
+{
+    unsigned long long *reg64;
+    unsigned long long temp;
+    unsigned int base;
+
+    if (offset < CLINT_MSIP + 4)
+    {
+        if (offset == CLINT_MSIP)
+            msip = value & 0x1;
+        updateNextEvent();
+        return true;
+    }
+    else if (offset >= CLINT_MTIMECMP && offset < CLINT_MTIMECMP + 8)
+        reg64 = &mtimecmp, base = CLINT_MTIMECMP;
+    else if (offset >= CLINT_MTIME && offset < CLINT_MTIME + 8)
+        temp = mtime(), reg64 = &temp, base = CLINT_MTIME;
+    else
+        return false;
+
+    unsigned int shift = 8 * (offset - base);
+    unsigned long long mask = ((size == 4) ? 0xFFFFFFFFULL : (1ULL << (8 * size)) - 1) << shift;
+    *reg64 = (*reg64 & ~mask) | (((unsigned long long)value << shift) & mask);
+
+    if (reg64 == &temp)
+        mtimeOffset = temp - instCount;
+    updateNextEvent();
+    return true;
+}
+
+// Guest data accesses: RAM is little-endian memory[], everything else is memory-mapped I/O
+// Watchpoints, set by gdb or with --watch/--rwatch/--awatch. RAM is divided into 256-byte pages and each page
+// counts the watchpoints that an access starting in it can touch, so loads and stores only look at the list
+// on a watched page and cost one table lookup elsewhere.
+const unsigned int WATCH_PAGE_SHIFT = 8;
+
+struct Watchpoint
+{
+    char type; // '2' write, '3' read, '4' access, as in gdb's Z packets
+    unsigned int addr, length;
+    bool logged; // from the command line: every hit is printed, gdb is not stopped
+};
+
+vector<Watchpoint> watchpoints;
+unsigned short watchedPage[MEMORY_SIZE >> WATCH_PAGE_SHIFT] = {0};
+
+// The pages of RAM written since rvfuzz.cpp last reset them, so that only those are copied back; in the same
+// 256-byte pages as the watchpoints. Every way RAM is written (stores, host calls, HLE, loop idioms) marks them.
+unsigned char *dirtyPages = NULL; // MEMORY_SIZE >> WATCH_PAGE_SHIFT flags while the fuzzer runs
+
+// Memory sanitizer (--sanitize): a shadow byte per byte of RAM with the region it belongs to and whether it has
+// been written. The stack has no region of its own: it is the free memory at and above sp.
+const unsigned char SHADOW_FREE = 0, SHADOW_TEXT = 1, SHADOW_DATA = 2, SHADOW_HEAP = 3, SHADOW_WRITTEN = 0x80;
+unsigned char shadowBytes[MEMORY_SIZE + 3]; // + 3 so that a word can be read at any byte
+unsigned char *shadow = NULL;               // shadowBytes with --sanitize
+unsigned int shadowBssFrom = ~0u;           // without _end in the symbols, the .bss may be any free memory from here to sp
+
+inline void memDirty(unsigned int addr, unsigned int size)
+{
+    if (size == 0)
+        return;
+    if (dirtyPages != NULL)
+        for (unsigned int page = addr >> WATCH_PAGE_SHIFT; page <= (addr + size - 1) >> WATCH_PAGE_SHIFT; page++)
+            dirtyPages[page] = 1;
+    if (shadow != NULL)
+        for (unsigned int i = 0; i < size; i++)
+            shadow[addr + i] |= SHADOW_WRITTEN;
+}
+bool reverseReplaying = false; // going backwards re-executes instructions, which must not be logged again
+
+void watchUpdatePages()
+{
+    memset(watchedPage, 0, sizeof(watchedPage));
+    for (unsigned int i = 0; i < watchpoints.size(); i++)
+    {
+        const Watchpoint &w = watchpoints[i];
+        if (w.addr >= MEMORY_SIZE)
+            continue;
+        // a word access up to 3 bytes before the range overlaps it
+        unsigned int first = (w.addr < 3 ? 0 : w.addr - 3) >> WATCH_PAGE_SHIFT;
+        unsigned int last = min(w.addr + max(w.length, 1u) - 1, MEMORY_SIZE - 1) >> WATCH_PAGE_SHIFT;
+        for (unsigned int p = first; p <= last; p++)
+            watchedPage[p]++;
+    }
+}
+
+bool watchedRange(unsigned int addr, unsigned int size)
+{
+    for (unsigned int p = addr >> WATCH_PAGE_SHIFT; p <= (addr + size - 1) >> WATCH_PAGE_SHIFT; p++)
+        if (watchedPage[p])
+            return true;
+    return false;
+}
+
+// the mnemonic of the instruction being run
+const char *currentMnemonic()
+{
+    const char *base;
+    unsigned int word = memory[currentPC] | (memory[currentPC + 1] << 8);
+    return ((word & 0x3) != 0x3) ? rvcMnemonic(word, &base)
+                                 : baseMnemonic(word | (memory[currentPC + 2] << 16) | (memory[currentPC + 3] << 24));
+}
+
+// a hit of a --watch: the instruction, its pc and the value before and after
+void watchLog(const Watchpoint &w, unsigned int addr, int size, bool write, unsigned int data)
+{
+    unsigned int old = 0;
+    for (int i = size - 1; i >= 0; i--)
+        old = (old << 8) | memory[addr + i];
+    if (size < 4)
+        data &= (1u << (8 * size)) - 1;
+
+    // shown even with --quiet
+    ios::iostate traceState = cout.rdstate();
+    cout.clear();
+    cout << "\t-> watch 0x" << hex << w.addr << ": " << currentMnemonic() << " at pc = 0x" << currentPC;
+    if (write)
+        cout << " wrote 0x" << addr << ", 0x" << old << " -> 0x" << data;
+    else
+        cout << " read 0x" << addr << " = 0x" << old;
+    cout << " (instruction " << dec << instCount << ")\n";
+    cout.clear(traceState);
+}
+
+void watchAccess(unsigned int addr, int size, bool write, unsigned int data)
+{
+    for (unsigned int i = 0; i < watchpoints.size(); i++)
+    {
+        const Watchpoint &w = watchpoints[i];
+        if (addr >= w.addr + max(w.length, 1u) || w.addr >= addr + size)
+            continue;
+        if ((w.type == '2' && !write) || (w.type == '3' && write))
+            continue;
+        if (!w.logged)
+            gdbWatchTriggered(w.type, max(addr, w.addr));
+        else if (!reverseReplaying)
+            watchLog(w, addr, size, write, data);
+    }
+}
+
+// what a system call stored, as the stores of up to 4 bytes an instruction would have made; memory holds the
+// new bytes and old the ones from before the call
+void watchHostStores(unsigned int addr, unsigned int size, const unsigned char *old)
+{
+    for (unsigned int at = 0; at < size; at += 4)
+    {
+        unsigned int n = min(4u, size - at), data = 0;
+        for (int i = n - 1; i >= 0; i--)
+            data = (data << 8) | memory[addr + at + i];
+        memcpy(memory + addr + at, old + at, n);
+        watchAccess(addr + at, n, true, data);
+        for (unsigned int i = 0; i < n; i++)
+            memory[addr + at + i] = data >> (8 * i);
+    }
+}
+
+// The sanitizer's checks take the shadow bytes of an access as one word. An access passes without a closer look
+// when every byte is in text, data or the heap, or is free memory in the stack, and, for a load, has been
+// written. Stores into data or the heap at or above sp go to shadowCheck too: sp may be below the data's end.
+void shadowCheck(unsigned int addr, int size, bool write);
+const unsigned int shadowMask[5] = {0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+// free memory from here up is the stack (or, when _end is not known, the .bss or the stack)
+inline unsigned int shadowStackFloor()
+{
+    return min(reg[2], shadowBssFrom);
+}
+
+inline void shadowLoad(unsigned int addr, int size)
+{
+    unsigned int m = shadowMask[size], s;
+    memcpy(&s, shadow + addr, 4);
+    s &= m;
+    unsigned int kinds = s & 0x03030303, region = (s & 3) * (m & 0x01010101);
+    if ((s & 0x80808080) == (m & 0x80808080) && (addr >= shadowStackFloor() || (kinds == region && region != 0)))
+        return;
+    shadowCheck(addr, size, false);
+}
+
+inline void shadowStore(unsigned int addr, int size)
+{
+    unsigned int m = shadowMask[size], s;
+    memcpy(&s, shadow + addr, 4);
+    s &= m;
+    unsigned int kinds = s & 0x03030303, region = (s & 3) * (m & 0x01010101);
+    if (kinds == SHADOW_FREE ? addr < shadowStackFloor() : kinds != region || (s & 3) == SHADOW_TEXT || addr >= reg[2])
+        shadowCheck(addr, size, true);
+    s |= m & 0x80808080;
+    memcpy(shadow + addr, &s, size);
+}
+
+unsigned int memRead(unsigned int addr, int size)
+{
+    memFault = false;
+    if (addr < MEMORY_SIZE && addr + size <= MEMORY_SIZE)
+    {
+        if (watchedPage[addr >> WATCH_PAGE_SHIFT])
+            watchAccess(addr, size, false, 0);
+        if (shadow != NULL)
+            shadowLoad(addr, size);
+        unsigned int data = memory[addr];
+        for (int i = 1; i < size; i++)
+            data |= memory[addr + i] << (8 * i);
+        return data;
+    }
+
+    unsigned int data = 0;
+    if (addr - CLINT_BASE < CLINT_SIZE && clintRead(addr - CLINT_BASE, size, data))
+        return data;
+    if (mmioReadHook != NULL && mmioReadHook(addr, size, data))
+        return data;
+
+    accessFault(5, addr);
+    return 0;
+}
+
+void memWrite(unsigned int addr, int size, unsigned int data)
+{
+    memFault = false;
+    if (addr < MEMORY_SIZE && addr + size <= MEMORY_SIZE)
+    {
+        if (watchedPage[addr >> WATCH_PAGE_SHIFT])
+            watchAccess(addr, size, true, data);
+        if (dirtyPages != NULL)
+            memDirty(addr, size);
+        if (shadow != NULL)
+            shadowStore(addr, size);
+        for (int i = 0; i < size; i++)
+            memory[addr + i] = (data >> (8 * i)) & 0xFF;
+        return;
+    }
+
+    if (addr - CLINT_BASE < CLINT_SIZE && clintWrite(addr - CLINT_BASE, size, data))
+        return;
+    if (mmioWriteHook != NULL && mmioWriteHook(addr, size, data))
+        return;
+
+    accessFault(7, addr);
+}
+
+// Vector unit (RVV subset: SEW 8/16/32, LMUL 1/8..8). Element-wise integer ops go through vecKernel,
+// which is picked at startup from the AVX2, SSE2 and scalar versions.
+enum VecOp
+{
+    VOP_ADD,
+    VOP_SUB,
+    VOP_AND,
+    VOP_OR,
+    VOP_XOR,
+    VOP_MINU,
+    VOP_MIN,
+    VOP_MAXU,
+    VOP_MAX,
+    VOP_MUL,
+    VOP_SLL,
+    VOP_SRL,
+    VOP_SRA
+};
+
+bool simdEnabled = true; // host SIMD kernels, disabled with --no-simd
+
+unsigned char *vecReg(unsigned int n)
+{
+    return vreg + n * (vlen / 8);
+}
+
+unsigned int vecSew()
+{
+    return 8 << ((vtype >> 3) & 0x7);
+}
+
+int vecLmulLog2()
+{
+    int lmul = vtype & 0x7;
+    return (lmul & 0x4) ? lmul - 8 : lmul;
+}
+
+// 0 for a vtype the vector unit cannot run (vill)
+unsigned int vecVlmax(unsigned int type)
+{
+    unsigned int sew = 8 << ((type >> 3) & 0x7);
+    int lmul = type & 0x7;
+
+    if ((type >> 8) != 0 || sew > 32 || lmul == 4)
+        return 0;
+    if (lmul & 0x4)
+        return (vlen / sew) >> (8 - lmul);
+    return (vlen / sew) << lmul;
+}
+
+string vecTypeName(unsigned int type)
+{
+    stringstream ss;
+    int lmul = type & 0x7;
+    ss << "e" << dec << (8 << ((type >> 3) & 0x7)) << ", ";
+    if (lmul & 0x4)
+        ss << "mf" << (1 << (8 - lmul));
+    else
+        ss << "m" << (1 << lmul);
+    ss << ((type & 0x40) ? ", ta" : ", tu") << ((type & 0x80) ? ", ma" : ", mu");
+    return ss.str();
+}
+
+// a register group of 2^emulLog2 registers must start at a multiple of its size
+bool vecGroupOk(unsigned int n, int emulLog2)
+{
+    if (emulLog2 <= 0)
+        return true;
+    return n % (1u << emulLog2) == 0 && n + (1u << emulLog2) <= 32;
+}
+
+unsigned int vecGet(const unsigned char *p, unsigned int i, unsigned int sew)
+{
+    if (sew == 8)
+        return p[i];
+    if (sew == 16)
+        return p[2 * i] | (p[2 * i + 1] << 8);
+    return p[4 * i] | (p[4 * i + 1] << 8) | (p[4 * i + 2] << 16) | ((unsigned int)p[4 * i + 3] << 24);
+}
+
+void vecSet(unsigned char *p, unsigned int i, unsigned int sew, unsigned int value)
+{
+    for (unsigned int b = 0; b < sew / 8; b++)
+        p[i * (sew / 8) + b] = (value >> (8 * b)) & 0xFF;
+}
+
+int vecSigned(unsigned int x, unsigned int sew)
+{
+    return (int)(x << (32 - sew)) >> (32 - sew);
+}
+
+bool vecMaskBit(const unsigned char *p, unsigned int i)
+{
+    return (p[i >> 3] >> (i & 7)) & 1;
+}
+
+void vecSetMaskBit(unsigned char *p, unsigned int i, bool bit)
+{
+    if (bit)
+        p[i >> 3] |= 1 << (i & 7);
+    else
+        p[i >> 3] &= ~(1 << (i & 7));
+}
+
+unsigned int vecAlu(unsigned int op, unsigned int sew, unsigned int a, unsigned int b)
+{
+    unsigned int mask = (sew == 32) ? 0xFFFFFFFF : (1u << sew) - 1;
+    switch (op)
+    {
+    case VOP_ADD: return (a + b) & mask;
+    case VOP_SUB: return (a - b) & mask;
+    case VOP_AND: return a & b;
+    case VOP_OR: return a | b;
+    case VOP_XOR: return a ^ b;
+    case VOP_MINU: return (a < b) ? a : b;
+    case VOP_MIN: return (vecSigned(a, sew) < vecSigned(b, sew)) ? a : b;
+    case VOP_MAXU: return (a > b) ? a : b;
+    case VOP_MAX: return (vecSigned(a, sew) > vecSigned(b, sew)) ? a : b;
+    case VOP_MUL: return (a * b) & mask;
+    case VOP_SLL: return (a << (b & (sew - 1))) & mask;
+    case VOP_SRL: return a >> (b & (sew - 1));
+    case VOP_SRA: return (vecSigned(a, sew) >> (b & (sew - 1))) & mask;
+    }
+    return 0;
+}
+
+// d[i] = a[i] op b[i] for n elements; the SIMD kernels finish their tail here
+void vecKernelScalar(unsigned int op, unsigned int sew, unsigned char *d, const unsigned char *a, const unsigned char *b, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++)
+        vecSet(d, i, sew, vecAlu(op, sew, vecGet(a, i, sew), vecGet(b, i, sew)));
+}
+
+#ifdef RVSIM_X86_SIMD
+__attribute__((target("sse2"))) void vecKernelSse2(unsigned int op, unsigned int sew, unsigned char *d, const unsigned char *a, const unsigned char *b, unsigned int n)
+{
+    unsigned int bytes = n * (sew / 8);
+    unsigned int i = 0;
+
+    // SSE2 only has 8-bit unsigned and 16-bit signed min/max, and no 8/32-bit multiply
+    bool simd = op <= VOP_XOR || ((op == VOP_MINU || op == VOP_MAXU) && sew == 8) ||
+                ((op == VOP_MIN || op == VOP_MAX || op == VOP_MUL) && sew == 16);
+
+    for (; simd && i + 16 <= bytes; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i r;
+        switch (op)
+        {
+        case VOP_ADD: r = (sew == 8) ? _mm_add_epi8(x, y) : (sew == 16) ? _mm_add_epi16(x, y) : _mm_add_epi32(x, y); break;
+        case VOP_SUB: r = (sew == 8) ? _mm_sub_epi8(x, y) : (sew == 16) ? _mm_sub_epi16(x, y) : _mm_sub_epi32(x, y); break;
+        case VOP_AND: r = _mm_and_si128(x, y); break;
+        case VOP_OR: r = _mm_or_si128(x, y); break;
+        case VOP_XOR: r = _mm_xor_si128(x, y); break;
+        case VOP_MINU: r = _mm_min_epu8(x, y); break;
+        case VOP_MAXU: r = _mm_max_epu8(x, y); break;
+        case VOP_MIN: r = _mm_min_epi16(x, y); break;
+        case VOP_MAX: r = _mm_max_epi16(x, y); break;
+        default: r = _mm_mullo_epi16(x, y); break;
+        }
+        _mm_storeu_si128((__m128i *)(d + i), r);
+    }
+    vecKernelScalar(op, sew, d + i, a + i, b + i, (bytes - i) / (sew / 8));
+}
+
+__attribute__((target("avx2"))) void vecKernelAvx2(unsigned int op, unsigned int sew, unsigned char *d, const unsigned char *a, const unsigned char *b, unsigned int n)
+{
+    unsigned int bytes = n * (sew / 8);
+    unsigned int i = 0;
+    bool simd = op <= VOP_MAX || (op == VOP_MUL && sew != 8);
+
+    for (; simd && i + 32 <= bytes; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i r;
+        switch (op)
+        {
+        case VOP_ADD: r = (sew == 8) ? _mm256_add_epi8(x, y) : (sew == 16) ? _mm256_add_epi16(x, y) : _mm256_add_epi32(x, y); break;
+        case VOP_SUB: r = (sew == 8) ? _mm256_sub_epi8(x, y) : (sew == 16) ? _mm256_sub_epi16(x, y) : _mm256_sub_epi32(x, y); break;
+        case VOP_AND: r = _mm256_and_si256(x, y); break;
+        case VOP_OR: r = _mm256_or_si256(x, y); break;
+        case VOP_XOR: r = _mm256_xor_si256(x, y); break;
+        case VOP_MINU: r = (sew == 8) ? _mm256_min_epu8(x, y) : (sew == 16) ? _mm256_min_epu16(x, y) : _mm256_min_epu32(x, y); break;
+        case VOP_MIN: r = (sew == 8) ? _mm256_min_epi8(x, y) : (sew == 16) ? _mm256_min_epi16(x, y) : _mm256_min_epi32(x, y); break;
+        case VOP_MAXU: r = (sew == 8) ? _mm256_max_epu8(x, y) : (sew == 16) ? _mm256_max_epu16(x, y) : _mm256_max_epu32(x, y); break;
+        case VOP_MAX: r = (sew == 8) ? _mm256_max_epi8(x, y) : (sew == 16) ? _mm256_max_epi16(x, y) : _mm256_max_epi32(x, y); break;
+        default: r = (sew == 16) ? _mm256_mullo_epi16(x, y) : _mm256_mullo_epi32(x, y); break;
+        }
+        _mm256_storeu_si256((__m256i *)(d + i), r);
+    }
+    vecKernelScalar(op, sew, d + i, a + i, b + i, (bytes - i) / (sew / 8));
+}
+#endif
+
+void (*vecKernel)(unsigned int, unsigned int, unsigned char *, const unsigned char *, const unsigned char *, unsigned int) = vecKernelScalar;
+
+void vecSelectKernel()
+{
+    vecKernel = vecKernelScalar;
+#ifdef RVSIM_X86_SIMD
+    if (!simdEnabled)
+        return;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        vecKernel = vecKernelAvx2;
+    else if (__builtin_cpu_supports("sse2"))
+        vecKernel = vecKernelSse2;
+#endif
+}
+
+// element-wise op over the body [vstart, vl); masked-off elements are left undisturbed
+void vecElementwise(unsigned int op, unsigned char *d, const unsigned char *a, const unsigned char *b, bool vm)
+{
+    unsigned int sew = vecSew();
+    if (vm && vstart == 0)
+    {
+        vecKernel(op, sew, d, a, b, vl);
+        return;
+    }
+    for (unsigned int i = vstart; i < vl; i++)
+        if (vm || vecMaskBit(vreg, i))
+            vecSet(d, i, sew, vecAlu(op, sew, vecGet(a, i, sew), vecGet(b, i, sew)));
+}
+
+bool ramRange(unsigned int addr, unsigned int size)
+{
+    return addr < MEMORY_SIZE && size <= MEMORY_SIZE - addr;
+}
+
+void vectorExec(unsigned int instWord, unsigned int instPC)
+{
+    string m = vectorMnemonic(instWord);
+    unsigned int opcode = instWord & 0x7F;
+    unsigned int vd = (instWord >> 7) & 0x1F;
+    unsigned int funct3 = (instWord >> 12) & 0x7;
+    unsigned int rs1 = (instWord >> 15) & 0x1F;
+    unsigned int vs2 = (instWord >> 20) & 0x1F;
+    bool vm = (instWord >> 25) & 0x1;
+    unsigned int funct6 = instWord >> 26;
+    string masked = vm ? "" : ", v0.t";
+
+    if (m.empty())
+    {
+        illegalInstruction("\tUnkown V Instruction \n", instWord, instPC);
+        return;
+    }
+
+    if (opcode == 0x57 && funct3 == 0x7)
+    {
+        // vsetvli / vsetivli / vsetvl
+        unsigned int newType, avl;
+        cout << "\t" << m << "\t" << name[vd] << ", ";
+        if (m == "VSETIVLI")
+        {
+            newType = (instWord >> 20) & 0x3FF;
+            avl = rs1;
+            cout << dec << rs1 << ", " << vecTypeName(newType) << "\n";
+        }
+        else
+        {
+            newType = (m == "VSETVLI") ? (instWord >> 20) & 0x7FF : reg[vs2];
+            avl = (rs1 != 0) ? reg[rs1] : (vd != 0) ? 0xFFFFFFFF : vl; // rs1 = x0: VLMAX, or keep vl
+            cout << name[rs1] << ", " << ((m == "VSETVLI") ? vecTypeName(newType) : name[vs2]) << "\n";
+        }
+
+        unsigned int vlmax = vecVlmax(newType);
+        vtype = (vlmax == 0) ? 0x80000000 : newType;
+        vl = min(avl, vlmax);
+        vstart = 0;
+        reg[vd] = vl;
+        return;
+    }
+
+    if (vtype & 0x80000000)
+    {
+        illegalInstruction("\tVector instruction with vill set\n", instWord, instPC);
+        return;
+    }
+
+    unsigned int sew = vecSew();
+    int lmulLog2 = vecLmulLog2();
+
+    if (opcode == 0x07 || opcode == 0x27)
+    {
+        // unit-stride, strided, mask and fault-only-first loads/stores
+        bool store = (opcode == 0x27);
+        bool maskOp = (m == "VLM.V" || m == "VSM.V");
+        bool faultOnlyFirst = (m.find("FF") != string::npos);
+        bool strided = ((instWord >> 26) & 0x3) == 0x2;
+        unsigned int eew = (funct3 == 0x0) ? 8 : (funct3 == 0x5) ? 16 : 32;
+        int emulLog2 = maskOp ? 0 : __builtin_ctz(eew) - __builtin_ctz(sew) + lmulLog2;
+        unsigned int evl = maskOp ? (vl + 7) / 8 : vl;
+        unsigned int size = eew / 8;
+        unsigned int base = reg[rs1];
+        unsigned int stride = strided ? reg[vs2] : size;
+        unsigned char *v = vecReg(vd);
+
+        cout << "\t" << m << "\tv" << dec << vd << ", (" << name[rs1] << ")";
+        if (strided)
+            cout << ", " << name[vs2];
+        cout << masked << "\n";
+
+        if (emulLog2 < -3 || emulLog2 > 3 || !vecGroupOk(vd, emulLog2))
+        {
+            illegalInstruction("\tIllegal vector register group\n", instWord, instPC);
+            return;
+        }
+
+        if (vm && vstart == 0 && !strided && !faultOnlyFirst && ramRange(base, evl * size) &&
+            (evl == 0 || !watchedRange(base, evl * size)) && shadow == NULL)
+        {
+            if (store)
+            {
+                memDirty(base, evl * size);
+                memcpy(memory + base, v, evl * size);
+            }
+            else
+                memcpy(v, memory + base, evl * size);
+        }
+        else
+        {
+            for (unsigned int i = vstart; i < evl; i++)
+            {
+                unsigned int addr = base + i * stride;
+                if (!vm && !vecMaskBit(vreg, i))
+                    continue;
+                if (faultOnlyFirst && i > 0 && !ramRange(addr, size))
+                {
+                    vl = i; // trim vl instead of trapping past the first element
+                    break;
+                }
+
+                if (store)
+                    memWrite(addr, size, vecGet(v, i, eew));
+                else
+                {
+                    unsigned int data = memRead(addr, size);
+                    if (!memFault)
+                        vecSet(v, i, eew, data);
+                }
+                if (memFault)
+                {
+                    vstart = i;
+                    return;
+                }
+            }
+        }
+        vstart = 0;
+        return;
+    }
+
+    unsigned char *d = vecReg(vd);
+    const unsigned char *a = vecReg(vs2);
+    const unsigned char *b = vecReg(rs1);
+    unsigned char splat[MAX_VLEN];
+    unsigned char temp[MAX_VLEN];
+    unsigned int scalar = 0;
+    string op1;
+
+    // second operand: vs1, x[rs1] or the 5-bit immediate, splatted over the group for the kernels
+    if (funct3 == 0x0 || funct3 == 0x2)
+        op1 = "v" + to_string(rs1);
+    else if (funct3 == 0x3)
+    {
+        bool shift = (funct6 == 0x25 || funct6 == 0x28 || funct6 == 0x29);
+        scalar = shift ? rs1 : (unsigned int)((int)(rs1 << 27) >> 27);
+        op1 = to_string((int)scalar);
+    }
+    else
+    {
+        scalar = reg[rs1];
+        op1 = name[rs1];
+    }
+    if (funct3 == 0x3 || funct3 == 0x4 || funct3 == 0x6)
+    {
+        for (unsigned int i = 0; i < vl; i++)
+            vecSet(splat, i, sew, scalar);
+        b = splat;
+    }
+
+    bool maskResult = (funct6 >= 0x18 && funct6 <= 0x1F);
+    bool scalarResult = (m == "VMV.X.S" || m == "VCPOP.M" || m == "VFIRST.M");
+    bool maskSource = (funct3 == 0x2 && (maskResult || funct6 == 0x10 || funct6 == 0x14));
+    bool vdGroup = !(maskResult || scalarResult || m.compare(0, 4, "VRED") == 0 || m == "VMV.S.X" ||
+                     m == "VMSBF.M" || m == "VMSOF.M" || m == "VMSIF.M");
+    bool vs1Group = (funct3 == 0x0) || (funct3 == 0x2 && (funct6 == 0x25 || funct6 == 0x2D));
+    if ((vdGroup && !vecGroupOk(vd, lmulLog2)) || (!maskSource && !vecGroupOk(vs2, lmulLog2)) ||
+        (vs1Group && !vecGroupOk(rs1, lmulLog2)))
+    {
+        cout << "\t" << m << "\n";
+        illegalInstruction("\tIllegal vector register group\n", instWord, instPC);
+        return;
+    }
+
+    if (funct3 == 0x0 || funct3 == 0x3 || funct3 == 0x4)
+    {
+        // OPIVV / OPIVI / OPIVX
+        if (m.compare(0, 7, "VMV.V.") == 0)
+            cout << "\t" << m << "\tv" << dec << vd << ", " << op1 << "\n";
+        else
+            cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << ", " << op1 << (funct6 == 0x17 ? ", v0" : masked) << "\n";
+
+        switch (funct6)
+        {
+        case 0x00: vecElementwise(VOP_ADD, d, a, b, vm); break;
+        case 0x02: vecElementwise(VOP_SUB, d, a, b, vm); break;
+        case 0x03: vecElementwise(VOP_SUB, d, b, a, vm); break;
+        case 0x04: vecElementwise(VOP_MINU, d, a, b, vm); break;
+        case 0x05: vecElementwise(VOP_MIN, d, a, b, vm); break;
+        case 0x06: vecElementwise(VOP_MAXU, d, a, b, vm); break;
+        case 0x07: vecElementwise(VOP_MAX, d, a, b, vm); break;
+        case 0x09: vecElementwise(VOP_AND, d, a, b, vm); break;
+        case 0x0A: vecElementwise(VOP_OR, d, a, b, vm); break;
+        case 0x0B: vecElementwise(VOP_XOR, d, a, b, vm); break;
+        case 0x25: vecElementwise(VOP_SLL, d, a, b, vm); break;
+        case 0x28: vecElementwise(VOP_SRL, d, a, b, vm); break;
+        case 0x29: vecElementwise(VOP_SRA, d, a, b, vm); break;
+        case 0x17:
+            // vmerge picks by v0, vmv.v.* (vm = 1) always takes the second operand
+            for (unsigned int i = vstart; i < vl; i++)
+                vecSet(d, i, sew, (vm || vecMaskBit(vreg, i)) ? vecGet(b, i, sew) : vecGet(a, i, sew));
+            break;
+        default:
+        {
+            // compares write one mask bit per element
+            memcpy(temp, d, vlen / 8);
+            for (unsigned int i = vstart; i < vl; i++)
+            {
+                if (!vm && !vecMaskBit(vreg, i))
+                    continue;
+                unsigned int x = vecGet(a, i, sew), y = vecGet(b, i, sew);
+                int sx = vecSigned(x, sew), sy = vecSigned(y, sew);
+                bool bit = false;
+                switch (funct6)
+                {
+                case 0x18: bit = x == y; break;
+                case 0x19: bit = x != y; break;
+                case 0x1A: bit = x < y; break;
+                case 0x1B: bit = sx < sy; break;
+                case 0x1C: bit = x <= y; break;
+                case 0x1D: bit = sx <= sy; break;
+                case 0x1E: bit = x > y; break;
+                case 0x1F: bit = sx > sy; break;
+                }
+                vecSetMaskBit(temp, i, bit);
+            }
+            memcpy(d, temp, vlen / 8);
+        }
+        }
+    }
+    else if (m.compare(0, 4, "VRED") == 0)
+    {
+        // vd[0] = vs1[0] op vs2[active elements]
+        static const unsigned int ops[8] = {VOP_ADD, VOP_AND, VOP_OR, VOP_XOR, VOP_MINU, VOP_MIN, VOP_MAXU, VOP_MAX};
+        cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << ", " << op1 << masked << "\n";
+
+        unsigned int acc = vecGet(b, 0, sew);
+        for (unsigned int i = vstart; i < vl; i++)
+            if (vm || vecMaskBit(vreg, i))
+                acc = vecAlu(ops[funct6], sew, acc, vecGet(a, i, sew));
+        if (vl > 0)
+            vecSet(d, 0, sew, acc);
+    }
+    else if (maskResult)
+    {
+        // mask-register logical ops
+        cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << ", " << op1 << "\n";
+        memcpy(temp, d, vlen / 8);
+        for (unsigned int i = vstart; i < vl; i++)
+        {
+            bool x = vecMaskBit(a, i), y = vecMaskBit(b, i);
+            bool bit = false;
+            switch (funct6)
+            {
+            case 0x18: bit = x && !y; break;
+            case 0x19: bit = x && y; break;
+            case 0x1A: bit = x || y; break;
+            case 0x1B: bit = x != y; break;
+            case 0x1C: bit = x || !y; break;
+            case 0x1D: bit = !(x && y); break;
+            case 0x1E: bit = !(x || y); break;
+            case 0x1F: bit = x == y; break;
+            }
+            vecSetMaskBit(temp, i, bit);
+        }
+        memcpy(d, temp, vlen / 8);
+    }
+    else if (scalarResult)
+    {
+        // vd names an x register here
+        cout << "\t" << m << "\t" << name[vd] << ", v" << dec << vs2 << masked << "\n";
+        if (m == "VMV.X.S")
+            reg[vd] = vecSigned(vecGet(a, 0, sew), sew);
+        else
+        {
+            unsigned int count = 0;
+            int first = -1;
+            for (unsigned int i = 0; i < vl; i++)
+                if ((vm || vecMaskBit(vreg, i)) && vecMaskBit(a, i))
+                {
+                    count++;
+                    if (first < 0)
+                        first = i;
+                }
+            reg[vd] = (m == "VCPOP.M") ? count : (unsigned int)first;
+        }
+    }
+    else if (m == "VMV.S.X")
+    {
+        cout << "\t" << m << "\tv" << dec << vd << ", " << op1 << "\n";
+        if (vstart < vl)
+            vecSet(d, 0, sew, scalar);
+    }
+    else if (m == "VID.V")
+    {
+        cout << "\t" << m << "\tv" << dec << vd << masked << "\n";
+        for (unsigned int i = vstart; i < vl; i++)
+            if (vm || vecMaskBit(vreg, i))
+                vecSet(d, i, sew, i);
+    }
+    else if (m == "VIOTA.M")
+    {
+        cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << masked << "\n";
+        unsigned int count = 0;
+        memcpy(temp, a, vlen / 8);
+        for (unsigned int i = 0; i < vl; i++)
+            if (vm || vecMaskBit(vreg, i))
+            {
+                vecSet(d, i, sew, count);
+                count += vecMaskBit(temp, i);
+            }
+    }
+    else if (m == "VMSBF.M" || m == "VMSOF.M" || m == "VMSIF.M")
+    {
+        // set-before-first, set-only-first, set-including-first
+        cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << masked << "\n";
+        bool found = false;
+        memcpy(temp, d, vlen / 8);
+        for (unsigned int i = 0; i < vl; i++)
+        {
+            if (!vm && !vecMaskBit(vreg, i))
+                continue;
+            bool hit = !found && vecMaskBit(a, i);
+            bool bit = (m == "VMSBF.M") ? !found && !hit : (m == "VMSOF.M") ? hit : !found;
+            found = found || hit;
+            vecSetMaskBit(temp, i, bit);
+        }
+        memcpy(d, temp, vlen / 8);
+    }
+    else if (funct6 == 0x25)
+    {
+        cout << "\t" << m << "\tv" << dec << vd << ", v" << vs2 << ", " << op1 << masked << "\n";
+        vecElementwise(VOP_MUL, d, a, b, vm);
+    }
+    else
+    {
+        // VMACC: vd = vs1 * vs2 + vd, the product goes through the kernel first
+        cout << "\t" << m << "\tv" << dec << vd << ", " << op1 << ", v" << vs2 << masked << "\n";
+        vecKernel(VOP_MUL, sew, temp, a, b, vl);
+        vecElementwise(VOP_ADD, d, d, temp, vm);
+    }
+    vstart = 0;
+}
+
+// Linux/newlib system calls: number in a7, arguments in a0..a3, result (or -errno) in a0.
+// Guest output goes through guestOut, which shares cout's large buffer and is flushed at exit
+// and before anything is read from stdin.
+const int GUEST_EBADF = 9;
+const int GUEST_EFAULT = 14;
+const int GUEST_EINVAL = 22;
+const int GUEST_ENOSYS = 88; // newlib's value
+const int GUEST_AT_FDCWD = -100;
+
+char outputBuffer[1 << 20];
+ostream guestOut(NULL);
+bool quietMode = false;        // --quiet: no instruction trace, only guest output and reports
+vector<int> guestFds;          // host descriptor for each guest fd, -1 when closed
+unsigned int heapStart = 0;    // initial program break
+unsigned int heapEnd = 0;      // current program break
+
+// The sanitizer's closer look at an access that failed shadowLoad or shadowStore: the first byte that is wrong
+// decides the problem, which is printed once per instruction and kind of problem.
+unsigned long long sanitizerProblems = 0;
+set<pair<unsigned int, const char *>> sanitizerSeen;
+
+// the store's base register is sp, or s0 as a frame pointer into the stack
+bool stackRelativeStore()
+{
+    unsigned int word = memory[currentPC] | (memory[currentPC + 1] << 8);
+    unsigned int base;
+    if ((word & 0x3) == 0x2)
+        base = 2; // C.SWSP
+    else if ((word & 0x3) == 0x0)
+        base = 8 + ((word >> 7) & 0x7); // C.SW
+    else
+        base = ((word | (memory[currentPC + 2] << 16)) >> 15) & 0x1F;
+    return base == 2 || (base == 8 && reg[8] >= reg[2]);
+}
+
+void shadowCheck(unsigned int addr, int size, bool write)
+{
+    const char *problem = NULL;
+    for (int i = 0; i < size && problem == NULL; i++)
+    {
+        unsigned int a = addr + i;
+        unsigned char kind = shadow[a] & 0x3;
+        if (kind == SHADOW_FREE && a < shadowStackFloor())
+        {
+            if (a >= heapEnd)
+                problem = write ? "write below the stack pointer" : "read below the stack pointer";
+            else
+                problem = write ? "write outside the text, data, heap and stack" : "read outside the text, data, heap and stack";
+        }
+        else if (!write) // free memory below sp here is .bss that _end would have bounded: zeros
+            problem = (shadow[a] & SHADOW_WRITTEN) || (kind == SHADOW_FREE && a < reg[2]) ? NULL : "read of uninitialized memory";
+        else if (kind == SHADOW_TEXT)
+            problem = "write into text";
+        else if (kind != SHADOW_FREE && a >= reg[2] && stackRelativeStore())
+            problem = kind == SHADOW_DATA ? "stack overflow into data" : "stack overflow into the heap";
+    }
+    if (problem == NULL)
+        return;
+    sanitizerProblems++;
+    if (!sanitizerSeen.insert(make_pair(currentPC, problem)).second)
+        return;
+
+    // shown even with --quiet
+    ios::iostate traceState = cout.rdstate();
+    cout.clear();
+    string function = symbolAt(currentPC);
+    string object = (shadow[addr] & 0x3) == SHADOW_TEXT || (shadow[addr] & 0x3) == SHADOW_DATA ? symbolAt(addr) : "";
+    cout << "\t-> sanitizer: " << problem << ": " << currentMnemonic() << " at pc = 0x" << hex << currentPC;
+    if (!function.empty())
+        cout << " (" << function << ")";
+    cout << (write ? " wrote " : " read ") << dec << size << (size == 1 ? " byte" : " bytes") << " at 0x" << hex << addr;
+    if (!object.empty())
+        cout << " (" << object << ")";
+    cout << ", sp = 0x" << reg[2] << " (instruction " << dec << instCount << ")\n";
+    cout.clear(traceState);
+}
+
+// the regions after loading: the text, the data with its .bss (up to _end when the symbols give it), and the
+// stack's initial words, which crt0 reads. Without _end, the free memory above the data file below sp may be
+// .bss: it is not checked, and only the data file's range is checked for stack overflows.
+void shadowInit(unsigned int textSize, bool endKnown)
+{
+    memset(shadowBytes, SHADOW_FREE, sizeof(shadowBytes));
+    memset(shadowBytes, SHADOW_TEXT | SHADOW_WRITTEN, min(textSize, 0x00010000u));
+    if (heapStart > 0x00010000) // _end is in the text when there is no data
+        memset(shadowBytes + 0x00010000, SHADOW_DATA | SHADOW_WRITTEN, min(heapStart, MEMORY_SIZE) - 0x00010000);
+    memset(shadowBytes + reg[2], SHADOW_FREE | SHADOW_WRITTEN, MEMORY_SIZE - reg[2]);
+    shadowBssFrom = endKnown ? ~0u : heapStart;
+}
+
+// brk moved the break: memory it gives is heap that has not been written, memory it takes back is free
+void shadowBreak(unsigned int from, unsigned int to)
+{
+    for (unsigned int a = min(from, to); a < max(from, to); a++)
+        shadow[a] = to > from ? SHADOW_HEAP : SHADOW_FREE;
+}
+
+void sanitizerReport()
+{
+    if (shadow == NULL)
+        return;
+    if (sanitizerProblems == 0)
+        cout << "\nSanitizer: no bad accesses\n";
+    else
+        cout << "\nSanitizer: " << dec << sanitizerProblems << " bad accesses; the first of each kind at each pc ("
+             << sanitizerSeen.size() << ") is shown above\n";
+}
+
+int hostError()
+{
+    // errno values 1..34 are the same for newlib and the usual hosts
+    return (errno > 0 && errno < 35) ? -errno : -5;
+}
+
+int hostFd(unsigned int fd)
+{
+    return (fd < guestFds.size()) ? guestFds[fd] : -1;
+}
+
+bool guestString(unsigned int addr, string &s)
+{
+    s.clear();
+    for (; addr < MEMORY_SIZE; addr++)
+    {
+        if (memory[addr] == 0)
+            return true;
+        s += (char)memory[addr];
+    }
+    return false;
+}
+
+// Asynchronous file I/O (turned off with --sync-io). One host thread reads ahead of guests that stream a
+// read-only file and writes behind guests that produce a write-only one. Reads wait for as many bytes as a
+// synchronous read would return, so results do not depend on timing; write errors are reported by the next
+// write, seek or close. Read/write descriptors stay synchronous and all descriptors of a file are kept coherent.
+const size_t READ_AHEAD_SIZE = 1 << 20;
+const size_t READ_CHUNK = 64 * 1024;
+const size_t WRITE_BEHIND_LIMIT = 4 << 20;
+
+enum AsyncMode
+{
+    ASYNC_SYNC,
+    ASYNC_READ,
+    ASYNC_WRITE
+};
+
+struct AsyncFile
+{
+    int fd;
+    AsyncMode mode;
+    dev_t dev;
+    ino_t ino;
+    bool busy;  // the I/O thread works on this file outside the lock
+    int error;  // host errno not yet reported to the guest
+
+    // read-ahead: file bytes [offset, offset + count) are at ring[head...], wrapping around
+    vector<char> ring;
+    size_t head, count;
+    unsigned long long offset; // guest file position
+    unsigned int generation;   // bumped when the ring is thrown away
+    bool eof;
+    bool stale; // the file was written through another descriptor
+
+    // write-behind
+    vector<char> pending;
+};
+
+bool asyncIo = true;
+vector<AsyncFile *> asyncFiles; // per guest fd, NULL for descriptors without asynchronous I/O
+thread ioThread;
+mutex ioMutex;
+condition_variable ioWork; // something for the I/O thread to do
+condition_variable ioDone; // the I/O thread made progress
+bool ioStop = false;
+
+AsyncFile *asyncFile(unsigned int fd)
+{
+    return (fd < asyncFiles.size()) ? asyncFiles[fd] : NULL;
+}
+
+void ioThreadMain()
+{
+    vector<char> chunk(READ_CHUNK);
+    unique_lock<mutex> lock(ioMutex);
+
+    while (!ioStop)
+    {
+        AsyncFile *job = NULL;
+        for (unsigned int i = 0; i < asyncFiles.size() && job == NULL; i++)
+        {
+            AsyncFile *f = asyncFiles[i];
+            if (f == NULL || f->busy || f->error)
+                continue;
+            if ((f->mode == ASYNC_WRITE && !f->pending.empty()) ||
+                (f->mode == ASYNC_READ && !f->eof && !f->stale && f->count + READ_CHUNK <= f->ring.size()))
+                job = f;
+        }
+        if (job == NULL)
+        {
+            ioWork.wait(lock);
+            continue;
+        }
+
+        job->busy = true;
+        if (job->mode == ASYNC_WRITE)
+        {
+            vector<char> data;
+            data.swap(job->pending);
+            lock.unlock();
+
+            size_t done = 0;
+            int err = 0;
+            while (done < data.size())
+            {
+                ssize_t n = write(job->fd, &data[done], data.size() - done);
+                if (n < 0)
+                {
+                    err = errno;
+                    break;
+                }
+                done += n;
+            }
+            lock.lock();
+            job->error = err;
+        }
+        else
+        {
+            unsigned long long at = job->offset + job->count;
+            unsigned int generation = job->generation;
+            lock.unlock();
+
+            ssize_t n = (lseek(job->fd, at, SEEK_SET) < 0) ? -1 : read(job->fd, &chunk[0], READ_CHUNK);
+            int err = errno;
+            lock.lock();
+            if (generation == job->generation) // otherwise the guest seeked meanwhile
+            {
+                if (n < 0)
+                    job->error = err;
+                else if (n == 0)
+                    job->eof = true;
+                for (ssize_t i = 0; i < n; i++)
+                    job->ring[(job->head + job->count + i) % job->ring.size()] = chunk[i];
+                if (n > 0)
+                    job->count += n;
+            }
+        }
+        job->busy = false;
+        ioDone.notify_all();
+    }
+}
+
+// wait until the I/O thread has nothing of f in flight or queued; called with ioMutex held
+void asyncWait(unique_lock<mutex> &lock, AsyncFile *f)
+{
+    while (f->busy || (f->mode == ASYNC_WRITE && !f->pending.empty() && !f->error))
+    {
+        ioWork.notify_one();
+        ioDone.wait(lock);
+    }
+}
+
+// make the file's data on the host current before a synchronous access or a stat
+void asyncSyncFile(unique_lock<mutex> &lock, AsyncFile *f)
+{
+    for (unsigned int i = 0; i < asyncFiles.size(); i++)
+        if (asyncFiles[i] != NULL && asyncFiles[i]->mode == ASYNC_WRITE && asyncFiles[i]->dev == f->dev && asyncFiles[i]->ino == f->ino)
+            asyncWait(lock, asyncFiles[i]);
+}
+
+// after the file changed through f, readers of the same file must not use what they read ahead
+void asyncInvalidateReaders(AsyncFile *f)
+{
+    for (unsigned int i = 0; i < asyncFiles.size(); i++)
+        if (asyncFiles[i] != NULL && asyncFiles[i] != f && asyncFiles[i]->mode == ASYNC_READ &&
+            asyncFiles[i]->dev == f->dev && asyncFiles[i]->ino == f->ino)
+            asyncFiles[i]->stale = true;
+}
+
+void asyncRestart(AsyncFile *f, unsigned long long offset)
+{
+    f->offset = offset;
+    f->head = f->count = 0;
+    f->eof = f->stale = false;
+    f->generation++;
+    ioWork.notify_one();
+}
+
+int takeError(AsyncFile *f)
+{
+    errno = f->error;
+    f->error = 0;
+    return hostError();
+}
+
+void asyncShutdown()
+{
+    {
+        unique_lock<mutex> lock(ioMutex);
+        for (unsigned int i = 0; i < asyncFiles.size(); i++)
+            if (asyncFiles[i] != NULL)
+                asyncWait(lock, asyncFiles[i]);
+        ioStop = true;
+        ioWork.notify_one();
+    }
+    ioThread.join();
+}
+
+// take over a freshly opened guest descriptor; only regular files are worth it
+void asyncOpen(unsigned int guestFd, int fd, unsigned int flags)
+{
+    struct stat st;
+    if (!asyncIo || fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+        return;
+
+    AsyncFile *f = new AsyncFile();
+    f->fd = fd;
+    f->mode = ((flags & 0x3) == 0x0) ? ASYNC_READ : ((flags & 0x3) == 0x1) ? ASYNC_WRITE : ASYNC_SYNC;
+    f->dev = st.st_dev;
+    f->ino = st.st_ino;
+    f->busy = false;
+    f->error = 0;
+    f->head = f->count = 0;
+    f->offset = 0;
+    f->generation = 0;
+    f->eof = f->stale = false;
+    if (f->mode == ASYNC_READ)
+        f->ring.resize(READ_AHEAD_SIZE);
+
+    if (!ioThread.joinable())
+    {
+        ioThread = thread(ioThreadMain);
+        atexit(asyncShutdown); // queued writes reach the host before the simulator exits
+    }
+
+    unique_lock<mutex> lock(ioMutex);
+    if (f->mode == ASYNC_READ) // writes queued through another descriptor land before the first read-ahead
+        asyncSyncFile(lock, f);
+    if (asyncFiles.size() <= guestFd)
+        asyncFiles.resize(guestFd + 1, NULL);
+    asyncFiles[guestFd] = f;
+    if ((flags & 0x0400) || f->mode != ASYNC_READ) // truncated or writable: other readers are out of date
+        asyncInvalidateReaders(f);
+    ioWork.notify_one();
+}
+
+int asyncRead(AsyncFile *f, unsigned char *data, unsigned int size)
+{
+    unique_lock<mutex> lock(ioMutex);
+    if (f->mode != ASYNC_READ)
+    {
+        asyncSyncFile(lock, f);
+        int n = read(f->fd, data, size);
+        return (n < 0) ? hostError() : n;
+    }
+
+    if (f->stale)
+    {
+        asyncWait(lock, f);
+        asyncSyncFile(lock, f);
+        asyncRestart(f, f->offset);
+    }
+
+    // a synchronous read of a regular file returns everything up to the end of the file
+    unsigned int done = 0;
+    while (done < size)
+    {
+        if (f->count == 0)
+        {
+            if (f->error && done == 0)
+                return takeError(f);
+            if (f->eof || f->error)
+                break;
+            ioWork.notify_one();
+            ioDone.wait(lock);
+            continue;
+        }
+        unsigned int n = min((size_t)(size - done), min(f->count, f->ring.size() - f->head));
+        memcpy(data + done, &f->ring[f->head], n);
+        f->head = (f->head + n) % f->ring.size();
+        f->count -= n;
+        f->offset += n;
+        done += n;
+        ioWork.notify_one();
+    }
+    return done;
+}
+
+int asyncWrite(AsyncFile *f, const unsigned char *data, unsigned int size)
+{
+    unique_lock<mutex> lock(ioMutex);
+    asyncInvalidateReaders(f);
+    if (f->mode != ASYNC_WRITE)
+    {
+        asyncSyncFile(lock, f);
+        int n = write(f->fd, data, size);
+        return (n < 0) ? hostError() : n;
+    }
+
+    if (f->error)
+        return takeError(f);
+    while (!f->pending.empty() && f->pending.size() + size > WRITE_BEHIND_LIMIT && !f->error)
+    {
+        ioWork.notify_one();
+        ioDone.wait(lock);
+    }
+    f->pending.insert(f->pending.end(), data, data + size);
+    ioWork.notify_one();
+    return size;
+}
+
+int asyncSeek(AsyncFile *f, int offset, int whence)
+{
+    unique_lock<mutex> lock(ioMutex);
+    if (f->mode != ASYNC_READ)
+    {
+        asyncWait(lock, f);
+        asyncSyncFile(lock, f);
+        if (f->error)
+            return takeError(f);
+        off_t at = lseek(f->fd, offset, whence);
+        return (at < 0) ? hostError() : (int)at;
+    }
+
+    long long at = offset;
+    if (whence == SEEK_CUR)
+        at += f->offset;
+    else if (whence == SEEK_END)
+    {
+        struct stat st;
+        asyncSyncFile(lock, f);
+        if (fstat(f->fd, &st) < 0)
+            return hostError();
+        at += st.st_size;
+    }
+    if (at < 0)
+        return -GUEST_EINVAL;
+    asyncRestart(f, at);
+    return (int)at;
+}
+
+int asyncStat(AsyncFile *f, struct stat &st)
+{
+    unique_lock<mutex> lock(ioMutex);
+    asyncSyncFile(lock, f);
+    return (fstat(f->fd, &st) < 0) ? hostError() : 0;
+}
+
+int asyncClose(unsigned int guestFd)
+{
+    unique_lock<mutex> lock(ioMutex);
+    AsyncFile *f = asyncFiles[guestFd];
+    asyncWait(lock, f);
+    int result = f->error ? takeError(f) : 0;
+    asyncFiles[guestFd] = NULL;
+    if (close(f->fd) < 0 && result == 0)
+        result = hostError();
+    delete f;
+    return result;
+}
+
+// newlib's struct kernel_stat for rv32 (128 bytes); times are left at zero
+void writeGuestStat(unsigned int addr, const struct stat &st)
+{
+    memset(memory + addr, 0, 128);
+    memWrite(addr + 0, 4, (unsigned int)st.st_dev);
+    memWrite(addr + 8, 4, (unsigned int)st.st_ino);
+    memWrite(addr + 16, 4, (unsigned int)st.st_mode);
+    memWrite(addr + 20, 4, (unsigned int)st.st_nlink);
+    memWrite(addr + 48, 4, (unsigned int)st.st_size);
+    memWrite(addr + 52, 4, (unsigned int)((unsigned long long)st.st_size >> 32));
+    memWrite(addr + 56, 4, 4096);
+    memWrite(addr + 64, 4, (unsigned int)((st.st_size + 511) / 512));
+}
+
+// seconds as a 64-bit time_t followed by the 32-bit fraction, as in newlib's timeval/timespec
+void writeGuestTime(unsigned int addr, unsigned long long seconds, unsigned int fraction)
+{
+    memWrite(addr, 4, (unsigned int)seconds);
+    memWrite(addr + 4, 4, (unsigned int)(seconds >> 32));
+    memWrite(addr + 8, 4, fraction);
+    memWrite(addr + 12, 4, 0);
+}
+
+// Host calls. The ECALLs the simulator serves are the only inputs from outside: time, counters and timer
+// interrupts all follow from the instruction count. Each one is logged by instruction count with its results
+// (a0, the program break and the bytes it stored):
+// - in memory for reverse execution (--reverse), so running forward again over a call, in a replay or when gdb
+//   continues in the past, restores the results instead of repeating the call on the host;
+// - in a file with --record, which --replay loads to run the program again exactly, without opening any host
+//   file. Output to the terminal is shown again the first time each call is replayed.
+const char RECORD_MAGIC[8] = {'R', 'V', 'S', 'I', 'M', 'R', 'E', 'C'};
+const unsigned int RECORD_VERSION = 1;
+
+struct HostCall
+{
+    unsigned int a7;
+    unsigned int a0;
+    unsigned int heapEnd;
+    unsigned int addr;
+    vector<unsigned char> data;
+};
+
+bool reverseEnabled = false;
+bool cosimEnabled = false; // --cosim re-runs stretches of the program too
+map<unsigned long long, HostCall> hostCalls;
+unsigned long long hostCallsSeen = 0; // the last instruction count whose call has been done or replayed
+ofstream recordFile;
+unsigned long long recordLast = 0;
+bool replayEnabled = false;
+unsigned long long replayEnd = ~0ULL; // instruction count and exit status at the end of the recording
+int replayStatus = 0;
+
+// unsigned LEB128, so that the small numbers most calls consist of take a byte each
+void recordPut(unsigned long long value)
+{
+    do
+    {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        recordFile.put(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+unsigned long long replayGet(ifstream &in)
+{
+    unsigned long long value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = in.get();
+        if (byte < 0)
+            emitError("The recording is truncated\n");
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            break;
+    }
+    return value;
+}
+
+extern bool hleEnabled;
+
+// the settings that change what the program sees; a recording only replays with the same ones. --hle skips
+// the guest code of the calls it does, so the instruction counts of the ECALLs differ without it.
+unsigned int recordSettings()
+{
+    return vlen | (mExtension ? 1 << 16 : 0) | (zbExtension ? 1 << 17 : 0) | (hleEnabled ? 1 << 18 : 0);
+}
+
+void recordOpen(const char *name)
+{
+    recordFile.open(name, ios::out | ios::binary | ios::trunc);
+    if (!recordFile.is_open())
+        emitError("Cannot create the recording\n");
+    recordFile.write(RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    recordPut(RECORD_VERSION);
+    recordPut(recordSettings());
+}
+
+// a call is stored as the distance from the previous one, a7, a0, the break, and the bytes it stored;
+// the end of the program as a distance of 0, the instruction count and the exit status
+void replayLoad(const char *name)
+{
+    ifstream in(name, ios::in | ios::binary);
+    char magic[sizeof(RECORD_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, RECORD_MAGIC, sizeof(magic)) != 0)
+        emitError("Not a recording made with --record\n");
+    if (replayGet(in) != RECORD_VERSION)
+        emitError("The recording was made by another version of the simulator\n");
+    if (replayGet(in) != recordSettings())
+        emitError("The recording was made with other --vlen, --no-m, --no-zb or --hle settings\n");
+
+    unsigned long long at = 0;
+    while (in.peek() != EOF)
+    {
+        unsigned long long distance = replayGet(in);
+        if (distance == 0)
+        {
+            replayEnd = replayGet(in);
+            replayStatus = (int)replayGet(in);
+            break;
+        }
+        at += distance;
+        HostCall &c = hostCalls[at];
+        c.a7 = replayGet(in);
+        c.a0 = replayGet(in);
+        c.heapEnd = replayGet(in);
+        c.addr = replayGet(in);
+        c.data.resize(replayGet(in));
+        if (c.addr >= MEMORY_SIZE || c.data.size() > MEMORY_SIZE - c.addr)
+            emitError("The recording is damaged\n");
+        if (!c.data.empty() && !in.read((char *)&c.data[0], c.data.size()))
+            emitError("The recording is truncated\n");
+    }
+    replayEnabled = true;
+}
+
+void recordCall(unsigned int addr, unsigned int size)
+{
+    recordPut(instCount - recordLast);
+    recordPut(reg[17]);
+    recordPut(reg[10]);
+    recordPut(heapEnd);
+    recordPut(addr);
+    recordPut(size);
+    recordFile.write((const char *)memory + addr, size);
+    recordLast = instCount;
+}
+
+void logHostCall(unsigned int addr, unsigned int size)
+{
+    hostCallsSeen = instCount;
+    memDirty(addr, size);
+    if (recordFile.is_open())
+        recordCall(addr, size);
+    if (!reverseEnabled && !cosimEnabled)
+        return;
+    HostCall &c = hostCalls[instCount];
+    c.a7 = reg[17];
+    c.a0 = reg[10];
+    c.heapEnd = heapEnd;
+    c.addr = addr;
+    c.data.assign(memory + addr, memory + addr + size);
+}
+
+int hostFd(unsigned int fd);
+
+// successful output to the terminal, which is done again the first time a recorded call is replayed
+bool isTerminalOutput(const HostCall &c)
+{
+    return c.a7 == 1 || c.a7 == 4 || (c.a7 == 64 && c.a0 == reg[12] && (hostFd(reg[10]) == 1 || hostFd(reg[10]) == 2));
+}
+
+// true if the results of the ECALL at instCount were restored from the log
+bool replayHostCall()
+{
+    if (hostCalls.empty())
+        return false;
+    map<unsigned long long, HostCall>::iterator it = hostCalls.find(instCount);
+    if (it == hostCalls.end() || it->second.a7 != reg[17])
+    {
+        if (!replayEnabled || reg[17] == 10 || reg[17] == 93 || reg[17] == 94 || instCount <= hostCallsSeen)
+            return false;
+        cout.clear();
+        cout << "\nThe replay differs from the recording: ECALL " << dec << reg[17] << " at instruction " << instCount
+             << " (pc = 0x" << hex << currentPC << ") was not recorded\n";
+        endSimulation(1);
+    }
+    bool first = instCount > hostCallsSeen;
+    if (first && isTerminalOutput(it->second))
+        return false; // done again, its results do not depend on the host
+    externalReads++; // for idleCheck, as if the call had been done
+    reg[10] = it->second.a0;
+    heapEnd = it->second.heapEnd;
+    if (!it->second.data.empty())
+    {
+        unsigned int addr = it->second.addr, size = it->second.data.size();
+        vector<unsigned char> old;
+        if (watchedRange(addr, size))
+            old.assign(memory + addr, memory + addr + size);
+        memcpy(memory + addr, &it->second.data[0], size);
+        if (!old.empty())
+            watchHostStores(addr, size, &old[0]);
+    }
+    if (first)
+    {
+        hostCallsSeen = instCount;
+        if (recordFile.is_open())
+            recordCall(it->second.addr, it->second.data.size());
+    }
+    return true;
+}
+
+// called at the end of the program
+void recordFinish(int status)
+{
+    if (recordFile.is_open())
+    {
+        recordPut(0);
+        recordPut(instCount);
+        recordPut((unsigned int)status);
+        recordFile.close();
+    }
+    if (!replayEnabled)
+        return;
+    if (instCount == replayEnd && status == replayStatus)
+        cout << "\nReplay: the program ended as recorded, after " << dec << instCount << " instructions\n";
+    else if (replayEnd == ~0ULL)
+        cout << "\nReplay: the recording has no end, it was cut off\n";
+    else
+        cout << "\nReplay: the program ended after " << dec << instCount << " instructions with status " << status
+             << ", the recording after " << replayEnd << " with status " << replayStatus << "\n";
+}
+
+void hostSyscall()
+{
+    unsigned int a0 = reg[10], a1 = reg[11], a2 = reg[12], a3 = reg[13];
+    const char *callName = NULL;
+    int result = -GUEST_ENOSYS;
+    unsigned int outAddr = 0, outSize = 0; // guest memory the call stores to
+
+    externalReads++;
+    switch (reg[17])
+    {
+    case 64:
+    {
+        callName = "write";
+        if (!ramRange(a1, a2) && a2 != 0)
+            result = -GUEST_EFAULT;
+        else if (hostFd(a0) < 0)
+            result = -GUEST_EBADF;
+        else if (hostFd(a0) == 1)
+        {
+            guestOut.write((const char *)memory + a1, a2);
+            result = a2;
+        }
+        else if (asyncFile(a0) != NULL)
+            result = asyncWrite(asyncFile(a0), memory + a1, a2);
+        else
+        {
+            if (hostFd(a0) == 2) // keep stderr in order with buffered stdout
+                guestOut.flush();
+            result = write(hostFd(a0), memory + a1, a2);
+            if (result < 0)
+                result = hostError();
+        }
+        break;
+    }
+
+    case 63:
+    {
+        callName = "read";
+        if (!ramRange(a1, a2) && a2 != 0)
+            result = -GUEST_EFAULT;
+        else if (hostFd(a0) < 0)
+            result = -GUEST_EBADF;
+        else
+        {
+            // the only call that stores to guest memory without memWrite: a watched buffer is kept to report it
+            vector<unsigned char> before;
+            if (a2 != 0 && watchedRange(a1, a2))
+                before.assign(memory + a1, memory + a1 + a2);
+            if (asyncFile(a0) != NULL)
+                result = asyncRead(asyncFile(a0), memory + a1, a2);
+            else
+            {
+                if (hostFd(a0) == 0) // a prompt written before the read must be visible
+                    guestOut.flush();
+                result = read(hostFd(a0), memory + a1, a2);
+                if (result < 0)
+                    result = hostError();
+            }
+            if (result > 0 && !before.empty())
+                watchHostStores(a1, result, &before[0]);
+        }
+        outAddr = a1;
+        outSize = max(result, 0);
+        break;
+    }
+
+    case 56:
+    {
+        // flags use newlib's <fcntl.h> values
+        static const int access[4] = {O_RDONLY, O_WRONLY, O_RDWR, O_RDWR};
+        string path;
+        callName = "openat";
+        if (!guestString(a1, path))
+            result = -GUEST_EFAULT;
+        else if ((int)a0 != GUEST_AT_FDCWD && (path.empty() || path[0] != '/'))
+            result = -GUEST_EINVAL;
+        else
+        {
+            int flags = access[a2 & 0x3] | O_BINARY;
+            if (a2 & 0x0008)
+                flags |= O_APPEND;
+            if (a2 & 0x0200)
+                flags |= O_CREAT;
+            if (a2 & 0x0400)
+                flags |= O_TRUNC;
+            if (a2 & 0x0800)
+                flags |= O_EXCL;
+
+            int fd = open(path.c_str(), flags, a3 & 0777);
+            if (fd < 0)
+                result = hostError();
+            else
+            {
+                result = 3;
+                while (result < (int)guestFds.size() && guestFds[result] >= 0)
+                    result++;
+                if (result == (int)guestFds.size())
+                    guestFds.push_back(fd);
+                else
+                    guestFds[result] = fd;
+                asyncOpen(result, fd, a2);
+            }
+        }
+        break;
+    }
+
+    case 57:
+        callName = "close";
+        if (hostFd(a0) < 0)
+            result = -GUEST_EBADF;
+        else
+        {
+            // the host's own stdin/stdout/stderr stay open
+            if (asyncFile(a0) != NULL)
+                result = asyncClose(a0);
+            else
+                result = (hostFd(a0) > 2 && close(hostFd(a0)) < 0) ? hostError() : 0;
+            guestFds[a0] = -1;
+        }
+        break;
+
+    case 62:
+        callName = "lseek";
+        if (hostFd(a0) < 0)
+            result = -GUEST_EBADF;
+        else if (a2 > 2)
+            result = -GUEST_EINVAL;
+        else
+        {
+            static const int whence[3] = {SEEK_SET, SEEK_CUR, SEEK_END};
+            if (asyncFile(a0) != NULL)
+                result = asyncSeek(asyncFile(a0), (int)a1, whence[a2]);
+            else
+            {
+                off_t offset = lseek(hostFd(a0), (int)a1, whence[a2]);
+                result = (offset < 0) ? hostError() : (int)offset;
+            }
+        }
+        break;
+
+    case 80:
+    {
+        struct stat st;
+        callName = "fstat";
+        if (!ramRange(a1, 128))
+            result = -GUEST_EFAULT;
+        else if (hostFd(a0) < 0)
+            result = -GUEST_EBADF;
+        else if (hostFd(a0) <= 2)
+        {
+            // report the standard streams as terminals so newlib line-buffers them
+            memset(&st, 0, sizeof(st));
+            st.st_mode = S_IFCHR | 0620;
+            writeGuestStat(a1, st);
+            result = 0;
+        }
+        else
+        {
+            if (asyncFile(a0) != NULL)
+                result = asyncStat(asyncFile(a0), st);
+            else
+                result = (fstat(hostFd(a0), &st) < 0) ? hostError() : 0;
+            if (result == 0)
+                writeGuestStat(a1, st);
+        }
+        if (result == 0)
+        {
+            outAddr = a1;
+            outSize = 128;
+        }
+        break;
+    }
+
+    case 214:
+        // brk: the break may move between the end of the data and the stack pointer
+        callName = "brk";
+        if (a0 >= heapStart && a0 < reg[2])
+        {
+            if (shadow != NULL)
+                shadowBreak(heapEnd, a0);
+            heapEnd = a0;
+        }
+        result = heapEnd;
+        break;
+
+    case 93:
+    case 94:
+        cout << "\t-> exit(" << dec << (int)a0 << ")\n";
+        endSimulation((int)a0);
+
+    case 169:
+    {
+        callName = "gettimeofday";
+        unsigned long long us = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+        if (a0 != 0 && !ramRange(a0, 16))
+            result = -GUEST_EFAULT;
+        else
+        {
+            if (a0 != 0)
+            {
+                writeGuestTime(a0, us / 1000000, us % 1000000);
+                outAddr = a0;
+                outSize = 16;
+            }
+            result = 0;
+        }
+        break;
+    }
+
+    case 113:
+    {
+        callName = "clock_gettime";
+        unsigned long long ns;
+        if (a0 == 0) // CLOCK_REALTIME
+            ns = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+        else
+            ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+        if (!ramRange(a1, 16))
+            result = -GUEST_EFAULT;
+        else
+        {
+            writeGuestTime(a1, ns / 1000000000, ns % 1000000000);
+            outAddr = a1;
+            outSize = 16;
+            result = 0;
+        }
+        break;
+    }
+    }
+
+    if (callName != NULL)
+        cout << "\t-> " << callName << "(" << dec << (int)a0 << ", 0x" << hex << a1 << ", " << dec << (int)a2 << ") = " << result << "\n";
+    else
+        cout << "\t-> unknown system call " << dec << reg[17] << "\n";
+    reg[10] = result;
+    logHostCall(outAddr, outSize);
+}
+
+// High-level emulation (--hle): calls to well-known libc functions, found by name in the ELF symbol table,
+// are done natively on guest memory and return straight to ra. A hook that cannot run natively (e.g. an
+// argument outside RAM) leaves the call to the guest code. With --hle-verify the guest code runs as well
+// and its result is compared with the native one.
+bool hleEnabled = false;
+bool hleVerify = false;
+
+bool hleMemmove()
+{
+    unsigned int dst = reg[10], src = reg[11], n = reg[12];
+    if (n != 0 && (!ramRange(dst, n) || !ramRange(src, n)))
+        return false;
+    memDirty(dst, n);
+    memmove(memory + dst, memory + src, n);
+    return true;
+}
+
+bool hleMemset()
+{
+    unsigned int dst = reg[10], n = reg[12];
+    if (n != 0 && !ramRange(dst, n))
+        return false;
+    memDirty(dst, n);
+    memset(memory + dst, reg[11] & 0xFF, n);
+    return true;
+}
+
+bool hleMemcmp()
+{
+    unsigned int a = reg[10], b = reg[11], n = reg[12];
+    if (n != 0 && (!ramRange(a, n) || !ramRange(b, n)))
+        return false;
+    unsigned int i = 0;
+    while (i < n && memory[a + i] == memory[b + i])
+        i++;
+    reg[10] = (i == n) ? 0 : memory[a + i] - memory[b + i];
+    return true;
+}
+
+// length of the NUL-terminated string at addr, or -1 if it runs off the end of RAM
+int hleLength(unsigned int addr)
+{
+    if (addr >= MEMORY_SIZE)
+        return -1;
+    unsigned char *end = (unsigned char *)memchr(memory + addr, 0, MEMORY_SIZE - addr);
+    return (end == NULL) ? -1 : (int)(end - (memory + addr));
+}
+
+bool hleStrlen()
+{
+    int n = hleLength(reg[10]);
+    if (n < 0)
+        return false;
+    reg[10] = n;
+    return true;
+}
+
+bool hleStrcpy()
+{
+    int n = hleLength(reg[11]);
+    if (n < 0 || !ramRange(reg[10], n + 1))
+        return false;
+    memDirty(reg[10], n + 1);
+    memmove(memory + reg[10], memory + reg[11], n + 1);
+    return true;
+}
+
+bool hleStrcat()
+{
+    int end = hleLength(reg[10]);
+    int n = hleLength(reg[11]);
+    if (end < 0 || n < 0 || !ramRange(reg[10] + end, n + 1))
+        return false;
+    memDirty(reg[10] + end, n + 1);
+    memmove(memory + reg[10] + end, memory + reg[11], n + 1);
+    return true;
+}
+
+bool hleStrcmp()
+{
+    unsigned int a = reg[10], b = reg[11];
+    while (a < MEMORY_SIZE && b < MEMORY_SIZE && memory[a] != 0 && memory[a] == memory[b])
+        a++, b++;
+    if (a >= MEMORY_SIZE || b >= MEMORY_SIZE)
+        return false;
+    reg[10] = memory[a] - memory[b];
+    return true;
+}
+
+bool hleStrchr()
+{
+    unsigned int s = reg[10];
+    unsigned char c = reg[11] & 0xFF;
+    for (; s < MEMORY_SIZE; s++)
+    {
+        if (memory[s] == c)
+        {
+            reg[10] = s;
+            return true;
+        }
+        if (memory[s] == 0)
+        {
+            reg[10] = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct HleHook
+{
+    const char *name;
+    bool (*run)();
+    unsigned long long calls;
+};
+
+HleHook hleTable[] = {{"memcpy", hleMemmove, 0}, {"memmove", hleMemmove, 0}, {"memset", hleMemset, 0},
+                      {"memcmp", hleMemcmp, 0}, {"strlen", hleStrlen, 0}, {"strcpy", hleStrcpy, 0},
+                      {"strcat", hleStrcat, 0}, {"strcmp", hleStrcmp, 0}, {"strchr", hleStrchr, 0}};
+map<unsigned int, unsigned int> hleHooks; // function address -> hleTable index
+
+// --hle-verify: the native result waits here until the guest's own code returns to hleReturn
+bool hleVerifyPending = false;
+unsigned int hleVerifyHook = 0;
+unsigned int hleReturn = 0;
+unsigned int hleSp = 0;
+unsigned int hleMinSp = 0;
+unsigned int hleNativeReg[32];
+vector<unsigned char> hleNativeMemory;
+unsigned long long hleVerified = 0;
+unsigned long long hleMismatches = 0;
+
+void hleInstall()
+{
+    for (map<unsigned int, Symbol>::iterator it = symbols.begin(); it != symbols.end(); it++)
+        for (unsigned int i = 0; i < sizeof(hleTable) / sizeof(hleTable[0]); i++)
+            if (it->second.isFunction && it->second.name == hleTable[i].name)
+                hleHooks[it->first] = i;
+}
+
+// called after a JAL/JALR has set pc; true if the call was emulated and pc is back at ra
+bool hleCall()
+{
+    map<unsigned int, unsigned int>::iterator it = hleHooks.find(pc);
+    if (it == hleHooks.end() || hleVerifyPending || !watchpoints.empty()) // watchpoints must see the guest's accesses
+        return false;
+
+    HleHook &hook = hleTable[it->second];
+    unsigned int a0 = reg[10], a1 = reg[11], a2 = reg[12];
+    unsigned int savedReg[32];
+    memcpy(savedReg, reg, sizeof(reg));
+    if (hleVerify)
+        hleNativeMemory.assign(memory, memory + MEMORY_SIZE);
+
+    if (!hook.run())
+        return false;
+
+    hook.calls++;
+    cout << "\t-> " << hook.name << "(0x" << hex << a0 << ", 0x" << a1 << ", 0x" << a2 << ") = 0x" << reg[10] << " (emulated)\n";
+
+    if (hleVerify)
+    {
+        // keep the native result aside and let the guest code run from the original state
+        memcpy(hleNativeReg, reg, sizeof(reg));
+        memcpy(reg, savedReg, sizeof(reg));
+        swap_ranges(hleNativeMemory.begin(), hleNativeMemory.end(), memory);
+        hleVerifyPending = true;
+        hleVerifyHook = it->second;
+        hleReturn = reg[1];
+        hleSp = hleMinSp = reg[2];
+        return false;
+    }
+
+    pc = reg[1];
+    if (profileEnabled)
+        profileJump(pc, 0, 1, 0);
+    return true;
+}
+
+// the guest's own code has returned: it must agree with the native result
+void hleCheck()
+{
+    static const unsigned int preserved[] = {2, 3, 4, 8, 9, 10, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27};
+    const char *name = hleTable[hleVerifyHook].name;
+    bool same = true;
+
+    hleVerifyPending = false;
+    hleVerified++;
+    for (unsigned int i = 0; i < sizeof(preserved) / sizeof(preserved[0]); i++)
+    {
+        unsigned int r = preserved[i];
+        if (reg[r] != hleNativeReg[r])
+        {
+            cout << "\nHLE verify: " << name << " leaves " << ::name[r] << " = 0x" << hex << reg[r]
+                 << ", emulation gave 0x" << hleNativeReg[r] << "\n";
+            same = false;
+        }
+    }
+    // the callee's stack frame below the caller's sp is scratch space
+    for (unsigned int addr = 0; addr < MEMORY_SIZE; addr++)
+    {
+        if (addr >= hleMinSp && addr < hleSp)
+            continue;
+        if (memory[addr] != hleNativeMemory[addr])
+        {
+            cout << "\nHLE verify: " << name << " leaves memory[0x" << hex << addr << "] = 0x" << (int)memory[addr]
+                 << ", emulation gave 0x" << (int)hleNativeMemory[addr] << "\n";
+            same = false;
+            break;
+        }
+    }
+    if (!same)
+        hleMismatches++;
+}
+
+void hleReport()
+{
+    if (!hleEnabled)
+        return;
+    cout << "\n\nHigh-level emulation:\n";
+    for (unsigned int i = 0; i < sizeof(hleTable) / sizeof(hleTable[0]); i++)
+        if (hleTable[i].calls > 0)
+            cout << "  " << left << setfill(' ') << setw(10) << hleTable[i].name << right << dec << setw(12) << hleTable[i].calls << " calls\n";
+    if (hleVerify)
+        cout << "  verified " << dec << hleVerified << " calls, " << hleMismatches << " mismatches\n";
+}
+
+// Loop idioms (--idioms): a taken backward branch that closes a straight-line loop body is analysed once.
+// Byte copies, fills, NUL scans and plain counting loops are recognised without symbols, whether their
+// variables live in registers or in -O0 stack slots. All iterations but the last are then done natively
+// (memcpy/memset/memchr) and the registers and slots the body writes get their values after the last of them;
+// the last iteration is interpreted, so registers and memory end up exactly as before.
+bool idiomEnabled = false;
+
+const unsigned int LOOP_MAX_BODY = 64;
+const int LOOP_CONST = -1;
+
+enum
+{
+    LOOP_LINEAR,  // c + k * (value of var at the start of the iteration), or just c for LOOP_CONST
+    LOOP_LOADED,  // result of the stream load op
+    LOOP_UNKNOWN
+};
+
+struct LoopValue
+{
+    int kind;
+    unsigned int c;
+    unsigned int k;
+    int var; // 0..31 registers written in the body, 32.. stack slots
+    int op;
+};
+
+struct LoopInst
+{
+    unsigned int pc, length, opcode, funct3, funct7, rd, rs1, rs2, imm;
+};
+
+struct LoopSlot
+{
+    unsigned int addr;
+    bool liveIn, written;
+    LoopValue value;
+};
+
+struct LoopAccess
+{
+    bool store, sign; // sign: a load that sign-extends
+    unsigned int size;
+    LoopValue addr, value;
+};
+
+struct LoopIdiom
+{
+    bool ok;
+    const char *kind;
+    unsigned int target, length;
+    vector<unsigned char> code;
+    vector<unsigned int> pcs;
+    unsigned int invariantMask; // registers the analysis took as constants, and their values
+    unsigned int invariant[32];
+    vector<LoopSlot> slots;
+    vector<pair<int, unsigned int> > inductions; // (var, stride per iteration)
+    vector<pair<int, LoopValue> > temporaries;   // the other vars the body writes, by their value after an iteration
+    vector<LoopAccess> accesses;
+    unsigned int branchFunct3;
+    LoopValue left, right;
+    int scanOp; // byte load tested against zero, or -1 for a counted loop
+    unsigned long long entries, iterations;
+};
+
+map<unsigned int, LoopIdiom> idiomLoops; // by address of the backward branch
+unsigned long long idiomIterations = 0;
+unsigned long long idiomInstructions = 0;
+
+LoopValue loopConst(unsigned int c)
+{
+    return {LOOP_LINEAR, c, 0, LOOP_CONST, -1};
+}
+
+LoopValue loopUnknown()
+{
+    return {LOOP_UNKNOWN, 0, 0, LOOP_CONST, -1};
+}
+
+bool loopIsConst(const LoopValue &v)
+{
+    return v.kind == LOOP_LINEAR && (v.var == LOOP_CONST || v.k == 0);
+}
+
+LoopValue loopAdd(const LoopValue &a, const LoopValue &b, unsigned int sign)
+{
+    if (loopIsConst(b) && b.c == 0)
+        return a;
+    if (a.kind != LOOP_LINEAR || b.kind != LOOP_LINEAR)
+        return loopUnknown();
+    if (loopIsConst(b))
+        return {LOOP_LINEAR, a.c + sign * b.c, a.k, a.var, -1};
+    if (loopIsConst(a))
+        return {LOOP_LINEAR, a.c + sign * b.c, sign * b.k, b.var, -1};
+    if (a.var == b.var)
+        return {LOOP_LINEAR, a.c + sign * b.c, a.k + sign * b.k, a.var, -1};
+    return loopUnknown();
+}
+
+// the base integer instructions on constants
+unsigned int loopAlu(unsigned int funct3, unsigned int funct7, unsigned int a, unsigned int b)
+{
+    switch (funct3)
+    {
+    case 0: return funct7 == 0x20 ? a - b : a + b;
+    case 1: return a << (b & 0x1F);
+    case 2: return (int)a < (int)b;
+    case 3: return a < b;
+    case 4: return a ^ b;
+    case 5: return funct7 == 0x20 ? (unsigned int)((int)a >> (b & 0x1F)) : a >> (b & 0x1F);
+    case 6: return a | b;
+    default: return a & b;
+    }
+}
+
+bool loopBranch(unsigned int funct3, unsigned int a, unsigned int b)
+{
+    switch (funct3)
+    {
+    case 0: return a == b;
+    case 1: return a != b;
+    case 4: return (int)a < (int)b;
+    case 5: return (int)a >= (int)b;
+    case 6: return a < b;
+    default: return a >= b;
+    }
+}
+
+unsigned int signExtend(unsigned int value, unsigned int bits)
+{
+    return (unsigned int)((int)(value << (32 - bits)) >> (32 - bits));
+}
+
+// decodes the instructions a loop body may contain without executing or tracing them; false for anything else
+bool loopDecode(unsigned int addr, LoopInst &in)
+{
+    unsigned int h = memory[addr] | (memory[addr + 1] << 8);
+    in.pc = addr;
+    in.funct7 = 0;
+    in.rs2 = 0;
+    if ((h & 3) == 3)
+    {
+        unsigned int w = h | (memory[addr + 2] << 16) | (memory[addr + 3] << 24);
+        in.length = 4;
+        in.opcode = w & 0x7F;
+        in.rd = (w >> 7) & 0x1F;
+        in.funct3 = (w >> 12) & 0x7;
+        in.rs1 = (w >> 15) & 0x1F;
+        switch (in.opcode)
+        {
+        case 0x37:
+        case 0x17:
+            in.imm = w & 0xFFFFF000;
+            return true;
+        case 0x13:
+            in.imm = signExtend(w >> 20, 12);
+            if (in.funct3 == 1 || in.funct3 == 5)
+                in.funct7 = w >> 25;
+            return in.funct7 == 0 || (in.funct7 == 0x20 && in.funct3 == 5);
+        case 0x03:
+            in.imm = signExtend(w >> 20, 12);
+            return in.funct3 != 3 && in.funct3 < 6;
+        case 0x33:
+            in.rs2 = (w >> 20) & 0x1F;
+            in.funct7 = w >> 25;
+            return in.funct7 == 0 || (in.funct7 == 0x20 && (in.funct3 == 0 || in.funct3 == 5));
+        case 0x23:
+            in.rs2 = (w >> 20) & 0x1F;
+            in.imm = signExtend(((w >> 20) & 0xFE0) | ((w >> 7) & 0x1F), 12);
+            return in.funct3 <= 2;
+        case 0x63:
+            in.rs2 = (w >> 20) & 0x1F;
+            in.imm = signExtend(((w >> 19) & 0x1000) | ((w << 4) & 0x800) | ((w >> 20) & 0x7E0) | ((w >> 7) & 0x1E), 13);
+            return in.funct3 != 2 && in.funct3 != 3;
+        }
+        return false;
+    }
+
+    // RVC, expanded to the equivalent base instruction
+    unsigned int funct3 = h >> 13;
+    unsigned int rd = (h >> 7) & 0x1F, rs2 = (h >> 2) & 0x1F;
+    unsigned int rdc = 8 + ((h >> 2) & 7), rs1c = 8 + ((h >> 7) & 7);
+    unsigned int ci = signExtend(((h >> 7) & 0x20) | ((h >> 2) & 0x1F), 6);
+    unsigned int lw = ((h >> 7) & 0x38) | ((h >> 4) & 0x4) | ((h << 1) & 0x40);
+    in.length = 2;
+    switch (((h & 3) << 3) | funct3)
+    {
+    case 0x00: // C.ADDI4SPN
+        in.imm = ((h >> 7) & 0x30) | ((h >> 1) & 0x3C0) | ((h >> 4) & 0x4) | ((h >> 2) & 0x8);
+        in.opcode = 0x13, in.funct3 = 0, in.rd = rdc, in.rs1 = 2;
+        return in.imm != 0;
+    case 0x02: // C.LW
+        in.opcode = 0x03, in.funct3 = 2, in.rd = rdc, in.rs1 = rs1c, in.imm = lw;
+        return true;
+    case 0x06: // C.SW
+        in.opcode = 0x23, in.funct3 = 2, in.rs1 = rs1c, in.rs2 = rdc, in.imm = lw;
+        return true;
+    case 0x08: // C.ADDI
+    case 0x0A: // C.LI
+        in.opcode = 0x13, in.funct3 = 0, in.rd = rd, in.rs1 = funct3 == 0 ? rd : 0, in.imm = ci;
+        return true;
+    case 0x0B: // C.ADDI16SP, C.LUI
+        if (rd == 2)
+        {
+            in.imm = signExtend(((h >> 3) & 0x200) | ((h >> 2) & 0x10) | ((h << 1) & 0x40) | ((h << 4) & 0x180) | ((h << 3) & 0x20), 10);
+            in.opcode = 0x13, in.funct3 = 0, in.rd = 2, in.rs1 = 2;
+        }
+        else
+            in.opcode = 0x37, in.rd = rd, in.imm = ci << 12;
+        return ci != 0;
+    case 0x0C: // C.SRLI, C.SRAI, C.ANDI, C.SUB, C.XOR, C.OR, C.AND
+    {
+        static const unsigned int arith[4] = {0, 4, 6, 7};
+        unsigned int funct2 = (h >> 10) & 3;
+        in.rd = in.rs1 = rs1c;
+        in.imm = funct2 == 2 ? ci : (h >> 2) & 0x1F;
+        if (funct2 < 3)
+        {
+            in.opcode = 0x13, in.funct3 = funct2 == 2 ? 7 : 5, in.funct7 = funct2 == 1 ? 0x20 : 0;
+            return !(h & 0x1000);
+        }
+        in.opcode = 0x33, in.rs2 = rdc, in.funct3 = arith[(h >> 5) & 3], in.funct7 = ((h >> 5) & 3) == 0 ? 0x20 : 0;
+        return !(h & 0x1000);
+    }
+    case 0x0E: // C.BEQZ
+    case 0x0F: // C.BNEZ
+        in.imm = signExtend(((h >> 4) & 0x100) | ((h >> 7) & 0x18) | ((h << 1) & 0xC0) | ((h >> 2) & 0x6) | ((h << 3) & 0x20), 9);
+        in.opcode = 0x63, in.funct3 = funct3 & 1, in.rs1 = rs1c;
+        return true;
+    case 0x10: // C.SLLI
+        in.opcode = 0x13, in.funct3 = 1, in.rd = in.rs1 = rd, in.imm = rs2;
+        return rd != 0 && !(h & 0x1000);
+    case 0x12: // C.LWSP
+        in.opcode = 0x03, in.funct3 = 2, in.rd = rd, in.rs1 = 2;
+        in.imm = ((h >> 7) & 0x20) | ((h >> 2) & 0x1C) | ((h << 4) & 0xC0);
+        return rd != 0;
+    case 0x14: // C.MV, C.ADD (C.JR, C.JALR and C.EBREAK end the body)
+        in.opcode = 0x33, in.funct3 = 0, in.rd = rd, in.rs1 = (h & 0x1000) ? rd : 0, in.rs2 = rs2;
+        return rd != 0 && rs2 != 0;
+    case 0x16: // C.SWSP
+        in.opcode = 0x23, in.funct3 = 2, in.rs1 = 2, in.rs2 = rs2;
+        in.imm = ((h >> 7) & 0x3C) | ((h >> 1) & 0xC0);
+        return true;
+    }
+    return false;
+}
+
+// symbolic run of one iteration from target to the branch at branchPC
+void loopAnalyse(LoopIdiom &loop, unsigned int branchPC)
+{
+    vector<LoopInst> body;
+    unsigned int written = 0;
+    LoopValue regs[32];
+    bool regSet[32] = {false};
+    bool regLiveIn[32] = {false};
+
+    loop.ok = false;
+    loop.slots.clear();
+    loop.inductions.clear();
+    loop.temporaries.clear();
+    loop.accesses.clear();
+    loop.invariantMask = 0;
+    loop.scanOp = -1;
+
+    for (unsigned int addr = loop.target; addr <= branchPC; addr += body.back().length)
+    {
+        LoopInst in;
+        if (body.size() == LOOP_MAX_BODY || !loopDecode(addr, in))
+            return;
+        if (in.opcode == 0x63 && addr != branchPC)
+            return;
+        body.push_back(in);
+        if (in.opcode != 0x63 && in.opcode != 0x23)
+            written |= 1u << in.rd;
+    }
+    if (body.back().pc != branchPC || body.back().opcode != 0x63 || branchPC + body.back().imm != loop.target)
+        return;
+    loop.length = body.size();
+    loop.pcs.clear();
+    for (unsigned int i = 0; i < body.size(); i++)
+        loop.pcs.push_back(body[i].pc);
+    written &= ~1u;
+
+    for (unsigned int i = 0; i < body.size(); i++)
+    {
+        const LoopInst &in = body[i];
+        LoopValue a, b, result = loopUnknown();
+        unsigned int regsUsed[2] = {in.rs1, in.rs2};
+        LoopValue *values[2] = {&a, &b};
+
+        for (int j = 0; j < 2; j++)
+        {
+            unsigned int r = regsUsed[j];
+            if (!(written & (1u << r)))
+            {
+                // not written in the loop: a constant for as long as it runs
+                *values[j] = loopConst(reg[r]);
+                if (r != 0)
+                {
+                    loop.invariantMask |= 1u << r;
+                    loop.invariant[r] = reg[r];
+                }
+            }
+            else if (regSet[r])
+                *values[j] = regs[r];
+            else
+            {
+                regLiveIn[r] = true;
+                *values[j] = {LOOP_LINEAR, 0, 1, (int)r, -1};
+            }
+        }
+
+        switch (in.opcode)
+        {
+        case 0x37:
+            result = loopConst(in.imm);
+            break;
+        case 0x17:
+            result = loopConst(in.pc + in.imm);
+            break;
+        case 0x13:
+        case 0x33:
+        {
+            LoopValue operand = in.opcode == 0x13 ? loopConst(in.imm) : b;
+            if (in.funct3 == 0)
+                result = loopAdd(a, operand, in.opcode == 0x33 && in.funct7 == 0x20 ? -1u : 1);
+            else if (loopIsConst(a) && loopIsConst(operand))
+                result = loopConst(loopAlu(in.funct3, in.funct7, a.c, operand.c));
+            else if (in.funct3 == 1 && loopIsConst(operand) && a.kind == LOOP_LINEAR)
+                result = {LOOP_LINEAR, a.c << (operand.c & 0x1F), a.k << (operand.c & 0x1F), a.var, -1};
+            break;
+        }
+        case 0x03:
+        case 0x23:
+        {
+            bool store = in.opcode == 0x23;
+            unsigned int size = 1 << (in.funct3 & 3);
+            LoopValue addr = loopAdd(a, loopConst(in.imm), 1);
+            if (addr.kind != LOOP_LINEAR)
+                return;
+            if (loopIsConst(addr))
+            {
+                // a variable in a stack slot (or any fixed word)
+                unsigned int s;
+                if (size != 4 || !ramRange(addr.c, 4) || addr.c >= CLINT_BASE)
+                    return;
+                for (s = 0; s < loop.slots.size(); s++)
+                {
+                    if (loop.slots[s].addr == addr.c)
+                        break;
+                    if (loop.slots[s].addr + 4 > addr.c && addr.c + 4 > loop.slots[s].addr)
+                        return;
+                }
+                if (s == loop.slots.size())
+                    loop.slots.push_back({addr.c, false, false, loopUnknown()});
+                LoopSlot &slot = loop.slots[s];
+                if (store)
+                {
+                    slot.written = true;
+                    slot.value = b;
+                }
+                else if (slot.written)
+                    result = slot.value;
+                else
+                {
+                    slot.liveIn = true;
+                    result = {LOOP_LINEAR, 0, 1, (int)(32 + s), -1};
+                }
+            }
+            else
+            {
+                if (!store)
+                    result = {LOOP_LOADED, 0, 0, LOOP_CONST, (int)loop.accesses.size()};
+                loop.accesses.push_back({store, !store && in.funct3 < 4, size, addr, store ? b : loopUnknown()});
+            }
+            break;
+        }
+        case 0x63:
+            loop.branchFunct3 = in.funct3;
+            loop.left = a;
+            loop.right = b;
+            break;
+        default:
+            return;
+        }
+
+        if (in.opcode != 0x63 && in.opcode != 0x23 && in.rd != 0)
+        {
+            regs[in.rd] = result;
+            regSet[in.rd] = true;
+        }
+    }
+
+    // what is live on entry must advance by a constant every iteration; the rest is recomputed
+    for (unsigned int r = 1; r < 32; r++)
+    {
+        if (!regLiveIn[r])
+            continue;
+        if (regs[r].kind != LOOP_LINEAR || regs[r].var != (int)r || regs[r].k != 1)
+            return;
+        loop.inductions.push_back(make_pair((int)r, regs[r].c));
+    }
+    for (unsigned int s = 0; s < loop.slots.size(); s++)
+    {
+        LoopSlot &slot = loop.slots[s];
+        if (!slot.liveIn || !slot.written)
+            continue;
+        if (slot.value.kind != LOOP_LINEAR || slot.value.var != (int)(32 + s) || slot.value.k != 1)
+            return;
+        loop.inductions.push_back(make_pair((int)(32 + s), slot.value.c));
+    }
+
+    // the rest of what the body writes must be known after any iteration, so the skip leaves an exact state
+    for (unsigned int r = 1; r < 32; r++)
+        if (regSet[r] && !regLiveIn[r])
+        {
+            if (regs[r].kind == LOOP_UNKNOWN)
+                return;
+            loop.temporaries.push_back(make_pair((int)r, regs[r]));
+        }
+    for (unsigned int s = 0; s < loop.slots.size(); s++)
+        if (loop.slots[s].written && !loop.slots[s].liveIn)
+        {
+            if (loop.slots[s].value.kind == LOOP_UNKNOWN)
+                return;
+            loop.temporaries.push_back(make_pair((int)(32 + s), loop.slots[s].value));
+        }
+
+    bool copies = false, fills = false;
+    for (unsigned int i = 0; i < loop.accesses.size(); i++)
+    {
+        LoopAccess &access = loop.accesses[i];
+        unsigned int stride = 0;
+        for (unsigned int j = 0; j < loop.inductions.size(); j++)
+            if (loop.inductions[j].first == access.addr.var)
+                stride = loop.inductions[j].second * access.addr.k;
+        if (stride != access.size)
+            return; // only forward, contiguous streams
+        if (!access.store)
+            continue;
+        if (loopIsConst(access.value))
+            fills = true;
+        else if (access.value.kind == LOOP_LOADED && loop.accesses[access.value.op].size == access.size)
+            copies = true;
+        else
+            return;
+    }
+
+    // the branch continues while a loaded byte is non-zero, or compares induction variables
+    LoopValue left = loop.left, right = loop.right;
+    if (left.kind != LOOP_LOADED)
+        swap(left, right);
+    if (left.kind == LOOP_LOADED)
+    {
+        if (loop.branchFunct3 != 1 || !loopIsConst(right) || right.c != 0 || loop.accesses[left.op].size != 1)
+            return;
+        loop.scanOp = left.op;
+    }
+    else if (loop.left.kind != LOOP_LINEAR || loop.right.kind != LOOP_LINEAR)
+        return;
+
+    loop.kind = copies ? "copy" : fills ? "fill" : loop.scanOp >= 0 ? "scan" : "count";
+    loop.code.assign(memory + loop.target, memory + branchPC + body.back().length);
+    loop.ok = true;
+}
+
+unsigned int loopEntryValue(const LoopIdiom &loop, int var)
+{
+    if (var < 32)
+        return reg[var];
+    unsigned int addr = loop.slots[var - 32].addr;
+    return memory[addr] | (memory[addr + 1] << 8) | (memory[addr + 2] << 16) | (memory[addr + 3] << 24);
+}
+
+unsigned int loopStride(const LoopIdiom &loop, int var)
+{
+    for (unsigned int j = 0; j < loop.inductions.size(); j++)
+        if (loop.inductions[j].first == var)
+            return loop.inductions[j].second;
+    return 0;
+}
+
+// value of v at the end of iteration i
+unsigned int loopEvaluate(const LoopIdiom &loop, const LoopValue &v, unsigned long long i)
+{
+    if (loopIsConst(v))
+        return v.c;
+    return v.c + v.k * (loopEntryValue(loop, v.var) + loopStride(loop, v.var) * (unsigned int)i);
+}
+
+bool loopOverlap(unsigned int a, unsigned long long aSize, unsigned int b, unsigned long long bSize)
+{
+    return aSize != 0 && bSize != 0 && a < b + bSize && b < a + aSize;
+}
+
+// called after a taken backward branch at branchPC; runs all but the last iteration natively
+// a conditional branch, or C.BEQZ or C.BNEZ, which expand to one; jumps, returns and traps close no idiom
+bool conditionalBranch(unsigned int addr)
+{
+    unsigned int h = memory[addr] | (memory[addr + 1] << 8);
+    return (h & 3) == 3 ? (h & 0x7F) == 0x63 : (h & 0xC003) == 0xC001;
+}
+
+void loopIdiom(unsigned int branchPC)
+{
+    map<unsigned int, LoopIdiom>::iterator it = idiomLoops.find(branchPC);
+    if (it == idiomLoops.end())
+    {
+        it = idiomLoops.insert(make_pair(branchPC, LoopIdiom())).first;
+        it->second.target = ~0u;
+        it->second.entries = it->second.iterations = 0;
+    }
+    LoopIdiom &loop = it->second;
+
+    // the cached analysis holds while the code and the registers it took as constants are unchanged
+    bool valid = loop.target == pc && loop.code.size() != 0 && memcmp(&loop.code[0], memory + pc, loop.code.size()) == 0;
+    for (unsigned int r = 1; valid && r < 32; r++)
+        if ((loop.invariantMask & (1u << r)) && reg[r] != loop.invariant[r])
+            valid = false;
+    if (!valid)
+    {
+        loop.target = pc;
+        loopAnalyse(loop, branchPC);
+        if (!loop.ok)
+            loop.code.assign(memory + pc, memory + branchPC + 4); // remembered as not an idiom
+    }
+    if (!loop.ok)
+        return;
+
+    // iterations whose memory accesses all stay in RAM
+    unsigned long long limit = 1 << 24;
+    vector<unsigned int> base(loop.accesses.size());
+    for (unsigned int i = 0; i < loop.accesses.size(); i++)
+    {
+        unsigned int size = loop.accesses[i].size;
+        base[i] = loopEvaluate(loop, loop.accesses[i].addr, 0);
+        limit = min(limit, base[i] > MEMORY_SIZE - size ? 0ULL : (unsigned long long)(MEMORY_SIZE - size - base[i]) / size + 1);
+    }
+
+    // the iteration that leaves the loop; if it is not found in range only iterations that complete are skipped
+    unsigned long long count = limit == 0 ? 0 : limit - 1;
+    if (loop.scanOp >= 0)
+    {
+        unsigned char *nul = (unsigned char *)memchr(memory + base[loop.scanOp], 0, limit);
+        if (nul != NULL)
+            count = nul - (memory + base[loop.scanOp]);
+    }
+    else
+    {
+        for (unsigned long long i = 0; i < limit; i++)
+            if (!loopBranch(loop.branchFunct3, loopEvaluate(loop, loop.left, i), loopEvaluate(loop, loop.right, i)))
+            {
+                count = i;
+                break;
+            }
+    }
+
+    // an interrupt becomes visible at the first back edge where instCount reaches nextEventAt
+    if (nextEventAt != ~0ULL)
+        count = instCount >= nextEventAt ? 0 : min(count, (nextEventAt - instCount + loop.length - 1) / loop.length);
+    if (count == 0)
+        return;
+
+    // stores must not feed the loads, each other, the variables or the loop's own code
+    for (unsigned int i = 0; i < loop.accesses.size(); i++)
+    {
+        const LoopAccess &a = loop.accesses[i];
+        unsigned long long aSize = count * a.size + (a.store ? 0 : a.size);
+        aSize = min(aSize, (unsigned long long)MEMORY_SIZE - base[i]);
+        for (unsigned int s = 0; s < loop.slots.size(); s++)
+            if ((a.store || loop.slots[s].written) && loopOverlap(base[i], aSize, loop.slots[s].addr, 4))
+                return;
+        if (a.store && loopOverlap(base[i], aSize, loop.target, loop.code.size()))
+            return;
+        for (unsigned int j = 0; j < i; j++)
+        {
+            const LoopAccess &b = loop.accesses[j];
+            unsigned long long bSize = min(count * b.size + (b.store ? 0 : b.size), (unsigned long long)MEMORY_SIZE - base[j]);
+            if ((a.store || b.store) && loopOverlap(base[i], aSize, base[j], bSize))
+                return;
+        }
+    }
+
+    for (unsigned int i = 0; i < loop.accesses.size(); i++)
+    {
+        const LoopAccess &a = loop.accesses[i];
+        if (!a.store)
+            continue;
+        memDirty(base[i], count * a.size);
+        if (a.value.kind == LOOP_LOADED)
+            memcpy(memory + base[i], memory + base[a.value.op], count * a.size);
+        else if (a.size == 1 || (a.size == 2 && (a.value.c & 0xFF) == ((a.value.c >> 8) & 0xFF)) ||
+                 a.value.c == (a.value.c & 0xFF) * 0x01010101u)
+            memset(memory + base[i], a.value.c & 0xFF, count * a.size);
+        else
+            for (unsigned long long n = 0; n < count; n++)
+                memcpy(memory + base[i] + n * a.size, &a.value.c, a.size); // little-endian host
+    }
+
+    vector<unsigned int> entry(loop.inductions.size());
+    for (unsigned int j = 0; j < loop.inductions.size(); j++)
+        entry[j] = loopEntryValue(loop, loop.inductions[j].first) + loop.inductions[j].second * (unsigned int)count;
+    vector<unsigned int> last(loop.temporaries.size());
+    for (unsigned int j = 0; j < loop.temporaries.size(); j++)
+    {
+        const LoopValue &v = loop.temporaries[j].second;
+        if (v.kind == LOOP_LINEAR)
+        {
+            last[j] = loopEvaluate(loop, v, count - 1);
+            continue;
+        }
+        const LoopAccess &a = loop.accesses[v.op];
+        unsigned int addr = base[v.op] + (unsigned int)(count - 1) * a.size;
+        last[j] = memory[addr];
+        for (unsigned int i = 1; i < a.size; i++)
+            last[j] |= memory[addr + i] << (8 * i);
+        if (a.sign && a.size < 4)
+            last[j] = signExtend(last[j], 8 * a.size);
+    }
+    for (unsigned int j = 0; j < loop.inductions.size() + loop.temporaries.size(); j++)
+    {
+        bool induction = j < loop.inductions.size();
+        int var = induction ? loop.inductions[j].first : loop.temporaries[j - loop.inductions.size()].first;
+        unsigned int value = induction ? entry[j] : last[j - loop.inductions.size()];
+        if (var < 32)
+            reg[var] = value;
+        else
+        {
+            memDirty(loop.slots[var - 32].addr, 4);
+            memcpy(memory + loop.slots[var - 32].addr, &value, 4);
+        }
+    }
+
+    unsigned long long skipped = count * loop.length;
+    instCount += skipped;
+    if (profileEnabled)
+        profileSkip(skipped);
+    if (statsEnabled)
+        for (unsigned int i = 0; i < loop.pcs.size(); i++)
+            pcCount[loop.pcs[i] >> 1] += count;
+    loop.entries++;
+    loop.iterations += count;
+    idiomIterations += count;
+    idiomInstructions += skipped;
+    cout << "\t-> " << loop.kind << " loop 0x" << hex << loop.target << "-0x" << branchPC << ": " << dec << count
+         << " iterations run natively\n";
+}
+
+void idiomReport()
+{
+    if (!idiomEnabled)
+        return;
+    cout << "\n\nLoop idioms:\n";
+    for (map<unsigned int, LoopIdiom>::iterator it = idiomLoops.begin(); it != idiomLoops.end(); it++)
+        if (it->second.iterations > 0)
+            cout << "  0x" << hex << setfill('0') << setw(8) << it->second.target << "-0x" << setw(8) << it->first
+                 << setfill(' ') << "  " << left << setw(6) << it->second.kind << right << dec << setw(8)
+                 << it->second.entries << " times" << setw(12) << it->second.iterations << " iterations\n";
+    cout << "  short-circuited " << dec << idiomIterations << " iterations (" << idiomInstructions << " instructions)\n";
+}
+
+// Idle detection: at block boundaries the machine state (registers, CSRs, vector state and RAM) is compared with
+// a snapshot taken earlier at the same pc, Brent-style at doubling distances. If it repeats and nothing outside
+// the state was read in between (time, host files), the program can only repeat itself. It is then
+// fast-forwarded by whole periods to the next timer event, or stopped if no interrupt is enabled.
+bool idleDetect = true;
+
+const unsigned long long IDLE_MIN_PERIOD = 64;
+const unsigned long long IDLE_MAX_PERIOD = 1 << 20;
+
+struct IdleSnapshot
+{
+    bool valid;
+    unsigned int pc;
+    unsigned long long at;
+    unsigned long long externalReads;
+    unsigned int reg[32];
+    unsigned int csr[11];
+    unsigned long long mtimecmp;
+    vector<unsigned char> memory;
+    vector<unsigned char> vreg;
+    vector<unsigned long long> pcCount;
+};
+
+IdleSnapshot idleSnapshot = {};
+unsigned long long idleDistance = IDLE_MIN_PERIOD;
+unsigned long long idleCompareAt = 0;
+unsigned long long idleSkipped = 0;
+
+void idleCsrs(unsigned int *csr)
+{
+    unsigned int values[11] = {mstatus, mie, mtvec, mscratch, mepc, mcause, mtval, msip, vl, vtype, vstart};
+    memcpy(csr, values, sizeof(values));
+}
+
+void idleTakeSnapshot()
+{
+    IdleSnapshot &s = idleSnapshot;
+    s.valid = true;
+    s.pc = pc;
+    s.at = instCount;
+    s.externalReads = externalReads;
+    memcpy(s.reg, reg, sizeof(reg));
+    idleCsrs(s.csr);
+    s.mtimecmp = mtimecmp;
+    s.memory.assign(memory, memory + MEMORY_SIZE);
+    s.vreg.assign(vreg, vreg + sizeof(vreg));
+    if (statsEnabled)
+        s.pcCount = pcCount;
+    idleCompareAt = instCount + 1;
+}
+
+bool idleRepeats()
+{
+    IdleSnapshot &s = idleSnapshot;
+    unsigned int csr[11];
+    idleCsrs(csr);
+    if (memcmp(s.reg, reg, sizeof(reg)) != 0 || memcmp(s.csr, csr, sizeof(csr)) != 0 || s.mtimecmp != mtimecmp ||
+        s.externalReads != externalReads || instCount < idleCompareAt)
+        return false;
+
+    // the expensive part; after a miss it is only tried again once a good part of the distance has passed
+    if (memcmp(&s.memory[0], memory, MEMORY_SIZE) == 0 && memcmp(&s.vreg[0], vreg, sizeof(vreg)) == 0)
+        return true;
+    idleCompareAt = instCount + max(IDLE_MIN_PERIOD, (instCount - s.at) / 4);
+    return false;
+}
+
+// called when control flow leaves a block; ends the simulation if the program can never leave the loop it is in
+void idleCheck()
+{
+    IdleSnapshot &s = idleSnapshot;
+    if (!s.valid || instCount - s.at >= idleDistance)
+    {
+        idleDistance = min(2 * idleDistance, IDLE_MAX_PERIOD);
+        idleTakeSnapshot();
+        return;
+    }
+    if (pc != s.pc || !idleRepeats())
+        return;
+
+    unsigned long long period = instCount - s.at;
+    if (nextEventAt == ~0ULL)
+    {
+        cout.clear();
+        cout << "\nEndless loop: the state at pc = 0x" << hex << pc << " repeats every " << dec << period
+             << " instructions and no interrupt is enabled\n";
+        endSimulation(1);
+    }
+
+    // skip whole periods while no block boundary can reach nextEventAt
+    unsigned long long periods = instCount >= nextEventAt ? 0 : (nextEventAt - instCount) / period;
+    if (periods == 0)
+    {
+        // less than a period to go: the snapshot is kept, and not compared again before the event
+        idleCompareAt = max(nextEventAt, instCount + period);
+        return;
+    }
+
+    unsigned long long skipped = periods * period;
+    if (statsEnabled)
+        for (unsigned int i = 0; i < pcCount.size(); i++)
+            pcCount[i] += periods * (pcCount[i] - s.pcCount[i]);
+    if (profileEnabled)
+        profileSkip(skipped);
+    instCount += skipped;
+    idleSkipped += skipped;
+    cout << "\t-> idle: the state repeats every " << dec << period << " instructions, skipped " << skipped
+         << " to the next timer event\n";
+    idleTakeSnapshot();
+}
+
+// WFI: time jumps to the first enabled interrupt; with none enabled it does nothing
+void wfiWait()
+{
+    if ((mip() & mie) != 0 || !(mie & MIP_MTIP) || mtimecmp == ~0ULL)
+        return;
+
+    unsigned long long ticks = mtimecmp - mtime();
+    mtimeOffset += ticks;
+    cycleOffset += ticks;
+    idleSkipped += ticks;
+    cout << "\t-> waited " << dec << ticks << " ticks for the timer\n";
+    updateNextEvent();
+    checkInterrupts();
+}
+
+// GDB remote serial protocol (--gdb <port> or --gdb unix:<path>). The simulator waits for gdb before the first
+// instruction. Breakpoints are a byte per halfword pc that the main loop only looks at while gdb is attached, so
+// other pcs cost one table lookup. Watchpoints are checked in memRead/memWrite.
+const int GDB_SIGINT = 2;
+const int GDB_SIGILL = 4;
+const int GDB_SIGTRAP = 5;
+const int GDB_SIGSEGV = 11;
+const unsigned int GDB_POLL_INTERVAL = 1 << 16;
+
+string gdbSpec;
+int gdbFd = -1;
+bool gdbAttached = false;
+bool gdbAttention = false; // a step, watchpoint hit or signal is pending
+bool gdbStepping = false;
+bool gdbFaulting = false; // stopped inside an instruction by an access fault
+string gdbReverse;        // bs or bc received there
+int gdbSignal = 0;
+unsigned long long gdbResumeCount = ~0ULL;
+unsigned int gdbPollCountdown = GDB_POLL_INTERVAL;
+vector<unsigned char> gdbBreakpoint;
+unsigned int gdbBreakpointCount = 0;
+string gdbWatchHit;
+vector<unsigned char> gdbInput;
+unsigned int gdbInputPos = 0;
+
+const char *gdbTargetXml =
+    "<?xml version=\"1.0\"?><!DOCTYPE target SYSTEM \"gdb-target.dtd\"><target version=\"1.0\">"
+    "<architecture>riscv:rv32</architecture><feature name=\"org.gnu.gdb.riscv.cpu\">";
+
+void gdbListen()
+{
+    int listenFd;
+    string where;
+    if (gdbSpec.compare(0, 5, "unix:") == 0)
+    {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, gdbSpec.c_str() + 5, sizeof(addr.sun_path) - 1);
+        unlink(addr.sun_path);
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0 || bind(listenFd, (sockaddr *)&addr, sizeof(addr)) < 0)
+            emitError("Cannot open the gdb socket\n");
+        where = addr.sun_path;
+    }
+    else
+    {
+        sockaddr_in addr = {};
+        int on = 1;
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(atoi(gdbSpec.c_str()));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd >= 0)
+            setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (listenFd < 0 || bind(listenFd, (sockaddr *)&addr, sizeof(addr)) < 0)
+            emitError("Cannot open the gdb socket\n");
+        where = "localhost:" + gdbSpec;
+    }
+
+    cerr << "Waiting for gdb on " << where << " (target remote " << where << ")\n";
+    if (listen(listenFd, 1) < 0 || (gdbFd = accept(listenFd, NULL, NULL)) < 0)
+        emitError("Cannot accept the gdb connection\n");
+    close(listenFd);
+    if (gdbSpec.compare(0, 5, "unix:") != 0)
+    {
+        int on = 1;
+        setsockopt(gdbFd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    gdbAttached = true;
+    gdbBreakpoint.assign(MEMORY_SIZE / 2, 0);
+}
+
+// -1 once gdb has gone away
+int gdbGetByte()
+{
+    if (gdbInputPos == gdbInput.size())
+    {
+        unsigned char buf[4096];
+        ssize_t n = recv(gdbFd, buf, sizeof(buf), 0);
+        if (n <= 0)
+            return -1;
+        gdbInput.assign(buf, buf + n);
+        gdbInputPos = 0;
+    }
+    return gdbInput[gdbInputPos++];
+}
+
+void gdbDetach()
+{
+    if (gdbFd >= 0)
+        close(gdbFd);
+    gdbFd = -1;
+    gdbAttached = gdbAttention = gdbStepping = false;
+    gdbBreakpointCount = 0;
+    for (unsigned int i = watchpoints.size(); i-- > 0;)
+        if (!watchpoints[i].logged)
+            watchpoints.erase(watchpoints.begin() + i);
+    watchUpdatePages();
+}
+
+void gdbSend(const string &data)
+{
+    static const char digits[] = "0123456789abcdef";
+    unsigned char sum = 0;
+    for (unsigned int i = 0; i < data.size(); i++)
+        sum += data[i];
+    string packet = "$" + data + "#" + digits[sum >> 4] + digits[sum & 0xF];
+    do
+    {
+        if (send(gdbFd, packet.data(), packet.size(), MSG_NOSIGNAL) < 0)
+            return;
+    } while (gdbGetByte() == '-');
+}
+
+bool gdbReceive(string &data)
+{
+    int c;
+    do
+    {
+        if ((c = gdbGetByte()) < 0)
+            return false;
+    } while (c != '$');
+
+    data.clear();
+    while ((c = gdbGetByte()) != '#')
+    {
+        if (c < 0)
+            return false;
+        if (c == '}')
+            c = gdbGetByte() ^ 0x20;
+        data += (char)c;
+    }
+    gdbGetByte(); // checksum: the socket is reliable
+    gdbGetByte();
+    send(gdbFd, "+", 1, MSG_NOSIGNAL);
+    return true;
+}
+
+// ctrl-C from gdb while the program runs
+bool gdbInterruptPending()
+{
+    pollfd p = {gdbFd, POLLIN, 0};
+    if (gdbInputPos == gdbInput.size() && poll(&p, 1, 0) <= 0)
+        return false;
+    return gdbGetByte() == 0x03;
+}
+
+string gdbHex(unsigned int value, int bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    string s;
+    for (int i = 0; i < bytes; i++, value >>= 8) // target byte order
+        s += string(1, digits[(value >> 4) & 0xF]) + digits[value & 0xF];
+    return s;
+}
+
+unsigned int gdbDigit(char c)
+{
+    return isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10;
+}
+
+// a big-endian number such as an address or a length; pos is left on the character after it
+unsigned int gdbParseHex(const string &s, size_t &pos)
+{
+    unsigned int value = 0;
+    for (; pos < s.size() && isxdigit((unsigned char)s[pos]); pos++)
+        value = value * 16 + gdbDigit(s[pos]);
+    return value;
+}
+
+unsigned int gdbByte(const string &s, size_t pos)
+{
+    return pos + 1 < s.size() ? gdbDigit(s[pos]) * 16 + gdbDigit(s[pos + 1]) : 0;
+}
+
+// a register value, in target byte order
+unsigned int gdbParseLE(const string &s, size_t pos)
+{
+    unsigned int value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= gdbByte(s, pos + 2 * i) << (8 * i);
+    return value;
+}
+
+string gdbTargetDescription()
+{
+    string xml = gdbTargetXml;
+    for (int r = 0; r <= 32; r++)
+    {
+        const char *type = (r == 1 || r == 32) ? "code_ptr" : (r == 2 || r == 3 || r == 4 || r == 8) ? "data_ptr" : "int";
+        xml += "<reg name=\"" + (r == 32 ? string("pc") : name[r]) + "\" bitsize=\"32\" type=\"" + type + "\" regnum=\"" +
+               to_string(r) + "\"/>";
+    }
+    return xml + "</feature></target>";
+}
+
+bool gdbSetPoint(char type, unsigned int addr, unsigned int length, bool insert)
+{
+    if (type == '0' || type == '1')
+    {
+        if (addr >= MEMORY_SIZE)
+            return false;
+        unsigned char &bp = gdbBreakpoint[addr >> 1];
+        if (insert && bp++ == 0)
+            gdbBreakpointCount++;
+        else if (!insert && bp > 0 && --bp == 0)
+            gdbBreakpointCount--;
+        return true;
+    }
+    for (unsigned int i = 0; i < watchpoints.size(); i++)
+    {
+        const Watchpoint &w = watchpoints[i];
+        if (!w.logged && w.type == type && w.addr == addr && w.length == length)
+        {
+            if (!insert)
+                watchpoints.erase(watchpoints.begin() + i);
+            watchUpdatePages();
+            return true;
+        }
+    }
+    if (insert)
+        watchpoints.push_back({type, addr, length, false});
+    watchUpdatePages();
+    return true;
+}
+
+// a gdb watchpoint was hit; gdb is told before the next instruction
+void gdbWatchTriggered(char type, unsigned int addr)
+{
+    ostringstream hit;
+    hit << (type == '2' ? "watch" : type == '3' ? "rwatch" : "awatch") << ":" << hex << addr << ";";
+    gdbWatchHit = hit.str();
+    gdbAttention = true;
+}
+
+string reverseCommand(const string &packet);
+void reverseDiscardFuture();
+
+// reports a stop (unless signal is 0, for the first connection) and serves gdb until it resumes the program
+void gdbStop(int signal, const string &info)
+{
+    string packet;
+    if (!gdbAttached)
+        return;
+    cout.flush();
+    if (signal != 0)
+        gdbSend("T" + gdbHex(signal, 1) + info);
+
+    while (gdbReceive(packet))
+    {
+        char command = packet.empty() ? 0 : packet[0];
+        size_t pos = 1;
+        string reply;
+
+        switch (command)
+        {
+        case '?':
+            reply = "S05";
+            break;
+        case 'g':
+            for (int r = 0; r < 32; r++)
+                reply += gdbHex(reg[r], 4);
+            reply += gdbHex(pc, 4);
+            break;
+        case 'G':
+            for (int r = 1; r <= 32 && pos + 8 * r + 8 <= packet.size(); r++)
+                (r == 32 ? pc : reg[r]) = gdbParseLE(packet, pos + 8 * r);
+            reverseDiscardFuture();
+            reply = "OK";
+            break;
+        case 'p':
+        {
+            unsigned int r = gdbParseHex(packet, pos);
+            reply = r < 32 ? gdbHex(reg[r], 4) : r == 32 ? gdbHex(pc, 4) : "E01";
+            break;
+        }
+        case 'P':
+        {
+            unsigned int r = gdbParseHex(packet, pos);
+            if (r > 32)
+            {
+                reply = "E01";
+                break;
+            }
+            unsigned int value = gdbParseLE(packet, pos + 1);
+            if (r == 32)
+                pc = value;
+            else if (r != 0)
+                reg[r] = value;
+            reverseDiscardFuture();
+            reply = "OK";
+            break;
+        }
+        case 'm':
+        case 'M':
+        {
+            unsigned int addr = gdbParseHex(packet, pos);
+            unsigned int length = gdbParseHex(packet, ++pos);
+            if (!ramRange(addr, length))
+            {
+                reply = "E14"; // EFAULT: only RAM, reading the CLINT has no side effects worth showing
+                break;
+            }
+            for (unsigned int i = 0; i < length; i++)
+            {
+                if (command == 'm')
+                    reply += gdbHex(memory[addr + i], 1);
+                else
+                    memory[addr + i] = gdbByte(packet, pos + 1 + 2 * i);
+            }
+            if (command == 'M')
+            {
+                reverseDiscardFuture();
+                reply = "OK";
+            }
+            break;
+        }
+        case 'Z':
+        case 'z':
+        {
+            char type = packet.size() > 1 ? packet[1] : 0;
+            pos = 3;
+            unsigned int addr = gdbParseHex(packet, pos);
+            unsigned int length = gdbParseHex(packet, ++pos);
+            if (type < '0' || type > '4')
+                break; // unsupported kinds get an empty reply
+            reply = gdbSetPoint(type, addr, length, command == 'Z') ? "OK" : "E01";
+            break;
+        }
+        case 'c':
+        case 's':
+            if (pos < packet.size())
+            {
+                pc = gdbParseHex(packet, pos);
+                reverseDiscardFuture();
+            }
+            gdbStepping = command == 's';
+            gdbAttention = gdbStepping;
+            gdbResumeCount = instCount;
+            return;
+        case 'b':
+            if (!reverseEnabled || (packet != "bs" && packet != "bc"))
+                break;
+            if (gdbFaulting)
+            {
+                // the faulting instruction has to be abandoned first, the main loop goes back
+                gdbReverse = packet;
+                gdbAttention = true;
+                return;
+            }
+            reply = "T" + gdbHex(GDB_SIGTRAP, 1) + reverseCommand(packet);
+            break;
+        case 'D':
+            gdbSend("OK");
+            gdbDetach();
+            return;
+        case 'k':
+            gdbDetach();
+            endSimulation(0);
+        case 'H':
+            reply = "OK";
+            break;
+        case 'q':
+            if (packet.compare(0, 10, "qSupported") == 0)
+            {
+                reply = "PacketSize=4000;qXfer:features:read+;swbreak+";
+                if (reverseEnabled)
+                    reply += ";ReverseStep+;ReverseContinue+";
+            }
+            else if (packet == "qAttached")
+                reply = "1";
+            else if (packet == "qC")
+                reply = "QC1";
+            else if (packet == "qfThreadInfo")
+                reply = "m1";
+            else if (packet == "qsThreadInfo")
+                reply = "l";
+            else if (packet.compare(0, 31, "qXfer:features:read:target.xml:") == 0)
+            {
+                string xml = gdbTargetDescription();
+                pos = 31;
+                unsigned int offset = gdbParseHex(packet, pos);
+                unsigned int length = gdbParseHex(packet, ++pos);
+                if (offset >= xml.size())
+                    reply = "l";
+                else
+                    reply = (offset + length >= xml.size() ? "l" : "m") + xml.substr(offset, length);
+            }
+            break;
+        case 'T':
+            reply = "OK"; // the only thread is alive
+            break;
+        }
+        gdbSend(reply);
+    }
+
+    // gdb closed the connection: run on without it
+    gdbDetach();
+}
+
+// called before each instruction while gdb is attached
+void gdbCheck()
+{
+    if (!gdbReverse.empty())
+    {
+        string packet = gdbReverse;
+        gdbReverse.clear();
+        gdbAttention = gdbStepping;
+        gdbStop(GDB_SIGTRAP, reverseCommand(packet));
+        return;
+    }
+    if (gdbPollCountdown == 0)
+    {
+        gdbPollCountdown = GDB_POLL_INTERVAL;
+        if (gdbInterruptPending())
+        {
+            gdbStop(GDB_SIGINT, "");
+            return;
+        }
+    }
+    if (gdbSignal != 0)
+    {
+        int signal = gdbSignal;
+        gdbSignal = 0;
+        gdbAttention = gdbStepping;
+        gdbStop(signal, "");
+    }
+    else if (!gdbWatchHit.empty())
+    {
+        string hit = gdbWatchHit;
+        gdbWatchHit.clear();
+        gdbAttention = gdbStepping;
+        gdbStop(GDB_SIGTRAP, hit);
+    }
+    else if (gdbStepping && instCount != gdbResumeCount)
+        gdbStop(GDB_SIGTRAP, "");
+    else if (pc < MEMORY_SIZE && gdbBreakpoint[pc >> 1] && instCount != gdbResumeCount)
+        gdbStop(GDB_SIGTRAP, "swbreak:;");
+}
+
+// exceptions without a trap handler: EBREAK and illegal instructions stop before the next instruction, an access
+// fault (which ends the simulation) stops at the faulting instruction. True if gdb goes backwards from there
+// instead, so the instruction is abandoned.
+bool gdbException(unsigned int cause)
+{
+    if (!gdbAttached)
+        return false;
+    if (cause == 2 || cause == 3)
+    {
+        gdbSignal = cause == 2 ? GDB_SIGILL : GDB_SIGTRAP;
+        gdbAttention = true;
+        return false;
+    }
+    pc = currentPC;
+    gdbFaulting = true;
+    gdbStop(GDB_SIGSEGV, "");
+    gdbFaulting = false;
+    return !gdbReverse.empty();
+}
+
+// breakpoints, watchpoints and single steps must see every instruction, so nothing may be skipped
+bool watching()
+{
+    return !watchpoints.empty() || (gdbAttached && (gdbBreakpointCount != 0 || gdbStepping));
+}
+
+// tells gdb the program has ended
+void gdbExit(int status)
+{
+    if (!gdbAttached)
+        return;
+    gdbSend("W" + gdbHex(status & 0xFF, 1));
+    gdbDetach();
+}
+
+// Reverse execution (--reverse): the whole machine state is saved every reverseInterval instructions. Going
+// back restores the last checkpoint before the target and runs forward to it, with the trace and guest output
+// suppressed and ECALL results taken from the log. When the checkpoints outgrow --reverse-memory, every
+// other one is dropped and the interval doubles, so the history always reaches back to the start.
+const unsigned long long REVERSE_INTERVAL = 1 << 16;
+
+struct ReverseCheckpoint
+{
+    unsigned long long at;
+    unsigned int pc;
+    unsigned int reg[32];
+    unsigned int csr[11];
+    unsigned long long mtimecmp, mtimeOffset, cycleOffset, instretOffset, nextEventAt, externalReads;
+    unsigned int heapEnd;
+    vector<unsigned char> memory;
+    vector<unsigned char> vreg;
+};
+
+unsigned long long reverseInterval = REVERSE_INTERVAL;
+unsigned long long reverseMemory = 64 << 20; // bytes for checkpoints, set in MB with --reverse-memory
+unsigned long long reverseCheckpointAt = ~0ULL;
+vector<ReverseCheckpoint> reverseCheckpoints;
+unsigned long long reverseHitAt = ~0ULL; // the last breakpoint or watchpoint stop found by reverseReplay
+string reverseHit;
+bool lastWriteEnabled = false; // --last-write
+unsigned int lastWriteAddr = 0;
+
+bool simulateStep();
+
+// without memory for librvsim.cpp, whose machines each have their own
+void captureState(ReverseCheckpoint &c, bool withMemory = true)
+{
+    c.at = instCount;
+    c.pc = pc;
+    memcpy(c.reg, reg, sizeof(reg));
+    idleCsrs(c.csr);
+    c.mtimecmp = mtimecmp;
+    c.mtimeOffset = mtimeOffset;
+    c.cycleOffset = cycleOffset;
+    c.instretOffset = instretOffset;
+    c.nextEventAt = nextEventAt;
+    c.externalReads = externalReads;
+    c.heapEnd = heapEnd;
+    if (withMemory)
+        c.memory.assign(memory, memory + MEMORY_SIZE);
+    c.vreg.assign(vreg, vreg + sizeof(vreg));
+}
+
+void restoreState(const ReverseCheckpoint &c)
+{
+    instCount = c.at;
+    pc = currentPC = c.pc;
+    memcpy(reg, c.reg, sizeof(reg));
+    mstatus = c.csr[0];
+    mie = c.csr[1];
+    mtvec = c.csr[2];
+    mscratch = c.csr[3];
+    mepc = c.csr[4];
+    mcause = c.csr[5];
+    mtval = c.csr[6];
+    msip = c.csr[7];
+    vl = c.csr[8];
+    vtype = c.csr[9];
+    vstart = c.csr[10];
+    mtimecmp = c.mtimecmp;
+    mtimeOffset = c.mtimeOffset;
+    cycleOffset = c.cycleOffset;
+    instretOffset = c.instretOffset;
+    nextEventAt = c.nextEventAt;
+    externalReads = c.externalReads;
+    heapEnd = c.heapEnd;
+    if (!c.memory.empty())
+        memcpy(memory, &c.memory[0], MEMORY_SIZE);
+    memcpy(vreg, &c.vreg[0], sizeof(vreg));
+    idleSnapshot.valid = false;
+}
+
+void reverseCheckpoint()
+{
+    // after going backwards the checkpoints up to where the program had got to are already there
+    if (!reverseCheckpoints.empty() && reverseCheckpoints.back().at >= instCount)
+    {
+        reverseCheckpointAt = reverseCheckpoints.back().at + reverseInterval;
+        return;
+    }
+
+    reverseCheckpoints.push_back(ReverseCheckpoint());
+    captureState(reverseCheckpoints.back());
+
+    if (reverseCheckpoints.size() > 2 && reverseCheckpoints.size() * (MEMORY_SIZE + sizeof(vreg)) > reverseMemory)
+    {
+        unsigned int kept = 0;
+        for (unsigned int i = 0; i < reverseCheckpoints.size(); i += 2)
+            swap(reverseCheckpoints[kept++], reverseCheckpoints[i]);
+        reverseCheckpoints.resize(kept);
+        reverseInterval *= 2;
+    }
+    reverseCheckpointAt = instCount + reverseInterval;
+}
+
+void reverseRestore(const ReverseCheckpoint &c)
+{
+    restoreState(c);
+    gdbWatchHit.clear();
+    gdbSignal = 0;
+    reverseCheckpointAt = reverseCheckpoints.back().at + reverseInterval;
+}
+
+// runs forward until instCount reaches limit; with scan set, the last breakpoint (before the instruction) or
+// watchpoint hit (before the instruction that made the access) on the way goes to reverseHitAt/reverseHit
+void reverseReplay(unsigned long long limit, bool scan)
+{
+    ios::iostate traceState = cout.rdstate();
+    bool stats = statsEnabled, idioms = idiomEnabled, idle = idleDetect;
+    cout.setstate(ios::badbit);
+    guestOut.setstate(ios::badbit);
+    statsEnabled = idiomEnabled = idleDetect = false; // every instruction is interpreted, stops fall on the right one
+    reverseReplaying = true;
+
+    while (instCount < limit)
+    {
+        if (scan && gdbBreakpointCount != 0 && pc < MEMORY_SIZE && gdbBreakpoint[pc >> 1])
+        {
+            reverseHitAt = instCount;
+            reverseHit = "swbreak:;";
+        }
+        if (!simulateStep())
+            break;
+        if (!gdbWatchHit.empty())
+        {
+            if (scan)
+            {
+                reverseHitAt = instCount - 1;
+                reverseHit = gdbWatchHit;
+            }
+            gdbWatchHit.clear();
+        }
+    }
+
+    reverseReplaying = false;
+    gdbSignal = 0;
+    gdbAttention = gdbStepping;
+    cout.clear(traceState);
+    guestOut.clear();
+    statsEnabled = stats;
+    idiomEnabled = idioms;
+    idleDetect = idle;
+}
+
+// restores the state after the first count instructions
+void reverseGoTo(unsigned long long count)
+{
+    unsigned int i = reverseCheckpoints.size() - 1;
+    while (i > 0 && reverseCheckpoints[i].at > count)
+        i--;
+    reverseRestore(reverseCheckpoints[i]);
+    reverseReplay(count, false);
+}
+
+// goes back to the last breakpoint or watchpoint hit, or to the start of the history; false if there was none
+bool reverseSearch()
+{
+    unsigned long long limit = instCount;
+    for (int i = reverseCheckpoints.size() - 1; i >= 0; i--)
+    {
+        if (reverseCheckpoints[i].at >= limit)
+            continue;
+        reverseHitAt = ~0ULL;
+        reverseRestore(reverseCheckpoints[i]);
+        reverseReplay(limit, true);
+        if (reverseHitAt != ~0ULL)
+        {
+            string hit = reverseHit;
+            reverseGoTo(reverseHitAt);
+            reverseHit = hit;
+            return true;
+        }
+        limit = reverseCheckpoints[i].at;
+    }
+    reverseRestore(reverseCheckpoints[0]);
+    return false;
+}
+
+// gdb's bs and bc packets; returns the reason for the stop reply
+string reverseCommand(const string &packet)
+{
+    if (packet == "bs" && instCount > reverseCheckpoints[0].at)
+    {
+        reverseGoTo(instCount - 1);
+        return "";
+    }
+    if (packet == "bc" && reverseSearch())
+        return reverseHit;
+    return "replaylog:begin;";
+}
+
+// gdb changed registers, memory or the pc: what was recorded after this point cannot happen any more
+void reverseDiscardFuture()
 {
-    cout << s;
-    exit(0);
+    if (!reverseEnabled)
+        return;
+    while (!reverseCheckpoints.empty() && reverseCheckpoints.back().at >= instCount)
+        reverseCheckpoints.pop_back();
+    hostCalls.erase(hostCalls.upper_bound(instCount), hostCalls.end());
+    reverseCheckpoint();
 }
 
-void printPrefix(unsigned int instA, unsigned int instW)
+// --last-write: when the program ends, goes back to the last store to the address and shows it
+void lastWriteReport()
 {
-    cout << "0x" << hex << std::setfill('0') << std::setw(8) << instA << "\t0x" << std::setw(8) << instW;
+    if (!lastWriteEnabled)
+        return;
+    vector<Watchpoint> watches = watchpoints;
+    unsigned int breakpoints = gdbBreakpointCount;
+    watchpoints.assign(1, Watchpoint{'2', lastWriteAddr, 1, false});
+    watchUpdatePages();
+    gdbBreakpointCount = 0;
+
+    // the last instruction may be the one that ended the program, so it is not run again
+    if (instCount > 0)
+        instCount--;
+    if (reverseSearch())
+    {
+        cout << "\nLast write to 0x" << hex << lastWriteAddr << ": instruction " << dec << instCount + 1 << " at pc = 0x"
+             << hex << pc << "\n";
+        watchpoints.clear();
+        watchUpdatePages();
+        simulateStep(); // its trace line
+    }
+    else
+        cout << "\nNo write to 0x" << hex << lastWriteAddr << " since the program started\n";
+
+    watchpoints = watches;
+    watchUpdatePages();
+    gdbBreakpointCount = breakpoints;
 }
 
-void printRegisterValues()
+// Ahead-of-time translation (rvaot.cpp): a translated program is built as "#define RVSIM_AOT", this file, and a
+// function per block of its text, which aotRegister() files under the block's address. simulateStep runs such
+// a block in one call while nothing needs to see single instructions (no trace, --stats, --profile, --hle,
+// watchpoints, gdb or reverse history). A block first compares its code with memory, so code the program has
+// changed is interpreted, as is code the translation did not find.
+enum AotResult
 {
-    cout << "\n\nRegister Values:\n";
-    for (int i = 0; i < 32; i++)
-        cout << name[i] << " = 0x" << hex << reg[i] << endl;
+    AOT_STOP, // the simulation has to stop
+    AOT_CONTINUE,
+    AOT_CHANGED // the code is not the translated one; nothing was run
+};
+
+typedef int (*AotBlock)();
+vector<AotBlock> aotBlocks; // by pc / 2
+bool aotActive = false;
+unsigned long long aotInstructions = 0; // run in translated blocks
+
+#ifdef RVSIM_AOT
+void aotRegister();
+#endif
+
+// with --timing, how much of the run the translation covered
+void aotReport()
+{
+    if (!aotActive || !timingEnabled)
+        return;
+    cout << "  " << dec << aotInstructions << " instructions (" << fixed << setprecision(1)
+         << (instCount > 0 ? 100.0 * aotInstructions / instCount : 0.0) << "%) in translated blocks\n";
+    cout.unsetf(ios::floatfield);
+}
 
-    cout << "pc = 0x" << hex << pc << endl;
+// Differential co-simulation (--cosim): the program runs on the fast engine, with the tiers that are switched
+// on (--idioms, the SIMD vector kernels, idle fast-forward, translated code). Every cosimInterval
+// instructions the reference engine, the plain interpreter with the scalar vector code and no idle loop skipping
+// (WFI still waits for the timer, that is how time is kept), runs the same stretch again from the last state
+// both agreed on, with ECALL results taken from the log, and the hashes of the two states are compared. When
+// they differ, both engines are re-run from the agreed state to bisect for the first instruction after which
+// they differ, and both states are shown.
+const unsigned long long COSIM_INTERVAL = 100000;
+enum CosimEngine
+{
+    COSIM_LIVE,
+    COSIM_FAST,
+    COSIM_REFERENCE
+};
+
+unsigned long long cosimInterval = COSIM_INTERVAL;
+unsigned long long cosimCheckAt = ~0ULL;
+unsigned long long cosimChecks = 0;
+ReverseCheckpoint cosimAgreed; // the last state both engines reached
+CosimEngine cosimRunning = COSIM_LIVE;
+
+// FNV-1a
+void hashBytes(unsigned long long &h, const void *data, size_t size)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * 1099511628211ULL;
 }
 
-void printMemoryValues()
+// pc, registers, CSRs, the break, memory and the vector registers
+unsigned long long stateHash(const ReverseCheckpoint &c, bool withPc)
 {
-    cout << "\n\n\n";
-    for (int i = 0; i < (16 + 64) * 1024; i++)
+    unsigned long long h = 14695981039346656037ULL;
+    if (withPc)
+        hashBytes(h, &c.pc, sizeof(c.pc));
+    hashBytes(h, c.reg + 1, sizeof(c.reg) - sizeof(c.reg[0])); // x0 may hold anything until the next step
+    hashBytes(h, c.csr, sizeof(c.csr));
+    hashBytes(h, &c.mtimecmp, sizeof(c.mtimecmp));
+    hashBytes(h, &c.heapEnd, sizeof(c.heapEnd));
+    hashBytes(h, &c.memory[0], c.memory.size());
+    hashBytes(h, &c.vreg[0], c.vreg.size());
+    return h;
+}
+
+// runs an engine from state until instCount reaches target (a loop run natively may go past it) and leaves the
+// state it got to in state; the trace, guest output and statistics are off
+void cosimRun(CosimEngine engine, ReverseCheckpoint &state, unsigned long long target)
+{
+    ios::iostate traceState = cout.rdstate();
+    bool stats = statsEnabled, idioms = idiomEnabled, aot = aotActive;
+    void (*kernel)(unsigned int, unsigned int, unsigned char *, const unsigned char *, const unsigned char *,
+                   unsigned int) = vecKernel;
+    cout.setstate(ios::badbit);
+    guestOut.setstate(ios::badbit);
+    statsEnabled = false;
+    if (engine == COSIM_REFERENCE)
     {
-        if (memory[i] != 0)
-            cout << "memory[" << i << "] = " << hex << (int)memory[i] << endl;
+        idiomEnabled = aotActive = false;
+        vecKernel = vecKernelScalar;
     }
-    cout << "\n\n\n";
+    reverseReplaying = true;
+    cosimRunning = engine;
+
+    restoreState(state);
+    while (instCount < target && simulateStep())
+        ;
+    captureState(state);
+
+    cosimRunning = COSIM_LIVE;
+    reverseReplaying = false;
+    cout.clear(traceState);
+    guestOut.clear();
+    statsEnabled = stats;
+    idiomEnabled = idioms;
+    aotActive = aot;
+    vecKernel = kernel;
+}
+
+// what differs between the state before the first differing instruction and the states each engine got to
+void cosimReport(const ReverseCheckpoint &before, const ReverseCheckpoint &fast, const ReverseCheckpoint &reference)
+{
+    static const char *csrNames[11] = {"mstatus", "mie", "mtvec", "mscratch", "mepc", "mcause", "mtval", "msip", "vl", "vtype", "vstart"};
+    restoreState(before);
+    cout.clear();
+    cout << "\nCo-simulation: the engines differ after instruction " << dec << before.at + 1 << " (pc = 0x" << hex
+         << before.pc;
+    if (before.pc <= MEMORY_SIZE - 4)
+    {
+        const char *base;
+        unsigned int word = memory[before.pc] | (memory[before.pc + 1] << 8);
+        cout << ": " << (((word & 0x3) != 0x3) ? rvcMnemonic(word, &base)
+                                               : baseMnemonic(word | (memory[before.pc + 2] << 16) | (memory[before.pc + 3] << 24)));
+    }
+    cout << ")\n";
+    if (fast.at != before.at + 1)
+        cout << "  the fast engine ran it in a loop run natively, up to instruction " << dec << fast.at << "\n";
+    if (reference.at != fast.at)
+        cout << "  the reference engine stopped at instruction " << dec << reference.at << "\n";
+
+    cout << "  " << left << setfill(' ') << setw(12) << "" << setw(12) << "fast" << "reference\n";
+    if (fast.pc != reference.pc)
+        cout << "  " << setw(12) << "pc" << hex << setw(12) << fast.pc << reference.pc << "\n";
+    for (int i = 1; i < 32; i++)
+        if (fast.reg[i] != reference.reg[i])
+            cout << "  " << setw(12) << name[i] << hex << setw(12) << fast.reg[i] << reference.reg[i] << "\n";
+    for (int i = 0; i < 11; i++)
+        if (fast.csr[i] != reference.csr[i])
+            cout << "  " << setw(12) << csrNames[i] << hex << setw(12) << fast.csr[i] << reference.csr[i] << "\n";
+    if (fast.mtimecmp != reference.mtimecmp)
+        cout << "  " << setw(12) << "mtimecmp" << hex << setw(12) << fast.mtimecmp << reference.mtimecmp << "\n";
+    if (fast.heapEnd != reference.heapEnd)
+        cout << "  " << setw(12) << "break" << hex << setw(12) << fast.heapEnd << reference.heapEnd << "\n";
+
+    unsigned int shown = 0, bytes = 0;
+    for (unsigned int addr = 0; addr < MEMORY_SIZE; addr++)
+        if (fast.memory[addr] != reference.memory[addr] && bytes++ < 16)
+        {
+            ostringstream location;
+            location << "0x" << hex << addr;
+            cout << "  " << setw(12) << location.str() << hex << setw(12) << (unsigned int)fast.memory[addr]
+                 << (unsigned int)reference.memory[addr] << "\n";
+            shown++;
+        }
+    if (bytes > shown)
+        cout << "  ... and " << dec << bytes - shown << " more bytes of memory\n";
+    unsigned int vregBytes = 0;
+    for (unsigned int i = 0; i < fast.vreg.size(); i++)
+        vregBytes += fast.vreg[i] != reference.vreg[i];
+    if (vregBytes != 0)
+        cout << "  " << dec << vregBytes << " bytes of the vector registers\n";
+    cout << right;
+}
+
+// agreed is a state both engines reached; run from it, they got to the differing fast and reference states
+void cosimBisect(ReverseCheckpoint agreed, ReverseCheckpoint fast, ReverseCheckpoint reference)
+{
+    unsigned long long limit = fast.at; // runs to a target from limit on end past fast
+    while (limit - agreed.at > 1)
+    {
+        unsigned long long target = agreed.at + (limit - agreed.at) / 2;
+        ReverseCheckpoint midFast = agreed, midReference = agreed;
+        cosimRun(COSIM_FAST, midFast, target);
+        if (midFast.at >= fast.at)
+        {
+            limit = target; // a loop run natively from before target spans it
+            continue;
+        }
+        cosimRun(COSIM_REFERENCE, midReference, midFast.at);
+        if (midReference.at == midFast.at && stateHash(midFast, true) == stateHash(midReference, true))
+            swap(agreed, midFast);
+        else
+        {
+            swap(fast, midFast);
+            swap(reference, midReference);
+        }
+        if (agreed.at >= limit || fast.at < limit)
+            limit = fast.at;
+    }
+    cosimReport(agreed, fast, reference);
+}
+
+// called from the simulation loop every cosimInterval instructions
+void cosimCheck()
+{
+    ReverseCheckpoint fast, reference = cosimAgreed;
+    captureState(fast);
+    cosimRun(COSIM_REFERENCE, reference, fast.at);
+    cosimChecks++;
+    if (reference.at != fast.at || stateHash(fast, true) != stateHash(reference, true))
+    {
+        cosimBisect(cosimAgreed, fast, reference);
+        cosimEnabled = false;
+        endSimulation(1);
+    }
+
+    restoreState(fast);
+    swap(cosimAgreed, fast);
+    hostCalls.erase(hostCalls.begin(), hostCalls.upper_bound(cosimAgreed.at)); // never run again
+    cosimCheckAt = instCount + cosimInterval;
+}
+
+// at the end of the program the reference engine runs up to the instruction that ended it; the pc is left out
+// of the comparison as that instruction is not run. True if the engines differ.
+bool cosimFinish()
+{
+    if (cosimRunning != COSIM_LIVE)
+    {
+        cout << "\nCo-simulation: the " << (cosimRunning == COSIM_FAST ? "fast" : "reference")
+             << " engine ended the program at instruction " << dec << instCount << " (pc = 0x" << hex << currentPC
+             << ") where the other had not\n";
+        cout.flush();
+        exit(1);
+    }
+    if (!cosimEnabled)
+        return false;
+    cosimEnabled = false;
+
+    ReverseCheckpoint fast, reference = cosimAgreed;
+    captureState(fast);
+    unsigned long long last = fast.at > cosimAgreed.at ? fast.at - 1 : cosimAgreed.at;
+    cosimRun(COSIM_REFERENCE, reference, last);
+    cosimChecks++;
+    bool same = reference.at == last && stateHash(fast, false) == stateHash(reference, false);
+    if (same)
+        cout << "\nCo-simulation: " << dec << cosimChecks << " checks, the engines agree (state hash 0x" << hex
+             << stateHash(fast, true) << ")\n";
+    else
+    {
+        // the fast engine's state before the last instruction, to bisect with
+        ReverseCheckpoint before = cosimAgreed;
+        if (last > cosimAgreed.at)
+            cosimRun(COSIM_FAST, before, last);
+        cosimBisect(cosimAgreed, before.at == reference.at ? before : fast, reference);
+    }
+    restoreState(fast);
+    return !same;
 }
 
 unsigned int decompress(unsigned int instWord)
@@ -140,7 +5161,6 @@ unsigned int decompress(unsigned int instWord)
         CB_Imm = CB_Imm | 0b0000000000000;
     }
 
-    int MSF;
     printPrefix(instPC, instWord);
     unsigned int instWord_Decompressed = 0;
 
@@ -183,6 +5203,11 @@ unsigned int decompress(unsigned int instWord)
 
                 return instWord_Decompressed;
             }
+            else if (rd == 0 && rs2 == 0)
+            {
+                // C.EBREAK -----> EBREAK
+                return 0x00100073;
+            }
             break;
         }
 
@@ -257,11 +5282,11 @@ unsigned int decompress(unsigned int instWord)
         case 0x2: // C.LWSP
         {
             unsigned int CILW_imm = instWord >> 2;
-            CILW_imm = (CILW_imm & 0x0003);                    // 00076
-            CILW_imm = CILW_imm << 1;                          // 00760
-            CILW_imm = CILW_imm + ((instWord >> 11) & 0x0001); // 00765
-            CILW_imm = CILW_imm << 2;                          // 87600
-            CILW_imm = CILW_imm + ((instWord >> 4) & 0x0007);  // 87654
+            CILW_imm = (CILW_imm & 0x0003);                    // 76
+            CILW_imm = CILW_imm << 1;                          // 760
+            CILW_imm = CILW_imm + ((instWord >> 12) & 0x0001); // 765
+            CILW_imm = CILW_imm << 3;                          // 765000
+            CILW_imm = CILW_imm + ((instWord >> 4) & 0x0007);  // 765432
             CILW_imm = CILW_imm << 2;
 
             int I_rd = instWord >> 7;
@@ -301,11 +5326,6 @@ unsigned int decompress(unsigned int instWord)
             CSS_imm |= ((instWord >> 7) & 0b1) << 6;
             CSS_imm |= ((instWord >> 9) & 0b1111) << 2;
 
-            if (CSS_imm >> 7)
-                CSS_imm |= 0xFFFFFF00;
-            else
-                CSS_imm &= 0x000000FF;
-
             funct3 = ((instWord >> 13) & 0b111);
 
             instWord_Decompressed = (opcode & 0b1111111);
@@ -330,7 +5350,7 @@ unsigned int decompress(unsigned int instWord)
         case 0x0: // addi4spn
         {
             unsigned int CIW_Imm = 0;
-            CIW_Imm = ((instWord >> 7) & 0b0000000000000111);
+            CIW_Imm = ((instWord >> 7) & 0b0000000000001111);
 
             CIW_Imm = CIW_Imm << 2;
             CIW_Imm = CIW_Imm + ((instWord >> 11) & 0b0000000000000011);
@@ -362,28 +5382,16 @@ unsigned int decompress(unsigned int instWord)
         }
         case 0x6:
         {
-            // C.SW
-            MSF = ((instWord >> 5) & 0x00000001);
-
-            if (MSF == 1)
-            {
-
-                instWord_Decompressed = 0b1111111;
-            }
-
-            else if (MSF == 0)
-            {
-                instWord_Decompressed = 0b0000000;
-            }
-
-            instWord_Decompressed = instWord_Decompressed << 5;
-            instWord_Decompressed = instWord_Decompressed + rs1_dash;
+            // C.SW (the offset is unsigned; rs2' is the source, rs1' the base)
+            instWord_Decompressed = CS_imm >> 5;
             instWord_Decompressed = instWord_Decompressed << 5;
             instWord_Decompressed = instWord_Decompressed + rs2_dash;
+            instWord_Decompressed = instWord_Decompressed << 5;
+            instWord_Decompressed = instWord_Decompressed + rs1_dash;
             instWord_Decompressed = instWord_Decompressed << 3;
             instWord_Decompressed = instWord_Decompressed + 0b010;
             instWord_Decompressed = instWord_Decompressed << 5;
-            instWord_Decompressed = instWord_Decompressed + CS_imm;
+            instWord_Decompressed = instWord_Decompressed + (CS_imm & 0x1F);
             instWord_Decompressed = instWord_Decompressed << 7;
             instWord_Decompressed = instWord_Decompressed + 0b0100011;
 
@@ -393,19 +5401,8 @@ unsigned int decompress(unsigned int instWord)
 
         case 0x2:
         {
-            // C.LW
-            MSF = ((instWord >> 5) & 0x00000001);
-
-            if (MSF == 1)
-            {
-                instWord_Decompressed = 0b1111111;
-            }
-
-            else if (MSF == 0)
-            {
-                instWord_Decompressed = 0b0000000;
-            }
-            instWord_Decompressed = instWord_Decompressed + CL_imm;
+            // C.LW (the offset is unsigned)
+            instWord_Decompressed = CL_imm;
             instWord_Decompressed = instWord_Decompressed << 5;
             instWord_Decompressed = instWord_Decompressed + rs1_dash;
             instWord_Decompressed = instWord_Decompressed << 3;
@@ -557,7 +5554,7 @@ unsigned int decompress(unsigned int instWord)
                 funct3 = 0x5;
                 rd = ((instWord >> 7) & 0b111);
                 rd += 8;
-                CS_imm_v2 = ((instWord >> 2) & 0b1111);
+                CS_imm_v2 = ((instWord >> 2) & 0b11111);
 
                 instWord_Decompressed = (CS_imm_v2 << 20);
                 instWord_Decompressed |= (rd << 15);
@@ -571,10 +5568,10 @@ unsigned int decompress(unsigned int instWord)
                 // C.ANDI
                 CS_imm_v2 = ((instWord >> 12) & 0b1) << 5;
                 CS_imm_v2 |= ((instWord >> 2) & 0b11111);
+                if (CS_imm_v2 & 0x20)
+                    CS_imm_v2 |= 0xFC0;
 
-                instWord_Decompressed = 0b0000000;
-                instWord_Decompressed = (instWord_Decompressed << 5);
-                instWord_Decompressed = instWord_Decompressed + CS_imm_v2;
+                instWord_Decompressed = CS_imm_v2;
                 instWord_Decompressed = (instWord_Decompressed << 5);
                 instWord_Decompressed = instWord_Decompressed + rs1_dash;
                 instWord_Decompressed = (instWord_Decompressed << 3);
@@ -591,7 +5588,7 @@ unsigned int decompress(unsigned int instWord)
             opcode = 0x13;
             funct3 = 0x5;
             rd = ((instWord >> 7) & 0x001F);
-            instWord_Decompressed = CI_imm << 20;
+            instWord_Decompressed = ((instWord >> 2) & 0b11111) << 20;
             instWord_Decompressed = instWord_Decompressed + (rd << 15);
             instWord_Decompressed = instWord_Decompressed + (funct3 << 12);
             instWord_Decompressed = instWord_Decompressed + (rd << 7);
@@ -831,6 +5828,53 @@ unsigned int decompress(unsigned int instWord)
     return instWord_Decompressed;
 }
 
+// the sign-extended immediates of the five 32-bit formats; an instruction uses at most one of them
+void extractImmediates(unsigned int instWord, unsigned int &I_imm, unsigned int &S_imm, unsigned int &B_imm,
+                       unsigned int &U_imm, unsigned int &J_imm)
+{
+    // Extract I-Immediate
+    I_imm = ((instWord >> 20) & 0x7FF) | (((instWord >> 31) ? 0xFFFFF800 : 0x0));
+
+    // Extract S-Immediate
+    S_imm = (instWord >> 25);
+    S_imm <<= 5;
+    S_imm |= ((instWord >> 7) & 0b11111);
+
+    if (S_imm >> 11)
+        S_imm |= 0xFFFFF000;
+
+    // Extract B-Immediate
+    B_imm = ((instWord >> 31) << 12);
+    B_imm |= ((instWord & 0x80) << 4);
+    B_imm |= ((instWord & 0x7E000000) >> 20);
+    B_imm |= ((instWord & 0xF00) >> 7);
+    if (B_imm >> 12)
+        B_imm |= 0xFFFFF000;
+
+    // Extract U-Immediate
+    U_imm = (instWord >> 12);
+    U_imm = (U_imm << 12);
+
+    // Extract J-Immediate
+    J_imm = ((instWord >> 31) << 20);
+    J_imm |= (instWord & 0xFF000);
+    J_imm |= ((instWord & 0x100000) >> 9);
+    J_imm |= (((instWord & 0x7FE00000) >> 21) << 1);
+    if (J_imm >> 20)
+        J_imm |= 0xFFE00000;
+}
+
+// Edge coverage for rvfuzz.cpp: every branch, JAL and JALR counts its (pc, next pc) pair in one of
+// EDGE_COUNTERS 8-bit counters, hashed as AFL does. The counters are the fuzzer's; NULL otherwise.
+const unsigned int EDGE_COUNTERS = 1 << 16;
+unsigned char *edgeCounters = NULL;
+
+inline void edgeHit(unsigned int from, unsigned int to)
+{
+    if (edgeCounters != NULL)
+        edgeCounters[((from >> 1) * 0x9E3779B1u ^ (to >> 1)) & (EDGE_COUNTERS - 1)]++;
+}
+
 void instDecExec(unsigned int instWord, bool isCompressed)
 {
 
@@ -859,50 +5903,206 @@ void instDecExec(unsigned int instWord, bool isCompressed)
     rs2 = ((instWord >> 20) & 0x0000001F);
     funct7 = ((instWord >> 25) & 0x0000007F);
 
-    // reset
-    I_imm = 0;
-    S_imm = 0;
-    B_imm = 0;
-    U_imm = 0;
-    J_imm = 0;
+    extractImmediates(instWord, I_imm, S_imm, B_imm, U_imm, J_imm);
 
-    // Extract I-Immediate
-    I_imm = ((instWord >> 20) & 0x7FF) | (((instWord >> 31) ? 0xFFFFF800 : 0x0));
+    if (!isCompressed)
+    {
+        printPrefix(instPC, instWord);
+    }
 
-    // Extract S-Immediate
-    S_imm = (instWord >> 25);
-    S_imm <<= 5;
-    S_imm |= ((instWord >> 7) & 0b11111);
+    if (opcode == 0x33 && funct7 == 0x01)
+    {
+        // M instructions
+        unsigned int a = reg[rs1];
+        unsigned int b = reg[rs2];
+        static const char *mNames[8] = {"MUL", "MULH", "MULHSU", "MULHU", "DIV", "DIVU", "REM", "REMU"};
 
-    if (S_imm >> 11)
-        S_imm |= 0xFFFFF000;
+        if (!mExtension)
+        {
+            illegalInstruction("\tUnkown R Instruction \n", instWord, instPC);
+        }
+        else
+        {
+            cout << "\t" << mNames[funct3] << "\t" << name[rd] << ", " << name[rs1] << ", " << name[rs2] << "\n";
 
-    // Extract B-Immediate
-    B_imm = ((instWord >> 31) << 12);
-    B_imm |= ((instWord & 0x80) << 4);
-    B_imm |= ((instWord & 0x7E000000) >> 20);
-    B_imm |= ((instWord & 0xF00) >> 7);
-    if (B_imm >> 12)
-        B_imm |= 0xFFFFF000;
+            switch (funct3)
+            {
+            case 0x0:
+                // 39.MUL
+                reg[rd] = a * b;
+                break;
+            case 0x1:
+                // 40.MULH
+                reg[rd] = (unsigned int)(((long long)(int)a * (long long)(int)b) >> 32);
+                break;
+            case 0x2:
+                // 41.MULHSU
+                reg[rd] = (unsigned int)(((long long)(int)a * (long long)b) >> 32);
+                break;
+            case 0x3:
+                // 42.MULHU
+                reg[rd] = (unsigned int)(((unsigned long long)a * b) >> 32);
+                break;
+            case 0x4:
+                // 43.DIV: x / 0 = -1, INT_MIN / -1 = INT_MIN
+                if (b == 0)
+                    reg[rd] = 0xFFFFFFFF;
+                else if (a == 0x80000000 && b == 0xFFFFFFFF)
+                    reg[rd] = 0x80000000;
+                else
+                    reg[rd] = (int)a / (int)b;
+                break;
+            case 0x5:
+                // 44.DIVU
+                reg[rd] = (b == 0) ? 0xFFFFFFFF : a / b;
+                break;
+            case 0x6:
+                // 45.REM: x % 0 = x, INT_MIN % -1 = 0
+                if (b == 0)
+                    reg[rd] = a;
+                else if (a == 0x80000000 && b == 0xFFFFFFFF)
+                    reg[rd] = 0;
+                else
+                    reg[rd] = (int)a % (int)b;
+                break;
+            case 0x7:
+                // 46.REMU
+                reg[rd] = (b == 0) ? a : a % b;
+                break;
+            }
+        }
+    }
 
-    // Extract U-Immediate
-    U_imm = (instWord >> 12);
-    U_imm = (U_imm << 12);
+    else if (bitmanipEncoding(instWord))
+    {
+        // Zba/Zbb instructions, executed with the host's bit-counting builtins
+        unsigned int a = reg[rs1];
+        unsigned int b = (opcode == 0x33) ? reg[rs2] : rs2; // rs2 holds the shift amount of RORI
 
-    // Extract J-Immediate
-    J_imm = ((instWord >> 31) << 20);
-    J_imm |= (instWord & 0xFF000);
-    J_imm |= ((instWord & 0x100000) >> 9);
-    J_imm |= (((instWord & 0x7FE00000) >> 21) << 1);
-    if (J_imm >> 20)
-        J_imm |= 0xFFE00000;
+        if (!zbExtension)
+        {
+            illegalInstruction((opcode == 0x33) ? "\tUnkown R Instruction \n" : "\tUnkown I Instruction \n", instWord, instPC);
+        }
+        else
+        {
+            const char *m = bitmanipMnemonic(instWord);
+            if (opcode == 0x33 && strcmp(m, "ZEXT.H") != 0)
+                cout << "\t" << m << "\t" << name[rd] << ", " << name[rs1] << ", " << name[rs2] << "\n";
+            else if (strcmp(m, "RORI") == 0)
+                cout << "\t" << m << "\t" << name[rd] << ", " << name[rs1] << ", " << dec << rs2 << "\n";
+            else
+                cout << "\t" << m << "\t" << name[rd] << ", " << name[rs1] << "\n";
 
-    if (!isCompressed)
+            if (opcode == 0x33)
+            {
+                switch ((funct7 << 3) | funct3)
+                {
+                case (0x10 << 3) | 0x2:
+                    // 51.SH1ADD
+                    reg[rd] = b + (a << 1);
+                    break;
+                case (0x10 << 3) | 0x4:
+                    // 52.SH2ADD
+                    reg[rd] = b + (a << 2);
+                    break;
+                case (0x10 << 3) | 0x6:
+                    // 53.SH3ADD
+                    reg[rd] = b + (a << 3);
+                    break;
+                case (0x20 << 3) | 0x7:
+                    // 54.ANDN
+                    reg[rd] = a & ~b;
+                    break;
+                case (0x20 << 3) | 0x6:
+                    // 55.ORN
+                    reg[rd] = a | ~b;
+                    break;
+                case (0x20 << 3) | 0x4:
+                    // 56.XNOR
+                    reg[rd] = ~(a ^ b);
+                    break;
+                case (0x05 << 3) | 0x4:
+                    // 57.MIN
+                    reg[rd] = ((int)a < (int)b) ? a : b;
+                    break;
+                case (0x05 << 3) | 0x5:
+                    // 58.MINU
+                    reg[rd] = (a < b) ? a : b;
+                    break;
+                case (0x05 << 3) | 0x6:
+                    // 59.MAX
+                    reg[rd] = ((int)a > (int)b) ? a : b;
+                    break;
+                case (0x05 << 3) | 0x7:
+                    // 60.MAXU
+                    reg[rd] = (a > b) ? a : b;
+                    break;
+                case (0x30 << 3) | 0x1:
+                    // 61.ROL
+                    reg[rd] = (a << (b & 31)) | (a >> ((32 - (b & 31)) & 31));
+                    break;
+                case (0x30 << 3) | 0x5:
+                    // 62.ROR
+                    reg[rd] = (a >> (b & 31)) | (a << ((32 - (b & 31)) & 31));
+                    break;
+                case (0x04 << 3) | 0x4:
+                    // 63.ZEXT.H
+                    reg[rd] = a & 0xFFFF;
+                    break;
+                }
+            }
+            else if (funct3 == 0x1)
+            {
+                switch (instWord >> 20)
+                {
+                case 0x600:
+                    // 64.CLZ
+                    reg[rd] = (a == 0) ? 32 : __builtin_clz(a);
+                    break;
+                case 0x601:
+                    // 65.CTZ
+                    reg[rd] = (a == 0) ? 32 : __builtin_ctz(a);
+                    break;
+                case 0x602:
+                    // 66.CPOP
+                    reg[rd] = __builtin_popcount(a);
+                    break;
+                case 0x604:
+                    // 67.SEXT.B
+                    reg[rd] = (int)(signed char)a;
+                    break;
+                case 0x605:
+                    // 68.SEXT.H
+                    reg[rd] = (int)(short)a;
+                    break;
+                }
+            }
+            else if (funct7 == 0x30)
+            {
+                // 69.RORI
+                reg[rd] = (a >> b) | (a << ((32 - b) & 31));
+            }
+            else if ((instWord >> 20) == 0x287)
+            {
+                // 70.ORC.B: every non-zero byte becomes 0xFF
+                unsigned int x = ((a & 0x7F7F7F7F) + 0x7F7F7F7F) | a;
+                reg[rd] = ((x >> 7) & 0x01010101) * 0xFF;
+            }
+            else
+            {
+                // 71.REV8
+                reg[rd] = __builtin_bswap32(a);
+            }
+        }
+    }
+
+    else if (opcode == 0x57 || opcode == 0x07 || opcode == 0x27)
     {
-        printPrefix(instPC, instWord);
+        // V instructions
+        vectorExec(instWord, instPC);
     }
 
-    if (opcode == 0x33)
+    else if (opcode == 0x33)
     { // R Instructions
 
         switch (funct3)
@@ -1086,14 +6286,14 @@ void instDecExec(unsigned int instWord, bool isCompressed)
         }
 
         default:
-            cout << "\tUnkown R Instruction \n";
+            illegalInstruction("\tUnkown R Instruction \n", instWord, instPC);
         }
     }
 
     else if (opcode == 0x3B)
     {
         // R instructions
-        cout << "\tUnkown R Instruction \n";
+        illegalInstruction("\tUnkown R Instruction \n", instWord, instPC);
     }
 
     else if (opcode == 0x13)
@@ -1264,7 +6464,7 @@ void instDecExec(unsigned int instWord, bool isCompressed)
         }
 
         default:
-            cout << "\tUnkown I Instruction \n";
+            illegalInstruction("\tUnkown I Instruction \n", instWord, instPC);
         }
     }
 
@@ -1277,7 +6477,10 @@ void instDecExec(unsigned int instWord, bool isCompressed)
         {
             // 20.lb
             cout << "\tLB\t" << name[rd] << ", " << dec << (int)I_imm << "(" << name[rs1] << ")\n";
-            reg[rd] = memory[reg[rs1] + (int)I_imm];
+            unsigned int data = memRead(reg[rs1] + (int)I_imm, 1);
+            if (memFault)
+                break;
+            reg[rd] = data;
 
             // sign extension
             if (reg[rd] & 0x00000080)
@@ -1302,8 +6505,9 @@ void instDecExec(unsigned int instWord, bool isCompressed)
             unsigned int data;
             temp = reg[rs1] + (int)I_imm;
 
-            data = memory[temp];
-            data |= (memory[temp + 1] << 8);
+            data = memRead(temp, 2);
+            if (memFault)
+                break;
 
             reg[rd] = data;
 
@@ -1345,10 +6549,9 @@ void instDecExec(unsigned int instWord, bool isCompressed)
 
             temp = reg[rs1] + (int)I_imm;
 
-            data = memory[temp];
-            data |= (memory[temp + 1] << 8);
-            data |= (memory[temp + 2] << 16);
-            data |= (memory[temp + 3] << 24);
+            data = memRead(temp, 4);
+            if (memFault)
+                break;
 
             reg[rd] = data;
 
@@ -1358,8 +6561,10 @@ void instDecExec(unsigned int instWord, bool isCompressed)
         {
             // 23.lbu
             cout << "\tLBU\t" << name[rd] << ", " << dec << (int)I_imm << "(" << name[rs1] << ")\n";
-            reg[rd] = memory[reg[rs1] + (int)I_imm];
-            reg[rd] &= 0x000000FF;
+            unsigned int data = memRead(reg[rs1] + (int)I_imm, 1);
+            if (memFault)
+                break;
+            reg[rd] = data & 0x000000FF;
             break;
         }
         case 0x5:
@@ -1371,47 +6576,157 @@ void instDecExec(unsigned int instWord, bool isCompressed)
             unsigned int temp;
             temp = reg[rs1] + (int)I_imm;
 
-            data = memory[temp];
-            data |= (memory[temp + 1] << 8);
+            data = memRead(temp, 2);
+            if (memFault)
+                break;
             data &= 0x0000FFFF;
 
-            reg[rd] = data;
+            reg[rd] = data;
+
+            break;
+        }
+
+        default:
+            illegalInstruction("\tUnkown I Instruction \n", instWord, instPC);
+        }
+    }
+
+    else if (opcode == 0x73 && funct3 != 0x0)
+    {
+        // Zicsr: the rs1 field holds a 5-bit immediate for the I forms
+        static const char *csrOps[8] = {NULL, "CSRRW", "CSRRS", "CSRRC", NULL, "CSRRWI", "CSRRSI", "CSRRCI"};
+        unsigned int csr = instWord >> 20;
+        unsigned int src = (funct3 & 0x4) ? rs1 : reg[rs1];
+        unsigned int value = 0;
+
+        if (csrOps[funct3] == NULL)
+        {
+            illegalInstruction("\tUnkown I Instruction \n", instWord, instPC);
+        }
+        else
+        {
+            cout << "\t" << csrOps[funct3] << "\t" << name[rd] << ", ";
+            if (csrName(csr) != NULL)
+                cout << csrName(csr);
+            else
+                cout << "0x" << hex << csr;
+            if (funct3 & 0x4)
+                cout << ", " << dec << rs1 << "\n";
+            else
+                cout << ", " << name[rs1] << "\n";
+
+            // CSRRS/CSRRC with x0 (or 0) only read
+            bool writes = ((funct3 & 0x3) == 0x1) || (rs1 != 0);
+
+            if (!csrRead(csr, value))
+            {
+                illegalInstruction("\tIllegal CSR access\n", instWord, instPC);
+            }
+            else
+            {
+                unsigned int newValue = src;
+                if ((funct3 & 0x3) == 0x2)
+                    newValue = value | src;
+                else if ((funct3 & 0x3) == 0x3)
+                    newValue = value & ~src;
+
+                if (writes && !csrWrite(csr, newValue))
+                    illegalInstruction("\tIllegal CSR access\n", instWord, instPC);
+                else
+                    reg[rd] = value;
+            }
+        }
+    }
+
+    else if (opcode == 0x73 && (instWord >> 20) == 0x001)
+    {
+        // 48.EBREAK
+        if (isCompressed)
+            cout << "\tC.EBREAK\n";
+        else
+            cout << "\tEBREAK\n";
+
+        if (trapHandlerInstalled())
+            takeTrap(3, instPC, instPC);
+        else
+            gdbException(3);
+    }
+
+    else if (opcode == 0x73 && (instWord >> 20) == 0x302)
+    {
+        // 49.MRET
+        cout << "\tMRET\n";
+        pc = mepc;
+        mstatus = (mstatus & ~MSTATUS_MIE) | ((mstatus & MSTATUS_MPIE) ? MSTATUS_MIE : 0) | MSTATUS_MPIE;
+        updateNextEvent();
+    }
+
+    else if (opcode == 0x73 && (instWord >> 20) == 0x105)
+    {
+        // 50.WFI: waits for the timer if it is armed, otherwise a hint
+        cout << "\tWFI\n";
+        if (idleDetect)
+            wfiWait();
+    }
+
+    else if (opcode == 0x73 && (instWord >> 20) != 0x000)
+    {
+        illegalInstruction("\tUnkown I Instruction \n", instWord, instPC);
+    }
 
-            break;
-        }
-        }
+    else if (opcode == 0x73 && trapHandlerInstalled() && !isHostService(reg[17]))
+    {
+        // 25.ECALL into the guest's own trap handler
+        cout << "\tECALL\n";
+        takeTrap(11, 0, instPC);
     }
 
     else if (opcode == 0x73)
     {
         // 25.ECALL
         cout << "\tECALL\n";
-        if (reg[17] == 1) // if a7==1 print a0 integer
+        if (ecallHook != NULL && ecallHook())
         {
-            cout << dec << (int)reg[10] << endl;
+            cout << "\t-> handled by the host\n";
+        }
+        else if (replayHostCall())
+        {
+            cout << "\t-> replayed, results restored from the log\n";
+        }
+        else if (reg[17] == 1) // if a7==1 print a0 integer
+        {
+            guestOut << dec << (int)reg[10] << "\n";
+            externalReads++;
+            logHostCall(0, 0);
         }
         else if (reg[17] == 4)
         {
             // if a7==4 print a0 string
-            int i = 0;
+            unsigned int i = 0;
 
-            while (memory[reg[10] + i] != 0)
+            while (reg[10] + i < MEMORY_SIZE && memory[reg[10] + i] != 0)
             {
-                cout << (char)(memory[reg[10] + i]);
+                guestOut << (char)(memory[reg[10] + i]);
                 i++;
             }
-            cout << endl;
+            guestOut << "\n";
+            externalReads++;
+            logHostCall(0, 0);
         }
         else if (reg[17] == 10)
         {
-            exit(0);
+            endSimulation(0);
+        }
+        else
+        {
+            hostSyscall();
         }
     }
 
     else if (opcode == 0x0F)
     {
-        // I instructions
-        cout << "\tUnkown I Instruction \n";
+        // 47.FENCE: memory is always coherent in this simulator
+        cout << "\tFENCE\n";
     }
 
     else if (opcode == 0x23)
@@ -1430,7 +6745,7 @@ void instDecExec(unsigned int instWord, bool isCompressed)
                 S_imm |= 0b11111111111111111111100000000000;
             }
 
-            memory[reg[rs1] + (int)S_imm] = (reg[rs2] & 0x000000FF);
+            memWrite(reg[rs1] + (int)S_imm, 1, reg[rs2] & 0x000000FF);
 
             break;
         }
@@ -1448,8 +6763,7 @@ void instDecExec(unsigned int instWord, bool isCompressed)
             unsigned int temp = reg[rs1] + (int)S_imm;
             unsigned int data = reg[rs2];
 
-            memory[temp] = (data & 0x000000FF);
-            memory[temp + 1] = ((data >> 8) & 0x000000FF); // debugging: review
+            memWrite(temp, 2, data & 0x0000FFFF);
 
             break;
         }
@@ -1479,16 +6793,13 @@ void instDecExec(unsigned int instWord, bool isCompressed)
             unsigned int temp = reg[rs1] + int(S_imm);
             unsigned int data = reg[rs2];
 
-            memory[temp] = data & 0xFF;
-            memory[temp + 1] = (data >> 8) & 0xFF;
-            memory[temp + 2] = (data >> 16) & 0xFF;
-            memory[temp + 3] = (data >> 24) & 0xFF;
+            memWrite(temp, 4, data);
 
             break;
         }
 
         default:
-            cout << "\tUnknown S Instruction\n";
+            illegalInstruction("\tUnknown S Instruction\n", instWord, instPC);
         }
     }
 
@@ -1577,141 +6888,1340 @@ void instDecExec(unsigned int instWord, bool isCompressed)
             cout << "\tBLTU\t" << name[rs1] << ", " << name[rs2] << ", " << hex << "0x" << instPC + (int)B_imm << "\n";
             if (reg[rs1] < reg[rs2])
             {
-                pc = instPC + (int)B_imm;
-                // pc = pc & 0x00001fff; // debugging: review
+                pc = instPC + (int)B_imm;
+                // pc = pc & 0x00001fff; // debugging: review
+            }
+            break;
+        }
+        case 0x7:
+        {
+            // 34.BGEU
+            cout << "\tBGEU\t" << name[rs1] << ", " << name[rs2] << ", " << hex << "0x" << instPC + (int)B_imm << "\n";
+            if (reg[rs1] >= reg[rs2])
+            {
+                pc = instPC + (int)B_imm;
+                // pc = pc & 0x00001fff; // debugging: review
+            }
+            break;
+        }
+        default:
+            illegalInstruction("\tUnknown B Instruction\n", instWord, instPC);
+        }
+        edgeHit(instPC, pc);
+        if (coverageEnabled)
+            coverBranch(instPC, pc != instPC + (isCompressed ? 2 : 4));
+    }
+
+    else if (opcode == 0x37)
+    {
+        // 35.LUI
+        cout << "\tLUI\t" << name[rd] << ", " << hex << "0x" << ((int)U_imm >> 12) << "\n";
+        reg[rd] = (int)U_imm; // debugging: review
+    }
+
+    else if (opcode == 0x17)
+    {
+        // 26.AUIPC
+        cout << "\tAUIPC\t" << name[rd] << ", 0x" << hex << ((int)U_imm >> 12) << "\n";
+
+        // debugging: In case of uncompressed test case "t4", use this if block to change "sp" to a lower value to be further than the data section,
+        // becuase t4.bin's stack pointer overwrites the data section
+        // if (instCount == 0 && ((filename == "t4.bin")))
+        //     reg[rd] = 0x1000;
+        // else
+        reg[rd] = instPC + (int)U_imm;
+    }
+
+    else if (opcode == 0x6F)
+    {
+        // 37.JAL
+
+        if (isCompressed == 0)
+        {
+            cout << "\tJAL\t" << name[rd] << ", 0x" << hex << instPC + (int)J_imm << "\n";
+        }
+
+        else if (isCompressed == 1)
+        {
+
+            if (rd == 0)
+            {
+                cout << "\tC.J\t"
+                     << "0x" << hex << instPC + (int)J_imm << "\n";
+            }
+
+            else if (rd == 1)
+            {
+
+                cout << "\tC.JAL\t"
+                     << "0x" << hex << instPC + (int)J_imm << "\n";
+            }
+        }
+
+        if (isCompressed == 0)
+        {
+            reg[rd] = instPC + 4;
+        }
+
+        else if (isCompressed == 1)
+        {
+            reg[rd] = instPC + 2;
+        }
+
+        pc = instPC + (int)J_imm;
+        // pc = pc & 0b00000000000111111111111111111111; // debugging: review
+
+        edgeHit(instPC, pc);
+        if (profileEnabled)
+            profileJump(pc, rd, 0, instPC + (isCompressed ? 2 : 4));
+        if (hleEnabled)
+            hleCall();
+    }
+    else if (opcode == 0x67)
+    {
+        switch (funct3)
+        {
+        case 0x0:
+            // 38.JALR
+
+            if (isCompressed == 0)
+            {
+                cout << "\tJALR\t" << name[rd] << ", " << name[rs1] << ", " << hex << "0x" << (int)I_imm << "\n";
+            }
+            else if (isCompressed == 1)
+            {
+                if (rd == 0b00000)
+                {
+                    cout << "\tC.JR\t" << name[rs1] << "\n";
+                }
+                else if (rd == 0b00001)
+                {
+                    cout << "\tC.JALR\t" << name[rs1] << "\n";
+                }
+            }
+
+            // the target is read before the link is written: "jalr ra, ra, off" is how calls are made
+            pc = reg[rs1] + (int)I_imm;
+
+            if (isCompressed == 0)
+            {
+                reg[rd] = instPC + 4;
+            }
+
+            else if (isCompressed == 1)
+            {
+                reg[rd] = instPC + 2;
+            }
+
+            // pc = pc & 0b00000000000000000000111111111111; // debugging: review
+
+            edgeHit(instPC, pc);
+            if (profileEnabled)
+                profileJump(pc, rd, rs1, instPC + (isCompressed ? 2 : 4));
+            if (hleEnabled)
+                hleCall();
+
+            break;
+
+        default:
+            illegalInstruction("\tUnkown I Instruction \n", instWord, instPC);
+        }
+    }
+    else
+    {
+        illegalInstruction("\tUnkown Instruction Type \n", instWord, instPC);
+    }
+}
+
+// a little-endian instruction word; addr is at most MEMORY_SIZE - 4
+unsigned int fetchWord(unsigned int addr)
+{
+    return (unsigned char)memory[addr] |
+           (((unsigned char)memory[addr + 1]) << 8) |
+           (((unsigned char)memory[addr + 2]) << 16) |
+           (((unsigned char)memory[addr + 3]) << 24);
+}
+
+// Predecoded text (--quiet): the 32-bit form of each compressed instruction of the text image, by pc / 2, so
+// that decompress() runs once per instruction rather than once per step. An entry keeps the halfword it was
+// decoded from and is only used while memory still holds that halfword, so code the program changes is
+// decoded again. With --decode-cache <dir> the table is saved at the end, under a hash of the text image, and
+// mapped (copy-on-write) by the next run of the same text. Decoding depends only on the halfword, so a cache
+// file is valid for any text as long as it was written by the same simulator build and is intact.
+struct PredecodedInst
+{
+    unsigned int half; // 0 for an empty entry: a zero halfword stops the simulation before it is decoded
+    unsigned int word;
+};
+
+struct DecodeCacheHeader
+{
+    char magic[8];
+    unsigned long long build;     // hash of the simulator's build date and time
+    unsigned long long textHash;  // of the text image, as in the file name
+    unsigned long long tableHash; // of the entries
+    unsigned int entries;
+    unsigned int decoded; // entries that are not empty
+};
+
+const char DECODE_CACHE_MAGIC[8] = {'r', 'v', 's', 'i', 'm', 'd', 'c', '1'};
+
+PredecodedInst *predecoded = NULL; // predecodeEnd / 2 entries, or NULL when not in use
+vector<PredecodedInst> predecodedHeap;
+unsigned int predecodeEnd = 0;
+vector<unsigned char> textImage; // as loaded
+string decodeCacheDir, decodeCachePath;
+unsigned long long decodeCacheText = 0; // the hash of the text image
+unsigned int decodeCacheLoaded = 0; // entries mapped from the cache file
+unsigned int predecodeAdded = 0;    // entries decoded in this run
+
+unsigned long long decodeCacheBuild()
+{
+    unsigned long long h = 14695981039346656037ULL;
+    hashBytes(h, __DATE__ " " __TIME__, sizeof(__DATE__ " " __TIME__));
+    return h;
+}
+
+// the table for the text loaded at 0, from the cache if it has a valid one
+void predecodeInit(unsigned int textSize)
+{
+    predecodeEnd = min(textSize, (unsigned int)MEMORY_SIZE) & ~1u;
+    unsigned int entries = predecodeEnd / 2;
+    if (entries == 0)
+        return;
+    textImage.assign(memory, memory + predecodeEnd);
+
+    if (!decodeCacheDir.empty())
+    {
+        decodeCacheText = 14695981039346656037ULL;
+        hashBytes(decodeCacheText, memory, predecodeEnd);
+        ostringstream name;
+        name << decodeCacheDir << "/" << hex << setfill('0') << setw(16) << decodeCacheText << ".rvdc";
+        decodeCachePath = name.str();
+
+        size_t size = sizeof(DecodeCacheHeader) + entries * sizeof(PredecodedInst);
+        struct stat st;
+        int fd = open(decodeCachePath.c_str(), O_RDONLY);
+        if (fd >= 0 && fstat(fd, &st) == 0 && (size_t)st.st_size == size)
+        {
+            void *mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                DecodeCacheHeader *header = (DecodeCacheHeader *)mapped;
+                PredecodedInst *table = (PredecodedInst *)(header + 1);
+                unsigned long long tableHash = 14695981039346656037ULL;
+                hashBytes(tableHash, table, entries * sizeof(PredecodedInst));
+                if (memcmp(header->magic, DECODE_CACHE_MAGIC, sizeof(header->magic)) == 0 &&
+                    header->build == decodeCacheBuild() && header->textHash == decodeCacheText && header->entries == entries &&
+                    header->tableHash == tableHash)
+                {
+                    predecoded = table;
+                    decodeCacheLoaded = header->decoded;
+                }
+                else
+                    munmap(mapped, size); // stale or damaged: decoded again and rewritten at the end
+            }
+        }
+        if (fd >= 0)
+            close(fd);
+    }
+    if (predecoded == NULL)
+    {
+        predecodedHeap.assign(entries, PredecodedInst());
+        predecoded = &predecodedHeap[0];
+    }
+}
+
+// decompress() for the compressed instruction at currentPC
+unsigned int predecode(unsigned int half)
+{
+    if (predecoded == NULL || currentPC >= predecodeEnd)
+        return decompress(half);
+    PredecodedInst &p = predecoded[currentPC >> 1];
+    if (p.half != half)
+    {
+        p.half = half;
+        p.word = decompress(half);
+        predecodeAdded++;
+    }
+    return p.word;
+}
+
+// with --decode-cache, save the table if this run decoded more of the text than the cache had; with --timing,
+// how it went
+void decodeCacheFinish()
+{
+    if (decodeCachePath.empty())
+        return;
+
+    // only what was decoded from the text as loaded
+    unsigned int entries = predecodeEnd / 2, decoded = 0;
+    vector<PredecodedInst> table(predecoded, predecoded + entries);
+    for (unsigned int i = 0; i < entries; i++)
+    {
+        if (table[i].half != (unsigned int)(textImage[2 * i] | (textImage[2 * i + 1] << 8)))
+            table[i] = PredecodedInst();
+        else if (table[i].half != 0)
+            decoded++;
+    }
+    bool save = decoded > decodeCacheLoaded;
+    if (save)
+    {
+        DecodeCacheHeader header;
+        memcpy(header.magic, DECODE_CACHE_MAGIC, sizeof(header.magic));
+        header.build = decodeCacheBuild();
+        header.textHash = decodeCacheText;
+        header.tableHash = 14695981039346656037ULL;
+        hashBytes(header.tableHash, &table[0], entries * sizeof(PredecodedInst));
+        header.entries = entries;
+        header.decoded = decoded;
+
+        // written next to the old file and renamed, so a parallel run maps either the old or the new one
+        mkdir(decodeCacheDir.c_str(), 0777);
+        ostringstream temp;
+        temp << decodeCachePath << "." << dec << getpid();
+        ofstream out(temp.str().c_str(), ios::out | ios::binary | ios::trunc);
+        out.write((const char *)&header, sizeof(header));
+        out.write((const char *)&table[0], entries * sizeof(PredecodedInst));
+        out.close();
+        if (!out || rename(temp.str().c_str(), decodeCachePath.c_str()) != 0)
+        {
+            unlink(temp.str().c_str());
+            cout << "\nCannot write the decode cache " << decodeCachePath << "\n";
+            return;
+        }
+    }
+    if (timingEnabled)
+    {
+        cout << "  decode cache " << decodeCachePath << ": " << dec << decodeCacheLoaded << " instructions loaded, "
+             << predecodeAdded << " decoded";
+        if (save)
+            cout << ", " << decoded << " saved";
+        cout << "\n";
+    }
+}
+
+// The --coverage file: a header, the text image the bitmaps were recorded for and the two bitmaps. A run ORs
+// its bitmaps into the file under an exclusive lock, so batch runs and the job server's workers can all add to
+// one file.
+const char COVERAGE_MAGIC[8] = {'R', 'V', 'C', 'O', 'V', '1', 0, 0};
+
+struct CoverageHeader
+{
+    char magic[8];
+    unsigned long long textHash;
+    unsigned int textSize;
+    unsigned int runs;
+};
+
+string coverageFile;
+vector<unsigned char> coverageText; // as loaded, before the program could change it
+
+void coverageFinish()
+{
+    if (!coverageEnabled)
+        return;
+    coverageEnabled = false; // saved once
+
+    CoverageHeader h;
+    memcpy(h.magic, COVERAGE_MAGIC, 8);
+    h.textHash = 14695981039346656037ULL;
+    hashBytes(h.textHash, coverageText.data(), coverageText.size());
+    h.textSize = coverageText.size();
+    h.runs = 1;
+
+    int fd = open(coverageFile.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX) < 0)
+    {
+        cout << "\nCoverage: cannot open " << coverageFile << "\n";
+        if (fd >= 0)
+            close(fd);
+        return;
+    }
+    CoverageHeader old;
+    ssize_t n = pread(fd, &old, sizeof(old), 0);
+    if (n > 0 && (n != sizeof(old) || memcmp(old.magic, COVERAGE_MAGIC, 8) != 0 || old.textHash != h.textHash))
+    {
+        cout << "\nCoverage: " << coverageFile << " holds the coverage of another program; not saved\n";
+        close(fd);
+        return;
+    }
+    if (n == sizeof(old))
+    {
+        unsigned char blocks[sizeof(coverBlocks)], branches[sizeof(coverBranches)];
+        if (pread(fd, blocks, sizeof(blocks), sizeof(h) + h.textSize) == sizeof(blocks) &&
+            pread(fd, branches, sizeof(branches), sizeof(h) + h.textSize + sizeof(blocks)) == sizeof(branches))
+        {
+            for (unsigned int i = 0; i < sizeof(blocks); i++)
+                coverBlocks[i] |= blocks[i];
+            for (unsigned int i = 0; i < sizeof(branches); i++)
+                coverBranches[i] |= branches[i];
+            h.runs = old.runs + 1;
+        }
+    }
+
+    bool saved = pwrite(fd, &h, sizeof(h), 0) == sizeof(h) &&
+                 pwrite(fd, coverageText.data(), h.textSize, sizeof(h)) == (ssize_t)h.textSize &&
+                 pwrite(fd, coverBlocks, sizeof(coverBlocks), sizeof(h) + h.textSize) == sizeof(coverBlocks) &&
+                 pwrite(fd, coverBranches, sizeof(coverBranches), sizeof(h) + h.textSize + sizeof(coverBlocks)) ==
+                     sizeof(coverBranches);
+    close(fd);
+
+    unsigned int blocks = 0;
+    for (unsigned int i = 0; i < sizeof(coverBlocks); i++)
+        blocks += bitset<8>(coverBlocks[i]).count();
+    if (saved)
+        cout << "\nCoverage: " << dec << blocks << " block starts after " << h.runs << " runs, saved to "
+             << coverageFile << "\n";
+    else
+        cout << "\nCoverage: cannot write " << coverageFile << "\n";
+}
+
+// an instruction of the text at addr, 16-bit ones expanded; 0 past the end
+unsigned int coverageInstruction(const vector<unsigned char> &text, unsigned int addr, unsigned int &length)
+{
+    length = 2;
+    if (addr + 2 > text.size())
+        return 0;
+    unsigned int half = text[addr] | (text[addr + 1] << 8);
+    if ((half & 0x3) != 0x3)
+        return half == 0 ? 0 : decompress(half);
+    length = 4;
+    if (addr + 4 > text.size())
+        return 0;
+    return half | (text[addr + 2] << 16) | (text[addr + 3] << 24);
+}
+
+// The instructions that ran: from every block start on to the end of its block, a jump, an MRET, an ECALL, an
+// EBREAK or a branch that was only taken. A block left at a fault with no trap handler counts as run to its end.
+vector<bool> coverageExpand(const vector<unsigned char> &text, const unsigned char *blocks,
+                            const unsigned char *branches)
+{
+    vector<bool> ran(text.size() / 2 + 1, false);
+    for (unsigned int start = 0; start < text.size(); start += 2)
+    {
+        if (!((blocks[start >> 4] >> ((start >> 1) & 7)) & 1) && start != 0)
+            continue;
+        unsigned int addr = start, length;
+        while (addr < text.size() && !ran[addr >> 1])
+        {
+            unsigned int word = coverageInstruction(text, addr, length);
+            if (word == 0)
+                break;
+            ran[addr >> 1] = true;
+            unsigned int opcode = word & 0x7F;
+            unsigned int directions = (branches[addr >> 3] >> (((addr >> 1) & 3) * 2)) & 3;
+            if (opcode == 0x6F || opcode == 0x67 || word == 0x30200073 || word == 0x00000073 || word == 0x00100073 ||
+                (opcode == 0x63 && !(directions & 2)))
+                break;
+            addr += length;
+        }
+    }
+    return ran;
+}
+
+// a section of a 32-bit little-endian ELF image; false when it has none by that name
+bool elfSection(const vector<unsigned char> &elf, const char *name, unsigned int &offset, unsigned int &size)
+{
+    if (elf.size() < 52)
+        return false;
+    unsigned int names = elfSectionHeader(elf, readLE(elf, 0x32, 2));
+    if (names == 0)
+        return false;
+    unsigned int namesOff = readLE(elf, names + 16, 4);
+    unsigned int namesSize = readLE(elf, names + 20, 4);
+    unsigned int shnum = readLE(elf, 0x30, 2);
+    for (unsigned int i = 0; i < shnum; i++)
+    {
+        unsigned int sh = elfSectionHeader(elf, i);
+        const char *sectionName = sh == 0 ? NULL : elfString(elf, namesOff, namesSize, readLE(elf, sh, 4));
+        if (sectionName == NULL || strcmp(sectionName, name) != 0)
+            continue;
+        offset = readLE(elf, sh + 16, 4);
+        size = readLE(elf, sh + 20, 4);
+        return elfRange(elf, offset, size);
+    }
+    return false;
+}
+
+// DWARF line tables (.debug_line, versions 2 to 5): the source line of each address range
+struct LineRange
+{
+    unsigned int start, end;
+    string file;
+    unsigned int line;
+};
+
+struct DwarfReader
+{
+    const vector<unsigned char> &data;
+    unsigned long long pos, end;
+    bool ok;
+
+    DwarfReader(const vector<unsigned char> &d, unsigned long long p, unsigned long long e) : data(d), pos(p), end(e), ok(true)
+    {
+    }
+    unsigned long long fixed(int bytes)
+    {
+        if (pos + bytes > end)
+        {
+            ok = false;
+            pos = end;
+            return 0;
+        }
+        unsigned long long value = 0;
+        for (int i = bytes - 1; i >= 0; i--)
+            value = (value << 8) | data[pos + i];
+        pos += bytes;
+        return value;
+    }
+    unsigned long long uleb()
+    {
+        unsigned long long value = 0;
+        for (int shift = 0; pos < end; shift += 7)
+        {
+            unsigned char b = data[pos++];
+            if (shift < 64)
+                value |= (unsigned long long)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return value;
+        }
+        ok = false;
+        return value;
+    }
+    long long sleb()
+    {
+        long long value = 0;
+        int shift = 0;
+        unsigned char b = 0x80;
+        while (pos < end && (b & 0x80))
+        {
+            b = data[pos++];
+            if (shift < 64)
+                value |= (long long)(b & 0x7F) << shift;
+            shift += 7;
+        }
+        if (shift < 64 && (b & 0x40))
+            value |= -(1LL << shift);
+        return value;
+    }
+    string str()
+    {
+        string s;
+        while (pos < end && data[pos] != 0)
+            s += (char)data[pos++];
+        if (pos >= end)
+            ok = false;
+        pos++;
+        return s;
+    }
+};
+
+// one directory or file entry of a DWARF 5 header: the path and the directory index
+void dwarfEntry(DwarfReader &r, const vector<pair<unsigned long long, unsigned long long>> &format, bool dwarf64,
+                const vector<unsigned char> &elf, unsigned int lineStrOff, unsigned int lineStrSize,
+                unsigned int strOff, unsigned int strSize, string &path, unsigned long long &dir)
+{
+    for (unsigned int i = 0; i < format.size(); i++)
+    {
+        unsigned long long content = format[i].first, form = format[i].second, value = 0;
+        string text;
+        switch (form)
+        {
+        case 0x08: // DW_FORM_string
+            text = r.str();
+            break;
+        case 0x1F: // DW_FORM_line_strp
+        case 0x0E: // DW_FORM_strp
+        {
+            value = r.fixed(dwarf64 ? 8 : 4);
+            unsigned int off = form == 0x1F ? lineStrOff : strOff, size = form == 0x1F ? lineStrSize : strSize;
+            const char *s = elfString(elf, off, size, value);
+            if (s != NULL)
+                text = s;
+            break;
+        }
+        case 0x0B: value = r.fixed(1); break; // DW_FORM_data1
+        case 0x05: value = r.fixed(2); break; // DW_FORM_data2
+        case 0x06: value = r.fixed(4); break; // DW_FORM_data4
+        case 0x07: value = r.fixed(8); break; // DW_FORM_data8
+        case 0x0F: value = r.uleb(); break;   // DW_FORM_udata
+        case 0x1E: r.pos += 16; break;        // DW_FORM_data16 (the MD5)
+        case 0x09: r.pos += r.uleb(); break;  // DW_FORM_block
+        default:
+            r.ok = false;
+            return;
+        }
+        if (content == 1) // DW_LNCT_path
+            path = text;
+        else if (content == 2) // DW_LNCT_directory_index
+            dir = value;
+    }
+}
+
+bool dwarfLines(const vector<unsigned char> &elf, vector<LineRange> &ranges)
+{
+    unsigned int off, size, lineStrOff = 0, lineStrSize = 0, strOff = 0, strSize = 0;
+    if (!elfSection(elf, ".debug_line", off, size))
+        return false;
+    elfSection(elf, ".debug_line_str", lineStrOff, lineStrSize);
+    elfSection(elf, ".debug_str", strOff, strSize);
+
+    for (unsigned long long unit = off; unit + 4 <= off + size;)
+    {
+        DwarfReader r(elf, unit, off + size);
+        unsigned long long length = r.fixed(4);
+        bool dwarf64 = length == 0xFFFFFFFF;
+        if (dwarf64)
+            length = r.fixed(8);
+        unsigned long long unitEnd = r.pos + length;
+        if (!r.ok || unitEnd > off + size)
+            return !ranges.empty();
+        r.end = unitEnd;
+        unit = unitEnd;
+
+        unsigned int version = r.fixed(2);
+        if (version < 2 || version > 5)
+            continue;
+        if (version >= 5)
+            r.fixed(2); // address and segment selector sizes
+        unsigned long long headerLength = r.fixed(dwarf64 ? 8 : 4);
+        unsigned long long program = r.pos + headerLength;
+        unsigned int minLength = r.fixed(1);
+        if (version >= 4)
+            r.fixed(1); // maximum operations per instruction: 1 outside VLIW
+        bool defaultStmt = r.fixed(1) != 0;
+        int lineBase = (signed char)r.fixed(1);
+        unsigned int lineRange = r.fixed(1);
+        unsigned int opcodeBase = r.fixed(1);
+        vector<unsigned int> opcodeLengths(opcodeBase > 0 ? opcodeBase - 1 : 0);
+        for (unsigned int i = 0; i < opcodeLengths.size(); i++)
+            opcodeLengths[i] = r.fixed(1);
+        if (lineRange == 0)
+            continue;
+
+        // the files by index: from 1 before version 5, from 0 since
+        vector<string> dirs, files;
+        if (version < 5)
+        {
+            dirs.push_back("");
+            for (string d = r.str(); r.ok && !d.empty(); d = r.str())
+                dirs.push_back(d);
+            files.push_back("");
+            for (string f = r.str(); r.ok && !f.empty(); f = r.str())
+            {
+                unsigned long long dir = r.uleb();
+                r.uleb(); // modification time
+                r.uleb(); // length
+                files.push_back(f[0] != '/' && dir < dirs.size() && !dirs[dir].empty() ? dirs[dir] + "/" + f : f);
             }
-            break;
         }
-        case 0x7:
+        else
         {
-            // 34.BGEU
-            cout << "\tBGEU\t" << name[rs1] << ", " << name[rs2] << ", " << hex << "0x" << instPC + (int)B_imm << "\n";
-            if (reg[rs1] >= reg[rs2])
+            for (int list = 0; list < 2 && r.ok; list++)
             {
-                pc = instPC + (int)B_imm;
-                // pc = pc & 0x00001fff; // debugging: review
+                vector<pair<unsigned long long, unsigned long long>> format(r.fixed(1));
+                for (unsigned int i = 0; i < format.size(); i++)
+                {
+                    format[i].first = r.uleb();
+                    format[i].second = r.uleb();
+                }
+                unsigned long long count = r.uleb();
+                for (unsigned long long i = 0; i < count && r.ok; i++)
+                {
+                    string path;
+                    unsigned long long dir = 0;
+                    dwarfEntry(r, format, dwarf64, elf, lineStrOff, lineStrSize, strOff, strSize, path, dir);
+                    // directory 0 is the compilation's; the others may be relative to it
+                    if (list == 0)
+                        dirs.push_back(!dirs.empty() && !path.empty() && path[0] != '/' ? dirs[0] + "/" + path : path);
+                    else
+                        files.push_back(path[0] != '/' && dir < dirs.size() && !dirs[dir].empty() ? dirs[dir] + "/" + path
+                                                                                                 : path);
+                }
             }
-            break;
         }
-        default:
-            cout << "\tUnknown B Instruction\n";
+        if (!r.ok)
+            continue;
+
+        // the line number program; each row's range ends at the next row of its sequence
+        r.pos = program;
+        unsigned long long address = 0, file = 1, line = 1;
+        bool stmt = defaultStmt;
+        vector<LineRange> sequence;
+        while (r.pos < r.end && r.ok)
+        {
+            unsigned int op = r.fixed(1);
+            bool row = false, endSequence = false;
+            if (op >= opcodeBase)
+            {
+                unsigned int adjusted = op - opcodeBase;
+                address += (adjusted / lineRange) * minLength;
+                line += lineBase + (int)(adjusted % lineRange);
+                row = true;
+            }
+            else if (op == 0)
+            {
+                unsigned long long length = r.uleb();
+                unsigned long long next = r.pos + length;
+                unsigned int sub = length > 0 ? r.fixed(1) : 0;
+                if (sub == 1) // DW_LNE_end_sequence
+                    row = endSequence = true;
+                else if (sub == 2) // DW_LNE_set_address
+                    address = r.fixed(length - 1);
+                r.pos = next;
+            }
+            else if (op == 1) // DW_LNS_copy
+                row = true;
+            else if (op == 2) // DW_LNS_advance_pc
+                address += r.uleb() * minLength;
+            else if (op == 3) // DW_LNS_advance_line
+                line += r.sleb();
+            else if (op == 4) // DW_LNS_set_file
+                file = r.uleb();
+            else if (op == 6) // DW_LNS_negate_stmt
+                stmt = !stmt;
+            else if (op == 8) // DW_LNS_const_add_pc
+                address += ((255 - opcodeBase) / lineRange) * minLength;
+            else if (op == 9) // DW_LNS_fixed_advance_pc
+                address += r.fixed(2);
+            else
+                for (unsigned int i = 0; i < opcodeLengths[op - 1]; i++)
+                    r.uleb(); // set_column, set_isa and the ones that only mark
+
+            if (!row)
+                continue;
+            if (!sequence.empty())
+                sequence.back().end = address;
+            if (endSequence)
+            {
+                for (unsigned int i = 0; i < sequence.size(); i++)
+                    if (sequence[i].end > sequence[i].start)
+                        ranges.push_back(sequence[i]);
+                sequence.clear();
+                address = 0, file = 1, line = 1;
+                stmt = defaultStmt;
+            }
+            else
+                sequence.push_back({(unsigned int)address, (unsigned int)address, file < files.size() ? files[file] : "",
+                                    (unsigned int)line});
         }
     }
+    sort(ranges.begin(), ranges.end(), [](const LineRange &a, const LineRange &b) { return a.start < b.start; });
+    return !ranges.empty();
+}
 
-    else if (opcode == 0x37)
-    {
-        // 35.LUI
-        cout << "\tLUI\t" << name[rd] << ", " << hex << "0x" << ((int)U_imm >> 12) << "\n";
-        reg[rd] = (int)U_imm; // debugging: review
-    }
+struct LineCoverage
+{
+    bool ran = false;
+    vector<pair<bool, unsigned int>> branches; // the branch ran, and its direction bits
+};
 
-    else if (opcode == 0x17)
+// rvsim.exe --coverage-report <file> <out> [--elf <file>]: lcov from the ELF's line table, or else the
+// disassembly with what ran marked
+void coverageReport(const char *in, const char *out)
+{
+    ifstream file(in, ios::in | ios::binary);
+    CoverageHeader h;
+    if (!file.read((char *)&h, sizeof(h)) || memcmp(h.magic, COVERAGE_MAGIC, 8) != 0)
+        emitError("Not a --coverage file\n");
+    if (h.textSize > MEMORY_SIZE) // the bitmaps cover RAM only
+        emitError("The --coverage file is damaged: its text is larger than RAM\n");
+    vector<unsigned char> text(h.textSize);
+    unsigned char blocks[sizeof(coverBlocks)], branches[sizeof(coverBranches)];
+    if (!file.read((char *)text.data(), text.size()) || !file.read((char *)blocks, sizeof(blocks)) ||
+        !file.read((char *)branches, sizeof(branches)))
+        emitError("The --coverage file is cut short\n");
+    cout.setstate(ios::badbit); // decompress() traces
+    vector<bool> ran = coverageExpand(text, blocks, branches);
+
+    ofstream report(out);
+    if (!report.is_open())
+        emitError("Cannot write the coverage report\n");
+
+    vector<unsigned char> elf;
+    vector<LineRange> ranges;
+    if (!symbolsFile.empty())
     {
-        // 26.AUIPC
-        cout << "\tAUIPC\t" << name[rd] << ", 0x" << hex << ((int)U_imm >> 12) << "\n";
-
-        // debugging: In case of uncompressed test case "t4", use this if block to change "sp" to a lower value to be further than the data section,
-        // becuase t4.bin's stack pointer overwrites the data section
-        // if (instCount == 0 && ((filename == "t4.bin")))
-        //     reg[rd] = 0x1000;
-        // else
-        reg[rd] = instPC + (int)U_imm;
+        ifstream elfFile(symbolsFile.c_str(), ios::in | ios::binary);
+        elf.assign(istreambuf_iterator<char>(elfFile), istreambuf_iterator<char>());
     }
 
-    else if (opcode == 0x6F)
+    unsigned int instructions = 0, run = 0, directions = 0, taken = 0;
+    if (dwarfLines(elf, ranges))
     {
-        // 37.JAL
-
-        if (isCompressed == 0)
+        // per source line: it ran if one of its instructions did; a branch's directions are two lcov branches
+        map<string, map<unsigned int, LineCoverage>> lines;
+        map<string, map<string, pair<unsigned int, bool>>> functions;
+        unsigned int length;
+        for (unsigned int addr = 0; addr < text.size(); addr += length)
         {
-            cout << "\tJAL\t" << name[rd] << ", 0x" << hex << instPC + (int)J_imm << "\n";
+            unsigned int word = coverageInstruction(text, addr, length);
+            vector<LineRange>::iterator it = upper_bound(
+                ranges.begin(), ranges.end(), addr, [](unsigned int a, const LineRange &r) { return a < r.start; });
+            if (word == 0 || it == ranges.begin() || addr >= (it - 1)->end)
+                continue;
+            --it;
+            LineCoverage &line = lines[it->file][it->line];
+            line.ran = line.ran || ran[addr >> 1];
+            if ((word & 0x7F) == 0x63)
+                line.branches.push_back({ran[addr >> 1], (branches[addr >> 3] >> (((addr >> 1) & 3) * 2)) & 3});
+            map<unsigned int, Symbol>::iterator symbol = symbols.find(addr);
+            if (symbol != symbols.end() && symbol->second.isFunction)
+                functions[it->file][symbol->second.name] = {it->line, ran[addr >> 1]};
         }
 
-        else if (isCompressed == 1)
+        for (map<string, map<unsigned int, LineCoverage>>::iterator f = lines.begin(); f != lines.end(); f++)
         {
-
-            if (rd == 0)
+            report << "TN:\nSF:" << f->first << "\n";
+            map<string, pair<unsigned int, bool>> &fns = functions[f->first];
+            unsigned int hit = 0;
+            for (map<string, pair<unsigned int, bool>>::iterator fn = fns.begin(); fn != fns.end(); fn++)
+                report << "FN:" << fn->second.first << "," << fn->first << "\n";
+            for (map<string, pair<unsigned int, bool>>::iterator fn = fns.begin(); fn != fns.end(); fn++)
             {
-                cout << "\tC.J\t"
-                     << "0x" << hex << instPC + (int)J_imm << "\n";
+                report << "FNDA:" << fn->second.second << "," << fn->first << "\n";
+                hit += fn->second.second;
             }
+            report << "FNF:" << fns.size() << "\nFNH:" << hit << "\n";
 
-            else if (rd == 1)
-            {
+            unsigned int found = 0;
+            hit = 0;
+            for (map<unsigned int, LineCoverage>::iterator l = f->second.begin(); l != f->second.end(); l++)
+                for (unsigned int b = 0; b < l->second.branches.size(); b++)
+                    for (unsigned int d = 0; d < 2; d++)
+                    {
+                        bool went = (l->second.branches[b].second >> d) & 1;
+                        report << "BRDA:" << l->first << "," << b << "," << d << ","
+                               << (l->second.branches[b].first ? (went ? "1" : "0") : "-") << "\n";
+                        found++;
+                        hit += went;
+                    }
+            report << "BRF:" << found << "\nBRH:" << hit << "\n";
+            directions += found;
+            taken += hit;
 
-                cout << "\tC.JAL\t"
-                     << "0x" << hex << instPC + (int)J_imm << "\n";
+            hit = 0;
+            for (map<unsigned int, LineCoverage>::iterator l = f->second.begin(); l != f->second.end(); l++)
+            {
+                report << "DA:" << l->first << "," << l->second.ran << "\n";
+                hit += l->second.ran;
             }
+            report << "LF:" << f->second.size() << "\nLH:" << hit << "\nend_of_record\n";
+            instructions += f->second.size();
+            run += hit;
         }
+        cout.clear();
+        cout << dec << "lcov of " << lines.size() << " source files written to " << out << ": " << run << " of "
+             << instructions << " lines and " << taken << " of " << directions << " branch directions ran, in "
+             << h.runs << " runs\n";
+        return;
+    }
 
-        if (isCompressed == 0)
+    // without line information: each instruction with + (ran) or - (did not), and T and N for the directions
+    // a branch took
+    stringstream listing;
+    unsigned int length;
+    for (unsigned int addr = 0; addr < text.size(); addr += length)
+    {
+        unsigned int word = coverageInstruction(text, addr, length);
+        if (addr + length > text.size())
+            break; // an odd byte or half an instruction at the end of the text
+        map<unsigned int, Symbol>::iterator symbol = symbols.find(addr);
+        if (symbol != symbols.end())
+            listing << symbol->second.name << ":\n";
+        unsigned int raw = text[addr] | (text[addr + 1] << 8);
+        if (length == 4)
+            raw |= (text[addr + 2] << 16) | (text[addr + 3] << 24);
+        const char *base = "";
+        const char *mnemonic = length == 2 ? rvcMnemonic(raw, &base) : baseMnemonic(raw);
+        listing << "  " << (ran[addr >> 1] ? '+' : '-') << " " << hex << setfill('0') << setw(8) << addr << "  "
+                << setw(length * 2) << raw << setfill(' ') << setw(12 - length * 2) << "" << (raw == 0 ? "" : mnemonic);
+        if ((word & 0x7F) == 0x63 && word != 0)
         {
-            reg[rd] = instPC + 4;
+            unsigned int bits = (branches[addr >> 3] >> (((addr >> 1) & 3) * 2)) & 3;
+            listing << setw(12 - strlen(mnemonic)) << "" << ((bits & 1) ? "T " : "  ") << ((bits & 2) ? "N" : " ");
+            directions += 2;
+            taken += bitset<2>(bits).count();
         }
+        listing << dec << "\n";
+        instructions += word != 0;
+        run += word != 0 && ran[addr >> 1];
+    }
+    report << "# coverage of a " << h.textSize << "-byte text after " << h.runs << " runs: " << run << " of "
+           << instructions << " instructions ran, and " << taken << " of " << directions << " branch directions\n"
+           << "# + ran, - did not; T a branch was taken, N it was not\n"
+           << listing.str();
+    cout.clear();
+    cout << dec << "Annotated disassembly written to " << out << " (no line information: give the ELF with --elf): " << run
+         << " of " << instructions << " instructions and " << taken << " of " << directions
+         << " branch directions ran, in " << h.runs << " runs\n";
+}
 
-        else if (isCompressed == 1)
-        {
-            reg[rd] = instPC + 2;
-        }
+// what follows an instruction: HLE checks, loop idioms, idle loops and interrupts; false when the simulation
+// has to stop
+bool stepEnd(unsigned int fallThrough)
+{
+    if (hleVerifyPending)
+    {
+        hleMinSp = min(hleMinSp, reg[2]);
+        if (pc == hleReturn && reg[2] == hleSp)
+            hleCheck();
+    }
 
-        pc = instPC + (int)J_imm;
-        // pc = pc & 0b00000000000111111111111111111111; // debugging: review
+    // a taken backward branch may close a loop that can run natively
+    if (idiomEnabled && pc < currentPC && !watching() && conditionalBranch(currentPC))
+        loopIdiom(currentPC);
+
+    if (idleDetect && pc != fallThrough && cosimRunning != COSIM_REFERENCE && !watching())
+        idleCheck();
+
+    if (coverageEnabled && (pc != fallThrough || coverBlockEnd(currentPC)))
+        coverBlock(pc);
+
+    // pending interrupts are taken at block boundaries only
+    if (pc != fallThrough && instCount >= nextEventAt)
+        checkInterrupts();
+    return true;
+}
+
+// the end of a translated block, after the instruction before fallThrough
+int aotEnd(unsigned int fallThrough)
+{
+    return stepEnd(fallThrough) ? AOT_CONTINUE : AOT_STOP;
+}
+
+// one pass of the simulation loop: an instruction (or a loop run natively, or a translated block) and the
+// interrupts due after it; false when the simulation has to stop
+bool simulateStep()
+{
+    unsigned int instWord = 0;
+    unsigned int fallThrough = 0;
+
+    reg[0] = 0; // zero is const
+    if (aotActive && pc < MEMORY_SIZE && !(pc & 1) && aotBlocks[pc >> 1] != NULL)
+    {
+        unsigned long long start = instCount;
+        int result = aotBlocks[pc >> 1]();
+        aotInstructions += instCount - start;
+        if (result != AOT_CHANGED)
+            return result == AOT_CONTINUE;
+        aotBlocks[pc >> 1] = NULL; // interpreted from now on
     }
-    else if (opcode == 0x67)
+    if (profileEnabled)
+        profileTick();
+    instCount++;
+
+    currentPC = pc;
+    // a 16-bit instruction may take the last halfword of RAM, a 32-bit one only the last word
+    if (pc > MEMORY_SIZE - 2 || ((memory[pc] & 0x3) == 0x3 && pc > MEMORY_SIZE - 4))
     {
-        switch (funct3)
+        accessFault(1, pc); // instruction access fault
+        return true;
+    }
+    if (statsEnabled)
+        pcCount[pc >> 1]++;
+
+    instWord = ((memory[pc] & 0x3) == 0x3) ? fetchWord(pc) : memory[pc] | (memory[pc + 1] << 8);
+
+    pc += 4;
+    if ((instWord & 0x00000003) != 0x3) // if 16-bit instruction
+    {
+        pc -= 4;
+
+        instWord = (unsigned char)memory[pc];
+        instWord |= (((unsigned char)memory[pc + 1]) << 8);
+
+        if (instWord == 0) // safety to prevent infinite loops
+            return false;
+
+        pc += 2;
+        fallThrough = pc;
+        instWord = predecode(instWord);
+
+        instDecExec(instWord, 1);
+    }
+    else
+    {
+        fallThrough = pc;
+        instDecExec(instWord, 0);
+    }
+
+    if (!stepEnd(fallThrough))
+        return false;
+
+    if (instWord == 0)
+    {
+        cout << "\nInstruction word = 0x0\nExit file\n";
+        return false;
+    }
+
+    // if (pc > 65536)
+    // { // safety to prevent infinite loops
+    //     cout << "\nEnd of text file\npc > 65536\n";
+    //     return false;
+    // }
+    return true;
+}
+
+// Job server (--serve <socket>): a pool of worker processes waits on a Unix socket before any job arrives. A
+// worker takes a connection, reads the job (the client's working directory and the arguments of an rvsim.exe
+// run) and forks. The child goes on into main with those arguments, so a job behaves exactly like rvsim.exe,
+// and the worker streams its stdout and stderr back, then its exit status. The simulator's state is global, so
+// jobs run in processes rather than threads; forking a waiting worker skips exec, the dynamic loader and the
+// C++ start-up. Frames in both directions are a type byte, a 32-bit little-endian length and the payload:
+//   to the server:   'A' the directory and the arguments, each ending in a 0 byte; 'I' stdin; 'Z' end of stdin
+//   to the client:   'O' stdout; 'E' stderr; 'X' the exit status (32 bits; 128 + the signal if it was killed)
+const unsigned int SERVE_FRAME_MAX = 1 << 20;
+
+bool serveSendAll(int fd, const void *data, size_t size)
+{
+    const char *p = (const char *)data;
+    while (size > 0)
+    {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool serveRecvAll(int fd, void *data, size_t size)
+{
+    char *p = (char *)data;
+    while (size > 0)
+    {
+        ssize_t n = recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool serveSend(int fd, char type, const void *data, unsigned int size)
+{
+    unsigned char header[5] = {(unsigned char)type, (unsigned char)size, (unsigned char)(size >> 8),
+                               (unsigned char)(size >> 16), (unsigned char)(size >> 24)};
+    return serveSendAll(fd, header, sizeof(header)) && serveSendAll(fd, data, size);
+}
+
+bool serveReceive(int fd, char &type, string &payload)
+{
+    unsigned char header[5];
+    if (!serveRecvAll(fd, header, sizeof(header)))
+        return false;
+    unsigned int size = header[1] | (header[2] << 8) | (header[3] << 16) | ((unsigned int)header[4] << 24);
+    if (size > SERVE_FRAME_MAX)
+        return false;
+    type = header[0];
+    payload.resize(size);
+    return size == 0 || serveRecvAll(fd, &payload[0], size);
+}
+
+string serveDecodeCache; // --decode-cache of the server, for the jobs with --quiet
+
+// one job on connection fd; true in the child that runs it, with its arguments
+bool serveJob(int fd, int listenFd, vector<string> &args)
+{
+    char type;
+    string payload;
+    if (!serveReceive(fd, type, payload) || type != 'A' || payload.empty() || payload.back() != 0)
+        return false;
+    vector<string> fields;
+    for (size_t start = 0; start < payload.size(); start = payload.find('\0', start) + 1)
+        fields.push_back(payload.c_str() + start);
+
+    int in[2], out[2], err[2];
+    if (pipe(in) < 0)
+        return false;
+    if (pipe(out) < 0)
+    {
+        close(in[0]), close(in[1]);
+        return false;
+    }
+    if (pipe(err) < 0)
+    {
+        close(in[0]), close(in[1]), close(out[0]), close(out[1]);
+        return false;
+    }
+    pid_t child = fork();
+    if (child == 0)
+    {
+        signal(SIGPIPE, SIG_DFL);
+        dup2(in[0], 0);
+        dup2(out[1], 1);
+        dup2(err[1], 2);
+        int fds[8] = {in[0], in[1], out[0], out[1], err[0], err[1], fd, listenFd};
+        for (int i = 0; i < 8; i++)
+            close(fds[i]);
+        if (chdir(fields[0].c_str()) < 0)
         {
-        case 0x0:
-            // 38.JALR
+            cerr << "Cannot change to the directory " << fields[0] << "\n";
+            _exit(1);
+        }
+        args.assign(fields.begin() + 1, fields.end());
+        if (!serveDecodeCache.empty() && find(args.begin(), args.end(), "--quiet") != args.end() &&
+            find(args.begin(), args.end(), "--decode-cache") == args.end())
+        {
+            args.push_back("--decode-cache");
+            args.push_back(serveDecodeCache);
+        }
+        return true;
+    }
+    close(in[0]);
+    close(out[1]);
+    close(err[1]);
+    if (child < 0)
+    {
+        close(in[1]), close(out[0]), close(err[0]);
+        return false;
+    }
 
-            if (isCompressed == 0)
+    // stdin goes to the job as the client sends it, without reading ahead of what the pipe takes
+    int inFd = in[1], outFd = out[0], errFd = err[0];
+    bool client = true;
+    string pending;
+    bool endOfInput = false;
+    while (outFd >= 0 || errFd >= 0)
+    {
+        pollfd fds[4] = {{client && pending.empty() ? fd : -1, POLLIN, 0},
+                         {!pending.empty() ? inFd : -1, POLLOUT, 0},
+                         {outFd, POLLIN, 0},
+                         {errFd, POLLIN, 0}};
+        if (poll(fds, 4, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[0].revents)
+        {
+            if (!serveReceive(fd, type, payload) || (type != 'I' && type != 'Z'))
             {
-                cout << "\tJALR\t" << name[rd] << ", " << name[rs1] << ", " << hex << "0x" << (int)I_imm << "\n";
+                client = false; // gone: the job is not wanted any more
+                kill(child, SIGKILL);
             }
-            else if (isCompressed == 1)
+            else if (type == 'I' && inFd >= 0)
+                pending = payload;
+            else
+                endOfInput = true;
+        }
+        if (fds[1].revents)
+        {
+            ssize_t n = write(inFd, pending.data(), pending.size());
+            if (n > 0)
+                pending.erase(0, n);
+            else if (n < 0 && errno != EINTR)
+                pending.clear(); // the job has closed its stdin
+        }
+        if (inFd >= 0 && pending.empty() && endOfInput)
+        {
+            close(inFd);
+            inFd = -1;
+        }
+        for (int i = 2; i < 4; i++)
+        {
+            if (!fds[i].revents)
+                continue;
+            char buffer[65536];
+            ssize_t n = read(fds[i].fd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n > 0 && client && !serveSend(fd, i == 2 ? 'O' : 'E', buffer, n))
             {
-                if (rd == 0b00000)
-                {
-                    cout << "\tC.JR\t" << name[rs1] << "\n";
-                }
-                else if (rd == 0b00001)
-                {
-                    cout << "\tC.JALR\t" << name[rs1] << "\n";
-                }
+                client = false;
+                kill(child, SIGKILL);
             }
-
-            if (isCompressed == 0)
+            if (n <= 0)
             {
-                reg[rd] = instPC + 4;
+                close(fds[i].fd);
+                (i == 2 ? outFd : errFd) = -1;
             }
+        }
+    }
+    if (inFd >= 0)
+        close(inFd);
+    if (outFd >= 0)
+        close(outFd);
+    if (errFd >= 0)
+        close(errFd);
+
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0 && errno == EINTR)
+        ;
+    unsigned int code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    unsigned char bytes[4] = {(unsigned char)code, (unsigned char)(code >> 8), (unsigned char)(code >> 16),
+                              (unsigned char)(code >> 24)};
+    if (client)
+        serveSend(fd, 'X', bytes, sizeof(bytes));
+    return false;
+}
 
-            else if (isCompressed == 1)
-            {
-                reg[rd] = instPC + 2;
-            }
+volatile sig_atomic_t serveStopping = 0;
 
-            pc = reg[rs1] + (int)I_imm;
-            // pc = pc & 0b00000000000000000000111111111111; // debugging: review
+void serveStop(int)
+{
+    serveStopping = 1;
+}
 
-            break;
+// rvsim.exe --serve <socket> [--workers <N>] [--decode-cache <dir>]; returns only in a job, with its arguments
+vector<string> serveJobs(int argc, char *argv[])
+{
+    string path = argv[2];
+    unsigned int workers = max(1u, thread::hardware_concurrency());
+    for (int i = 3; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--workers" && i + 1 < argc)
+            workers = max(1, atoi(argv[++i]));
+        else if (arg == "--decode-cache" && i + 1 < argc)
+            serveDecodeCache = argv[++i];
+        else
+            emitError("use: rvsim.exe --serve <socket> [--workers <N>] [--decode-cache <dir>]\n");
+    }
+    if (!serveDecodeCache.empty() && serveDecodeCache[0] != '/')
+    {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd)) != NULL)
+            serveDecodeCache = string(cwd) + "/" + serveDecodeCache; // the jobs run in the client's directory
+    }
 
-        default:
-            cout << "\tUnkown I Instruction \n";
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        emitError("The socket path is too long\n");
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(addr.sun_path);
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || bind(listenFd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd, 64) < 0)
+        emitError("Cannot open the server socket\n");
+    signal(SIGPIPE, SIG_IGN);
+    cerr << "Serving rvsim jobs on " << path << " with " << workers << " workers\n";
+
+    // the workers are replaced when they die; the server stops on SIGINT or SIGTERM
+    struct sigaction action = {};
+    action.sa_handler = serveStop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    set<pid_t> pool;
+    while (!serveStopping)
+    {
+        while (pool.size() < workers)
+        {
+            pid_t worker = fork();
+            if (worker == 0)
+            {
+                signal(SIGINT, SIG_DFL);
+                signal(SIGTERM, SIG_DFL);
+                vector<string> args;
+                while (true)
+                {
+                    int fd = accept(listenFd, NULL, NULL);
+                    if (fd < 0)
+                        continue;
+                    if (serveJob(fd, listenFd, args))
+                        return args;
+                    close(fd);
+                }
+            }
+            if (worker < 0)
+                break;
+            pool.insert(worker);
         }
+        pid_t done = wait(NULL);
+        if (done > 0)
+            pool.erase(done);
+        else if (errno == ECHILD)
+            sleep(1); // fork failed: try again
     }
-    else
+    for (set<pid_t>::iterator it = pool.begin(); it != pool.end(); it++)
+        kill(*it, SIGTERM);
+    unlink(addr.sun_path);
+    exit(0);
+}
+
+// the text at 0 and the data at 0x10000, with the stack and the break set up as newlib's crt0 expects (argc = 0,
+// argv = NULL)
+void loadProgram(const vector<unsigned char> &text, const vector<unsigned char> &data)
+{
+    if (!text.empty())
+        memcpy(memory, text.data(), min(text.size(), (size_t)MEMORY_SIZE));
+    size_t dataSize = min(data.size(), (size_t)(MEMORY_SIZE - 0x00010000));
+    if (dataSize != 0)
+        memcpy(memory + 0x00010000, data.data(), dataSize);
+
+    reg[2] = MEMORY_SIZE - 16;
+    heapStart = (0x00010000 + dataSize + 15) & ~15;
+    bool endKnown = false;
+    for (map<unsigned int, Symbol>::iterator it = symbols.begin(); it != symbols.end(); it++)
+        if (it->second.name == "_end" || it->second.name == "end")
+        {
+            heapStart = (it->first + 15) & ~15;
+            endKnown = true;
+        }
+    heapEnd = heapStart;
+    if (shadow != NULL)
+        shadowInit(text.size(), endKnown);
+}
+
+bool runStopRequested = false; // set by a librvsim callback: runUntil returns after the instruction
+unsigned long long maxInstructions = ~0ULL; // --max-instructions
+
+// the simulation loop, up to instruction end (a loop run natively may take it past); false once the program
+// has stopped
+bool runUntil(unsigned long long end)
+{
+    while (instCount < end && !runStopRequested)
     {
-        cout << "\tUnkown Instruction Type \n";
+        if (gdbAttached && (gdbAttention || (pc < MEMORY_SIZE && gdbBreakpoint[pc >> 1]) || --gdbPollCountdown == 0))
+            gdbCheck();
+        if (instCount >= reverseCheckpointAt)
+            reverseCheckpoint();
+        if (instCount >= cosimCheckAt)
+            cosimCheck();
+        if (!simulateStep())
+            return false;
     }
+    return true;
 }
 
+// rvbench.cpp and librvsim.cpp include this file for the simulator's functions and have no main
+#ifndef RVSIM_NO_MAIN
 int main(int argc, char *argv[])
 {
-    unsigned int instWord = 0;
     ifstream inFile;
     ifstream dataFile;
     ofstream outFile;
 
+    // a server's job goes on from here with the arguments it was sent
+    vector<string> jobArgs;
+    vector<char *> jobArgv;
+    if (argc >= 3 && string(argv[1]) == "--serve")
+    {
+        jobArgs = serveJobs(argc, argv);
+        jobArgv.push_back(argv[0]);
+        for (unsigned int i = 0; i < jobArgs.size(); i++)
+            jobArgv.push_back(&jobArgs[i][0]);
+        jobArgv.push_back(NULL);
+        argc = jobArgv.size() - 1;
+        argv = &jobArgv[0];
+    }
+
+    // one large buffer for the trace and the guest's output; std::exit flushes it
+    ios::sync_with_stdio(false);
+    cout.rdbuf()->pubsetbuf(outputBuffer, sizeof(outputBuffer));
+    guestOut.rdbuf(cout.rdbuf());
+    for (int fd = 0; fd < 3; fd++)
+        guestFds.push_back(fd);
+
     // debugging: use the lines below to hardcode which files to open
     // argc = 3;
     // argv[0] = "rvsim.exe";
@@ -1720,73 +8230,243 @@ int main(int argc, char *argv[])
     // argv[1] = "t3.bin";
     // argv[2] = "t3-d.bin";
 
-    if (argc < 1)
-        emitError("use: rvcdiss <machine_code_file_name>\n");
-
-    inFile.open(argv[1], ios::in | ios::binary | ios::ate);
-    filename = argv[1];
+    vector<string> files;
+    const char *recordName = NULL;
+    const char *replayName = NULL;
+    const char *coverageReportIn = NULL, *coverageReportOut = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--elf" && i + 1 < argc)
+            loadSymbols(argv[++i]);
+        else if (arg == "--profile" && i + 1 < argc)
+        {
+            profileEnabled = true;
+            profileFile = argv[++i];
+        }
+        else if (arg == "--no-m")
+            mExtension = false;
+        else if (arg == "--no-zb")
+            zbExtension = false;
+        else if (arg == "--vlen" && i + 1 < argc)
+        {
+            vlen = atoi(argv[++i]);
+            if (vlen < 32 || vlen > MAX_VLEN || (vlen & (vlen - 1)) != 0)
+                emitError("--vlen must be a power of two from 32 to 1024\n");
+        }
+        else if (arg == "--no-simd")
+            simdEnabled = false;
+        else if (arg == "--quiet")
+            quietMode = true;
+        else if (arg == "--timing")
+            timingEnabled = true;
+        else if (arg == "--decode-cache" && i + 1 < argc)
+            decodeCacheDir = argv[++i];
+        else if (arg == "--sync-io")
+            asyncIo = false;
+        else if (arg == "--max-instructions" && i + 1 < argc)
+            maxInstructions = strtoull(argv[++i], NULL, 0);
+        else if (arg == "--hle")
+            hleEnabled = true;
+        else if (arg == "--hle-verify")
+            hleEnabled = hleVerify = true;
+        else if (arg == "--gdb" && i + 1 < argc)
+            gdbSpec = argv[++i];
+        else if (arg == "--reverse")
+            reverseEnabled = true;
+        else if (arg == "--reverse-memory" && i + 1 < argc)
+            reverseMemory = (unsigned long long)max(1, atoi(argv[++i])) << 20;
+        else if (arg == "--last-write" && i + 1 < argc)
+        {
+            reverseEnabled = lastWriteEnabled = true;
+            lastWriteAddr = strtoul(argv[++i], NULL, 0);
+        }
+        else if ((arg == "--watch" || arg == "--rwatch" || arg == "--awatch") && i + 1 < argc)
+        {
+            // ADDR[:LEN]
+            char *end;
+            Watchpoint w = {arg == "--watch" ? '2' : arg == "--rwatch" ? '3' : '4', 0, 1, true};
+            w.addr = strtoul(argv[++i], &end, 0);
+            if (*end == ':')
+                w.length = max(1ul, strtoul(end + 1, NULL, 0));
+            watchpoints.push_back(w);
+            watchUpdatePages();
+        }
+        else if (arg == "--record" && i + 1 < argc)
+            recordName = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayName = argv[++i];
+        else if (arg == "--no-idle-detect")
+            idleDetect = false;
+        else if (arg == "--cosim")
+            cosimEnabled = true;
+        else if (arg == "--cosim-interval" && i + 1 < argc)
+        {
+            cosimEnabled = true;
+            cosimInterval = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--idioms")
+            idiomEnabled = true;
+        else if (arg == "--stats")
+            statsEnabled = true;
+        else if (arg == "--stats-out" && i + 1 < argc)
+        {
+            statsEnabled = true;
+            statsFile = argv[++i];
+        }
+        else if (arg == "--compare-stats" && i + 2 < argc)
+        {
+            compareStats(argv[i + 1], argv[i + 2]);
+            return 0;
+        }
+        else if (arg == "--coverage" && i + 1 < argc)
+        {
+            coverageEnabled = true;
+            coverageFile = argv[++i];
+        }
+        else if (arg == "--sanitize")
+            shadow = shadowBytes;
+        else if (arg == "--coverage-report" && i + 2 < argc)
+        {
+            coverageReportIn = argv[++i];
+            coverageReportOut = argv[++i];
+        }
+        else if (arg == "--profile-sample" && i + 1 < argc)
+        {
+            profileSampleRate = max(1, atoi(argv[++i]));
+            profileCountdown = profileSampleRate;
+        }
+        else
+            files.push_back(arg);
+    }
 
-    if (argc == 3)
-        dataFile.open(argv[2], ios::in | ios::binary | ios::ate); // data section
+    if (coverageReportIn != NULL)
+    {
+        coverageReport(coverageReportIn, coverageReportOut); // after --elf, wherever it is
+        return 0;
+    }
 
+    if (files.empty())
+        emitError("use: rvsim <machine_code_file_name> [<data_file_name>]\n"
+                  "  --elf <file>              load function names from the ELF symbol table\n"
+                  "  --profile <file>          write call-graph profile as folded stacks\n"
+                  "  --profile-sample <N>      sample the call path every N instructions\n"
+                  "  --no-m                    treat RV32M (MUL/DIV/REM) as unknown instructions\n"
+                  "  --no-zb                   treat Zba/Zbb (bit manipulation) as unknown instructions\n"
+                  "  --vlen <bits>             vector register length, 32 to 1024 (default 128)\n"
+                  "  --no-simd                 run vector instructions without the host SSE2/AVX2 kernels\n"
+                  "  --quiet                   do not trace instructions, only show the program's output\n"
+                  "  --timing                  at the end, print the instruction count, host time and MIPS\n"
+                  "  --decode-cache <dir>      keep the decoded text in dir for the next run of the same text (--quiet)\n"
+                  "  --sync-io                 do guest file I/O on the simulation thread (no read-ahead/write-behind)\n"
+                  "  --max-instructions <N>    stop the program after N instructions, with exit status 124\n"
+                  "  --serve <socket> [--workers <N>] [--decode-cache <dir>]  run the jobs rvsimc sends (first option)\n"
+                  "  --hle                     run memcpy, memset, strlen, strcpy, ... natively (needs --elf)\n"
+                  "  --hle-verify              like --hle, but also run the guest code and compare the results\n"
+                  "  --idioms                  run recognised copy, fill and string-scan loops natively\n"
+                  "  --gdb <port>|unix:<path>  wait for gdb (target remote) on a localhost port or a Unix socket\n"
+                  "  --reverse                 keep a history for gdb's reverse-step and reverse-continue\n"
+                  "  --reverse-memory <MB>     memory for the reverse history (default 64)\n"
+                  "  --last-write <addr>       at the end, go back to the last store to addr and show it\n"
+                  "  --watch <addr>[:<len>]    print every store to the range: pc, instruction, old and new value\n"
+                  "  --rwatch <addr>[:<len>]   the same for loads\n"
+                  "  --awatch <addr>[:<len>]   the same for loads and stores\n"
+                  "  --record <file>           log every system call result so the run can be replayed exactly\n"
+                  "  --replay <file>           run again with the system call results from --record (no host files)\n"
+                  "  --no-idle-detect          keep simulating endless and idle loops (no fast-forward or stop)\n"
+                  "  --cosim                   check the fast paths against the plain interpreter as the program runs\n"
+                  "  --cosim-interval <N>      instructions between the --cosim comparisons (default 100000)\n"
+                  "  --stats                   print dynamic instruction mix and RVC density\n"
+                  "  --stats-out <file>        also save the statistics for --compare-stats\n"
+                  "  --compare-stats <a> <b>   show two saved statistics side by side\n"
+                  "  --coverage <file>         add the blocks and branch directions that ran to file\n"
+                  "  --coverage-report <file> <out>  write the coverage as lcov (with --elf) or annotated disassembly\n"
+                  "  --sanitize                report stack overflows, writes into text and reads of unwritten memory\n");
+
+    if (statsEnabled)
+        pcCount.assign(MEMORY_SIZE / 2, 0);
+    vecSelectKernel();
+#ifdef RVSIM_AOT
+    aotBlocks.assign(MEMORY_SIZE / 2, NULL);
+    aotRegister();
+    aotActive = quietMode && !statsEnabled && !profileEnabled && !hleEnabled && watchpoints.empty() && gdbSpec.empty() &&
+                !reverseEnabled && !coverageEnabled && shadow == NULL;
+#endif
+    if (hleEnabled && symbols.empty())
+        emitError("--hle needs the function names from --elf\n");
+    if (hleEnabled)
+        hleInstall();
+    if (recordName != NULL)
+        recordOpen(recordName); // after --vlen, --no-m, --no-zb and --hle
+    if (replayName != NULL)
+        replayLoad(replayName);
+    if (reverseEnabled && profileEnabled)
+        emitError("--reverse cannot be combined with --profile\n");
+    if (cosimEnabled && (reverseEnabled || profileEnabled || hleEnabled || !gdbSpec.empty()))
+        emitError("--cosim cannot be combined with --reverse, --last-write, --profile, --hle or --gdb\n");
+    if (!decodeCacheDir.empty() && !quietMode)
+        emitError("--decode-cache needs --quiet: the trace comes from decoding every step\n");
+
+    inFile.open(files[0].c_str(), ios::in | ios::binary | ios::ate);
+    filename = files[0];
+
+    if (files.size() > 1)
+        dataFile.open(files[1].c_str(), ios::in | ios::binary | ios::ate); // data section
+
+    profileRoot.func = pc;
+
+    vector<unsigned char> text, data;
     if (inFile.is_open())
     {
-        int fsize = inFile.tellg();
+        text.resize(inFile.tellg());
         inFile.seekg(0, inFile.beg);
-        if (!inFile.read((char *)memory, fsize)) // text file
+        if (!inFile.read((char *)text.data(), text.size())) // text file
             emitError("Cannot read from text file\n");
     }
 
     if (dataFile.is_open())
     {
-        int fsize = dataFile.tellg();
+        data.resize(dataFile.tellg());
         dataFile.seekg(0, dataFile.beg);
-        if (!dataFile.read((char *)(memory + 0x00010000), fsize)) // data section
+        if (!dataFile.read((char *)data.data(), data.size())) // data section
             emitError("Cannot read from data file\n");
     }
-
-    if (inFile.is_open())
+    loadProgram(text, data);
+    if (quietMode && !text.empty())
+        predecodeInit(text.size());
+    if (coverageEnabled)
     {
-        while (true)
-        {
-            reg[0] = 0; // zero is const
-            instWord = (unsigned char)memory[pc] |
-                       (((unsigned char)memory[pc + 1]) << 8) |
-                       (((unsigned char)memory[pc + 2]) << 16) |
-                       (((unsigned char)memory[pc + 3]) << 24);
-
-            pc += 4;
-            if ((instWord & 0x00000003) != 0x3) // if 16-bit instruction
-            {
-                pc -= 4;
-
-                instWord = (unsigned char)memory[pc];
-                instWord |= (((unsigned char)memory[pc + 1]) << 8);
+        coverageText = text;
+        coverBlock(pc);
+    }
 
-                if (instWord == 0) // safety to prevent infinite loops
-                    break;
+    if (quietMode)
+        cout.setstate(ios::badbit); // trace output is dropped before it is formatted
 
-                pc += 2;
-                instWord = decompress(instWord);
+    if (reverseEnabled)
+        reverseCheckpoint();
+    if (cosimEnabled)
+    {
+        captureState(cosimAgreed);
+        cosimCheckAt = cosimInterval;
+    }
 
-                instDecExec(instWord, 1);
-            }
-            else
-            {
-                instDecExec(instWord, 0);
-            }
+    if (!gdbSpec.empty())
+    {
+        gdbListen();
+        gdbStop(0, "");
+    }
 
-            if (instWord == 0)
-            {
-                cout << "\nInstruction word = 0x0\nExit file\n";
-                break;
-            }
+    timingStart = chrono::steady_clock::now();
 
-            // if (pc > 65536)
-            // { // safety to prevent infinite loops
-            //     cout << "\nEnd of text file\npc > 65536\n";
-            //     break;
-            // }
-        }
+    if (inFile.is_open() && runUntil(maxInstructions))
+    {
+        cout.clear();
+        cout << "\nStopped after the --max-instructions limit of " << dec << maxInstructions << " instructions (pc = 0x"
+             << hex << pc << ")\n";
+        endSimulation(124); // the status of timeout(1)
     }
-}
\ No newline at end of file
+
+    finishSimulation();
+}
+#endif
@@ -0,0 +1,192 @@
+// rvsimc: runs a job on an rvsim.exe --serve server. It takes the arguments of rvsim.exe, sends them with the
+// working directory, forwards stdin, prints what the job writes to stdout and stderr as it comes, and exits
+// with the job's exit status.
+//
+//   g++ -O2 -o rvsimc rvsimc.cpp
+//   rvsimc [--socket <path>] <rvsim.exe arguments>
+// The socket is $RVSIM_SOCKET when set, or /tmp/rvsim.sock. The frames are those of serveJob in rvsim.cpp. The
+// client starts once per job, so it uses only the C library: no iostreams or simulator globals to set up.
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// a type byte, a 32-bit little-endian length and the payload
+struct Frame
+{
+    char type;
+    unsigned int size;
+    char *data;
+};
+
+bool sendAll(int fd, const void *data, size_t size)
+{
+    const char *p = (const char *)data;
+    while (size > 0)
+    {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool recvAll(int fd, void *data, size_t size)
+{
+    char *p = (char *)data;
+    while (size > 0)
+    {
+        ssize_t n = recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+void frameHeader(unsigned char header[5], char type, unsigned int size)
+{
+    header[0] = type;
+    for (int i = 0; i < 4; i++)
+        header[1 + i] = size >> (8 * i);
+}
+
+// the payload is in a buffer of the frame's that grows as needed
+bool receiveFrame(int fd, Frame &frame, unsigned int &capacity)
+{
+    unsigned char header[5];
+    if (!recvAll(fd, header, sizeof(header)))
+        return false;
+    frame.type = header[0];
+    frame.size = header[1] | (header[2] << 8) | (header[3] << 16) | ((unsigned int)header[4] << 24);
+    if (frame.size > (1 << 20))
+        return false;
+    if (frame.size > capacity)
+    {
+        capacity = frame.size;
+        frame.data = (char *)realloc(frame.data, capacity);
+    }
+    return frame.size == 0 || recvAll(fd, frame.data, frame.size);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = getenv("RVSIM_SOCKET") != NULL ? getenv("RVSIM_SOCKET") : "/tmp/rvsim.sock";
+    int first = 1;
+    if (argc >= 3 && strcmp(argv[1], "--socket") == 0)
+    {
+        path = argv[2];
+        first = 3;
+    }
+    if (first >= argc)
+    {
+        fprintf(stderr, "use: rvsimc [--socket <path>] <rvsim.exe arguments>\n");
+        return 1;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        fprintf(stderr, "Cannot connect to the rvsim server on %s (start one with rvsim.exe --serve %s)\n", path, path);
+        return 1;
+    }
+
+    // the working directory and the arguments, each ending in a 0 byte
+    static char job[65536];
+    if (getcwd(job, sizeof(job)) == NULL)
+    {
+        fprintf(stderr, "Cannot get the working directory\n");
+        return 1;
+    }
+    size_t jobSize = strlen(job) + 1;
+    for (int i = first; i < argc; i++)
+    {
+        size_t size = strlen(argv[i]) + 1;
+        if (jobSize + size > sizeof(job))
+        {
+            fprintf(stderr, "The arguments are too long\n");
+            return 1;
+        }
+        memcpy(job + jobSize, argv[i], size);
+        jobSize += size;
+    }
+    unsigned char header[5];
+    frameHeader(header, 'A', jobSize);
+    if (!sendAll(fd, header, sizeof(header)) || !sendAll(fd, job, jobSize))
+    {
+        fprintf(stderr, "The rvsim server closed the connection\n");
+        return 1;
+    }
+
+    // stdin goes to the server until it ends, without blocking: the job's output comes back meanwhile, until
+    // its exit status
+    bool input = true;
+    static char outgoing[5 + 65536]; // a frame of stdin not sent yet
+    size_t outgoingStart = 0, outgoingEnd = 0;
+    Frame frame = {0, 0, NULL};
+    unsigned int capacity = 0;
+    while (true)
+    {
+        bool sending = outgoingStart < outgoingEnd;
+        pollfd fds[2] = {{fd, (short)(POLLIN | (sending ? POLLOUT : 0)), 0}, {input && !sending ? 0 : -1, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].revents)
+        {
+            ssize_t n = read(0, outgoing + 5, sizeof(outgoing) - 5);
+            if (n < 0 && errno == EINTR)
+                continue;
+            frameHeader((unsigned char *)outgoing, n > 0 ? 'I' : 'Z', n > 0 ? n : 0);
+            outgoingStart = 0;
+            outgoingEnd = 5 + (n > 0 ? n : 0);
+            input = n > 0;
+        }
+        if (outgoingStart < outgoingEnd && (fds[0].revents & POLLOUT))
+        {
+            ssize_t n = send(fd, outgoing + outgoingStart, outgoingEnd - outgoingStart, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n > 0)
+                outgoingStart += n;
+            else if (n < 0 && errno != EINTR && errno != EAGAIN)
+            {
+                outgoingStart = outgoingEnd; // the job has ended: its status is still to be read
+                input = false;
+            }
+        }
+        if (fds[0].revents & (POLLIN | POLLHUP))
+        {
+            if (!receiveFrame(fd, frame, capacity))
+                break;
+            if (frame.type == 'X' && frame.size == 4)
+                return (unsigned char)frame.data[0];
+            int out = frame.type == 'E' ? 2 : 1;
+            for (unsigned int done = 0; done < frame.size;)
+            {
+                ssize_t n = write(out, frame.data + done, frame.size - done);
+                if (n < 0 && errno != EINTR)
+                    return 1;
+                if (n > 0)
+                    done += n;
+            }
+        }
+    }
+    fprintf(stderr, "The rvsim server closed the connection before the job ended\n");
+    return 1;
+}
@@ -0,0 +1,449 @@
+
+coremark.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       8:      	lui	gp, 16
+       c:      	auipc	ra, 0
+      10:      	jalr	24(ra)
+      14:      	li	a7, 1
+      18:      	ecall	
+      1c:      	li	a7, 10
+      20:      	ecall	
+
+00000024 <main>:
+      24:      	addi	sp, sp, -16
+      28:      	sw	ra, 12(sp)
+      2c:      	sw	s0, 8(sp)
+      30:      	sw	s1, 4(sp)
+      34:      	auipc	ra, 0
+      38:      	jalr	108(ra)
+      3c:      	auipc	ra, 0
+      40:      	jalr	184(ra)
+      44:      	addi	a0, gp, 1024
+      48:      	auipc	a1, 0
+      4c:      	addi	a1, a1, 1364
+      50:      	auipc	ra, 0
+      54:      	jalr	1292(ra)
+      58:      	li	s0, 320
+      5c:      	li	s1, 0
+      60:      	mv	a0, s1
+      64:      	auipc	ra, 0
+      68:      	jalr	200(ra)
+      6c:      	auipc	ra, 0
+      70:      	jalr	452(ra)
+      74:      	auipc	ra, 0
+      78:      	jalr	684(ra)
+      7c:      	mv	s1, a0
+      80:      	addi	s0, s0, -1
+      84:      	bnez	s0, 0x60 <main+0x3c>
+      88:      	mv	a0, s1
+      8c:      	lw	ra, 12(sp)
+      90:      	lw	s0, 8(sp)
+      94:      	lw	s1, 4(sp)
+      98:      	addi	sp, sp, 16
+      9c:      	ret
+
+000000a0 <list_init>:
+      a0:      	mv	a0, gp
+      a4:      	sw	a0, 1536(gp)
+      a8:      	li	a1, 0
+      ac:      	lui	a2, 1
+      b0:      	addi	a2, a2, 564
+      b4:      	li	a3, 32
+      b8:      	slli	a4, a2, 2
+      bc:      	add	a2, a2, a4
+      c0:      	addi	a2, a2, 935
+      c4:      	slli	a2, a2, 16
+      c8:      	srli	a2, a2, 16
+      cc:      	sh	a2, 4(a0)
+      d0:      	sh	a1, 6(a0)
+      d4:      	addi	a4, a0, 8
+      d8:      	addi	a1, a1, 1
+      dc:      	bne	a1, a3, 0xe4 <list_init+0x44>
+      e0:      	li	a4, 0
+      e4:      	sw	a4, 0(a0)
+      e8:      	addi	a0, a0, 8
+      ec:      	bne	a1, a3, 0xb8 <list_init+0x18>
+      f0:      	ret
+
+000000f4 <matrix_init>:
+      f4:      	addi	a0, gp, 256
+      f8:      	li	a1, 72
+      fc:      	li	a2, 753
+     100:      	slli	a3, a2, 2
+     104:      	add	a2, a2, a3
+     108:      	addi	a2, a2, 935
+     10c:      	slli	a2, a2, 16
+     110:      	srli	a2, a2, 16
+     114:      	andi	a3, a2, 127
+     118:      	sh	a3, 0(a0)
+     11c:      	addi	a0, a0, 2
+     120:      	addi	a1, a1, -1
+     124:      	bnez	a1, 0x100 <matrix_init+0xc>
+     128:      	ret
+
+0000012c <bench_list>:
+     12c:      	addi	sp, sp, -32
+     130:      	sw	ra, 28(sp)
+     134:      	sw	s0, 24(sp)
+     138:      	sw	s1, 20(sp)
+     13c:      	sw	s2, 16(sp)
+     140:      	sw	s3, 12(sp)
+     144:      	mv	s0, a0
+     148:      	li	s1, 0
+     14c:      	li	s3, 0
+     150:      	lw	a0, 1536(gp)
+     154:      	slli	a1, s1, 3
+     158:      	sub	a1, a1, s1
+     15c:      	add	a1, a1, s0
+     160:      	andi	a1, a1, 255
+     164:      	auipc	ra, 0
+     168:      	jalr	144(ra)
+     16c:      	beqz	a0, 0x17c <bench_list+0x50>
+     170:      	lhu	a0, 6(a0)
+     174:      	add	s3, s3, a0
+     178:      	j	0x180 <bench_list+0x54>
+     17c:      	addi	s3, s3, -1
+     180:      	addi	s1, s1, 1
+     184:      	li	a0, 8
+     188:      	blt	s1, a0, 0x150 <bench_list+0x24>
+     18c:      	lw	a0, 1536(gp)
+     190:      	auipc	ra, 0
+     194:      	jalr	124(ra)
+     198:      	sw	a0, 1536(gp)
+     19c:      	mv	s2, a0
+     1a0:      	beqz	s2, 0x1c8 <bench_list+0x9c>
+     1a4:      	lhu	a0, 4(s2)
+     1a8:      	addi	a1, a0, 1
+     1ac:      	sh	a1, 4(s2)
+     1b0:      	mv	a1, s0
+     1b4:      	auipc	ra, 0
+     1b8:      	jalr	872(ra)
+     1bc:      	mv	s0, a0
+     1c0:      	lw	s2, 0(s2)
+     1c4:      	j	0x1a0 <bench_list+0x74>
+     1c8:      	mv	a0, s3
+     1cc:      	mv	a1, s0
+     1d0:      	auipc	ra, 0
+     1d4:      	jalr	844(ra)
+     1d8:      	lw	ra, 28(sp)
+     1dc:      	lw	s0, 24(sp)
+     1e0:      	lw	s1, 20(sp)
+     1e4:      	lw	s2, 16(sp)
+     1e8:      	lw	s3, 12(sp)
+     1ec:      	addi	sp, sp, 32
+     1f0:      	ret
+
+000001f4 <list_find>:
+     1f4:      	beqz	a0, 0x208 <list_find+0x14>
+     1f8:      	lbu	a2, 4(a0)
+     1fc:      	beq	a2, a1, 0x208 <list_find+0x14>
+     200:      	lw	a0, 0(a0)
+     204:      	j	0x1f4 <list_find>
+     208:      	ret
+
+0000020c <list_reverse>:
+     20c:      	li	a1, 0
+     210:      	beqz	a0, 0x228 <list_reverse+0x1c>
+     214:      	lw	a2, 0(a0)
+     218:      	sw	a1, 0(a0)
+     21c:      	mv	a1, a0
+     220:      	mv	a0, a2
+     224:      	j	0x210 <list_reverse+0x4>
+     228:      	mv	a0, a1
+     22c:      	ret
+
+00000230 <bench_matrix>:
+     230:      	addi	sp, sp, -32
+     234:      	sw	ra, 28(sp)
+     238:      	sw	s0, 24(sp)
+     23c:      	sw	s1, 20(sp)
+     240:      	sw	s2, 16(sp)
+     244:      	sw	s3, 12(sp)
+     248:      	sw	s4, 8(sp)
+     24c:      	sw	s5, 4(sp)
+     250:      	mv	s0, a0
+     254:      	andi	s1, a0, 15
+     258:      	addi	a0, gp, 256
+     25c:      	addi	a1, a0, 128
+     260:      	lh	a2, 0(a0)
+     264:      	add	a2, a2, s1
+     268:      	sh	a2, 0(a0)
+     26c:      	addi	a0, a0, 2
+     270:      	bne	a0, a1, 0x260 <bench_matrix+0x30>
+     274:      	addi	s2, gp, 256
+     278:      	addi	s3, gp, 512
+     27c:      	li	s4, 0
+     280:      	li	s5, 0
+     284:      	slli	a0, s5, 1
+     288:      	add	a1, s2, a0
+     28c:      	lh	a0, 0(a1)
+     290:      	slli	a1, s5, 1
+     294:      	add	a1, gp, a1
+     298:      	lh	a1, 384(a1)
+     29c:      	auipc	ra, 0
+     2a0:      	jalr	732(ra)
+     2a4:      	add	s4, s4, a0
+     2a8:      	addi	s5, s5, 1
+     2ac:      	li	a0, 8
+     2b0:      	blt	s5, a0, 0x284 <bench_matrix+0x54>
+     2b4:      	sw	s4, 0(s3)
+     2b8:      	mv	a0, s4
+     2bc:      	mv	a1, s0
+     2c0:      	auipc	ra, 0
+     2c4:      	jalr	604(ra)
+     2c8:      	mv	s0, a0
+     2cc:      	addi	s2, s2, 16
+     2d0:      	addi	s3, s3, 4
+     2d4:      	addi	a0, gp, 384
+     2d8:      	bne	s2, a0, 0x27c <bench_matrix+0x4c>
+     2dc:      	addi	a0, gp, 256
+     2e0:      	addi	a1, a0, 128
+     2e4:      	lh	a2, 0(a0)
+     2e8:      	sub	a2, a2, s1
+     2ec:      	sh	a2, 0(a0)
+     2f0:      	addi	a0, a0, 2
+     2f4:      	bne	a0, a1, 0x2e4 <bench_matrix+0xb4>
+     2f8:      	mv	a0, s0
+     2fc:      	lw	ra, 28(sp)
+     300:      	lw	s0, 24(sp)
+     304:      	lw	s1, 20(sp)
+     308:      	lw	s2, 16(sp)
+     30c:      	lw	s3, 12(sp)
+     310:      	lw	s4, 8(sp)
+     314:      	lw	s5, 4(sp)
+     318:      	addi	sp, sp, 32
+     31c:      	ret
+
+00000320 <bench_state>:
+     320:      	addi	sp, sp, -16
+     324:      	sw	ra, 12(sp)
+     328:      	sw	s0, 8(sp)
+     32c:      	sw	s1, 4(sp)
+     330:      	sw	s2, 0(sp)
+     334:      	mv	s0, a0
+     338:      	addi	a0, gp, 1280
+     33c:      	addi	a1, a0, 32
+     340:      	sw	zero, 0(a0)
+     344:      	addi	a0, a0, 4
+     348:      	bne	a0, a1, 0x340 <bench_state+0x20>
+     34c:      	addi	s1, gp, 1024
+     350:      	lbu	a0, 0(s1)
+     354:      	beqz	a0, 0x380 <bench_state+0x60>
+     358:      	mv	a0, s1
+     35c:      	auipc	ra, 0
+     360:      	jalr	108(ra)
+     364:      	mv	s1, a1
+     368:      	slli	a0, a0, 2
+     36c:      	add	a0, gp, a0
+     370:      	lw	a2, 1280(a0)
+     374:      	addi	a2, a2, 1
+     378:      	sw	a2, 1280(a0)
+     37c:      	j	0x350 <bench_state+0x30>
+     380:      	li	s2, 0
+     384:      	slli	a0, s2, 2
+     388:      	add	a0, gp, a0
+     38c:      	lw	a0, 1280(a0)
+     390:      	mv	a1, s0
+     394:      	auipc	ra, 0
+     398:      	jalr	392(ra)
+     39c:      	mv	s0, a0
+     3a0:      	addi	s2, s2, 1
+     3a4:      	li	a0, 8
+     3a8:      	blt	s2, a0, 0x384 <bench_state+0x64>
+     3ac:      	mv	a0, s0
+     3b0:      	lw	ra, 12(sp)
+     3b4:      	lw	s0, 8(sp)
+     3b8:      	lw	s1, 4(sp)
+     3bc:      	lw	s2, 0(sp)
+     3c0:      	addi	sp, sp, 16
+     3c4:      	ret
+
+000003c8 <state_token>:
+     3c8:      	li	a2, 0
+     3cc:      	auipc	t0, 0
+     3d0:      	addi	t0, t0, 236
+     3d4:      	lbu	a3, 0(a0)
+     3d8:      	beqz	a3, 0x4ac <state_token+0xe4>
+     3dc:      	addi	a0, a0, 1
+     3e0:      	li	a4, 44
+     3e4:      	beq	a3, a4, 0x4ac <state_token+0xe4>
+     3e8:      	addi	a5, a3, -48
+     3ec:      	sltiu	a5, a5, 10
+     3f0:      	slli	a4, a2, 2
+     3f4:      	add	a4, t0, a4
+     3f8:      	jr	a4
+     3fc:      	bnez	a5, 0x484 <state_token+0xbc>
+     400:      	li	a4, 43
+     404:      	beq	a3, a4, 0x47c <state_token+0xb4>
+     408:      	li	a4, 45
+     40c:      	beq	a3, a4, 0x47c <state_token+0xb4>
+     410:      	li	a4, 46
+     414:      	beq	a3, a4, 0x48c <state_token+0xc4>
+     418:      	j	0x474 <state_token+0xac>
+     41c:      	bnez	a5, 0x484 <state_token+0xbc>
+     420:      	li	a4, 46
+     424:      	beq	a3, a4, 0x48c <state_token+0xc4>
+     428:      	j	0x474 <state_token+0xac>
+     42c:      	bnez	a5, 0x3d4 <state_token+0xc>
+     430:      	li	a4, 46
+     434:      	beq	a3, a4, 0x48c <state_token+0xc4>
+     438:      	j	0x474 <state_token+0xac>
+     43c:      	bnez	a5, 0x3d4 <state_token+0xc>
+     440:      	li	a4, 69
+     444:      	beq	a3, a4, 0x49c <state_token+0xd4>
+     448:      	li	a4, 101
+     44c:      	beq	a3, a4, 0x49c <state_token+0xd4>
+     450:      	j	0x474 <state_token+0xac>
+     454:      	li	a4, 43
+     458:      	beq	a3, a4, 0x494 <state_token+0xcc>
+     45c:      	li	a4, 45
+     460:      	beq	a3, a4, 0x494 <state_token+0xcc>
+     464:      	j	0x474 <state_token+0xac>
+     468:      	bnez	a5, 0x4a4 <state_token+0xdc>
+     46c:      	j	0x474 <state_token+0xac>
+     470:      	bnez	a5, 0x3d4 <state_token+0xc>
+     474:      	li	a2, 1
+     478:      	j	0x3d4 <state_token+0xc>
+     47c:      	li	a2, 2
+     480:      	j	0x3d4 <state_token+0xc>
+     484:      	li	a2, 3
+     488:      	j	0x3d4 <state_token+0xc>
+     48c:      	li	a2, 4
+     490:      	j	0x3d4 <state_token+0xc>
+     494:      	li	a2, 5
+     498:      	j	0x3d4 <state_token+0xc>
+     49c:      	li	a2, 6
+     4a0:      	j	0x3d4 <state_token+0xc>
+     4a4:      	li	a2, 7
+     4a8:      	j	0x3d4 <state_token+0xc>
+     4ac:      	mv	a1, a0
+     4b0:      	mv	a0, a2
+     4b4:      	ret
+     4b8:      	j	0x3fc <state_token+0x34>
+     4bc:      	j	0x3d4 <state_token+0xc>
+     4c0:      	j	0x41c <state_token+0x54>
+     4c4:      	j	0x42c <state_token+0x64>
+     4c8:      	j	0x43c <state_token+0x74>
+     4cc:      	j	0x468 <state_token+0xa0>
+     4d0:      	j	0x454 <state_token+0x8c>
+     4d4:      	j	0x470 <state_token+0xa8>
+
+000004d8 <crcu8>:
+     4d8:      	li	a2, 8
+     4dc:      	lui	a4, 4
+     4e0:      	addi	a4, a4, 2
+     4e4:      	lui	a5, 8
+     4e8:      	xor	a3, a0, a1
+     4ec:      	andi	a3, a3, 1
+     4f0:      	srli	a0, a0, 1
+     4f4:      	beqz	a3, 0x508 <crcu8+0x30>
+     4f8:      	xor	a1, a1, a4
+     4fc:      	srli	a1, a1, 1
+     500:      	or	a1, a1, a5
+     504:      	j	0x50c <crcu8+0x34>
+     508:      	srli	a1, a1, 1
+     50c:      	addi	a2, a2, -1
+     510:      	bnez	a2, 0x4e8 <crcu8+0x10>
+     514:      	mv	a0, a1
+     518:      	ret
+
+0000051c <crcu16>:
+     51c:      	addi	sp, sp, -16
+     520:      	sw	ra, 12(sp)
+     524:      	sw	s0, 8(sp)
+     528:      	srli	s0, a0, 8
+     52c:      	andi	s0, s0, 255
+     530:      	andi	a0, a0, 255
+     534:      	auipc	ra, 0
+     538:      	jalr	-92(ra)
+     53c:      	mv	a1, a0
+     540:      	mv	a0, s0
+     544:      	auipc	ra, 0
+     548:      	jalr	-108(ra)
+     54c:      	lw	ra, 12(sp)
+     550:      	lw	s0, 8(sp)
+     554:      	addi	sp, sp, 16
+     558:      	ret
+
+0000055c <strcpy>:
+     55c:      	mv	a2, a0
+     560:      	lbu	a3, 0(a1)
+     564:      	sb	a3, 0(a2)
+     568:      	addi	a1, a1, 1
+     56c:      	addi	a2, a2, 1
+     570:      	bnez	a3, 0x560 <strcpy+0x4>
+     574:      	ret
+
+00000578 <__mulsi3>:
+     578:      	mv	a2, a0
+     57c:      	li	a0, 0
+     580:      	andi	a3, a1, 1
+     584:      	beqz	a3, 0x58c <__mulsi3+0x14>
+     588:      	add	a0, a0, a2
+     58c:      	srli	a1, a1, 1
+     590:      	slli	a2, a2, 1
+     594:      	bnez	a1, 0x580 <__mulsi3+0x8>
+     598:      	ret
+
+0000059c <state_input>:
+     59c:      	<unknown>
+     59e:      	<unknown>
+     5a0:      	<unknown>
+     5a2:      	<unknown>
+     5a4:      	<unknown>
+     5a6:      	<unknown>
+     5a8:      	lui	s0, 176835
+     5ac:      	<unknown>
+     5ae:      	<unknown>
+     5b0:      	<unknown>
+     5b4:      	<unknown>
+     5b6:      	<unknown>
+     5b8:      	<unknown>
+     5ba:      	<unknown>
+     5bc:      	<unknown>
+     5c0:      	<unknown>
+     5c2:      	<unknown>
+     5c4:      	<unknown>
+     5c6:      	<unknown>
+     5c8:      	<unknown>
+     5ca:      	<unknown>
+     5cc:      	<unknown>
+     5ce:      	<unknown>
+     5d0:      	<unknown>
+     5d2:      	<unknown>
+     5d4:      	<unknown>
+     5d6:      	<unknown>
+     5d8:      	<unknown>
+     5da:      	<unknown>
+     5de:      	<unknown>
+     5e0:      	<unknown>
+     5e2:      	<unknown>
+     5e4:      	<unknown>
+     5e6:      	<unknown>
+     5e8:      	lui	a0, 230070
+     5ec:      	<unknown>
+     5f0:      	<unknown>
+     5f2:      	<unknown>
+     5f4:      	<unknown>
+     5f6:      	<unknown>
+     5f8:      	<unknown>
+     5fa:      	<unknown>
+     5fc:      	<unknown>
+     5fe:      	<unknown>
+     600:      	<unknown>
+     602:      	<unknown>
+     604:      	<unknown>
+     606:      	<unknown>
+     60a:      	<unknown>
+     60c:      	<unknown>
+     610:      	<unknown>
+     612:      	<unknown>
+     614:      	<unknown>
+     616:      	<unknown>
+     618:      	<unknown>
+     61a:      	<unknown>
@@ -0,0 +1,413 @@
+# CoreMark-style benchmark: each iteration searches and reverses a linked list, multiplies a small matrix by
+# a vector and runs a number-parsing state machine over a string, and folds every result into a CRC-16 that
+# seeds the next iteration. Built for rv32i, so the multiplies are calls to __mulsi3. Prints the final CRC.
+    .equ ITERATIONS, 320
+    .equ DATA, 0x10000
+    .equ NODES, 32
+    .equ LIST, 0x000        # NODES x {next, data (16 bits), idx (16 bits)}
+    .equ MATA, 0x100        # 8 x 8 halfwords
+    .equ VECB, 0x180        # 8 halfwords
+    .equ MATC, 0x200        # 8 words
+    .equ STATE_IN, 0x400
+    .equ COUNTS, 0x500      # 8 words, one per final state
+    .equ LIST_HEAD, 0x600
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main
+    li a7, 1
+    ecall
+    li a7, 10
+    ecall
+
+main:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    call list_init
+    call matrix_init
+    addi a0, gp, STATE_IN
+    lla a1, state_input
+    call strcpy
+    li s0, ITERATIONS
+    li s1, 0                # crc
+1:  mv a0, s1
+    call bench_list
+    call bench_matrix
+    call bench_state
+    mv s1, a0
+    addi s0, s0, -1
+    bnez s0, 1b
+    mv a0, s1
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+    ret
+
+# the list nodes in order, with pseudo-random data
+list_init:
+    addi a0, gp, LIST
+    sw a0, LIST_HEAD(gp)
+    li a1, 0
+    li a2, 0x1234
+    li a3, NODES
+1:  slli a4, a2, 2
+    add a2, a2, a4
+    addi a2, a2, 0x3a7
+    slli a2, a2, 16
+    srli a2, a2, 16
+    sh a2, 4(a0)
+    sh a1, 6(a0)
+    addi a4, a0, 8
+    addi a1, a1, 1
+    bne a1, a3, 2f
+    li a4, 0
+2:  sw a4, 0(a0)
+    addi a0, a0, 8
+    bne a1, a3, 1b
+    ret
+
+# A and B get small pseudo-random values
+matrix_init:
+    addi a0, gp, MATA
+    li a1, 64 + 8
+    li a2, 0x2f1
+1:  slli a3, a2, 2
+    add a2, a2, a3
+    addi a2, a2, 0x3a7
+    slli a2, a2, 16
+    srli a2, a2, 16
+    andi a3, a2, 0x7f
+    sh a3, 0(a0)
+    addi a0, a0, 2
+    addi a1, a1, -1
+    bnez a1, 1b
+    ret
+
+# unsigned short bench_list(unsigned short crc)
+bench_list:
+    addi sp, sp, -32
+    sw ra, 28(sp)
+    sw s0, 24(sp)
+    sw s1, 20(sp)
+    sw s2, 16(sp)
+    sw s3, 12(sp)
+    mv s0, a0               # crc
+    li s1, 0                # i
+    li s3, 0                # sum of the found indices, minus the misses
+1:  lw a0, LIST_HEAD(gp)
+    slli a1, s1, 3
+    sub a1, a1, s1
+    add a1, a1, s0
+    andi a1, a1, 0xff
+    call list_find
+    beqz a0, 2f
+    lhu a0, 6(a0)
+    add s3, s3, a0
+    j 3f
+2:  addi s3, s3, -1
+3:  addi s1, s1, 1
+    li a0, 8
+    blt s1, a0, 1b
+    lw a0, LIST_HEAD(gp)
+    call list_reverse
+    sw a0, LIST_HEAD(gp)
+    mv s2, a0
+4:  beqz s2, 5f
+    lhu a0, 4(s2)
+    addi a1, a0, 1
+    sh a1, 4(s2)
+    mv a1, s0
+    call crcu16
+    mv s0, a0
+    lw s2, 0(s2)
+    j 4b
+5:  mv a0, s3
+    mv a1, s0
+    call crcu16
+    lw ra, 28(sp)
+    lw s0, 24(sp)
+    lw s1, 20(sp)
+    lw s2, 16(sp)
+    lw s3, 12(sp)
+    addi sp, sp, 32
+    ret
+
+# node *list_find(node *list, int value): the first node whose data has value in its low byte
+list_find:
+1:  beqz a0, 2f
+    lbu a2, 4(a0)
+    beq a2, a1, 2f
+    lw a0, 0(a0)
+    j 1b
+2:  ret
+
+# node *list_reverse(node *list)
+list_reverse:
+    li a1, 0
+1:  beqz a0, 2f
+    lw a2, 0(a0)
+    sw a1, 0(a0)
+    mv a1, a0
+    mv a0, a2
+    j 1b
+2:  mv a0, a1
+    ret
+
+# unsigned short bench_matrix(unsigned short crc): A += crc & 15, C = A * B, A -= crc & 15
+bench_matrix:
+    addi sp, sp, -32
+    sw ra, 28(sp)
+    sw s0, 24(sp)
+    sw s1, 20(sp)
+    sw s2, 16(sp)
+    sw s3, 12(sp)
+    sw s4, 8(sp)
+    sw s5, 4(sp)
+    mv s0, a0               # crc
+    andi s1, a0, 0xf
+    addi a0, gp, MATA
+    addi a1, a0, 128
+1:  lh a2, 0(a0)
+    add a2, a2, s1
+    sh a2, 0(a0)
+    addi a0, a0, 2
+    bne a0, a1, 1b
+    addi s2, gp, MATA       # row
+    addi s3, gp, MATC
+2:  li s4, 0                # sum
+    li s5, 0                # j
+3:  slli a0, s5, 1
+    add a1, s2, a0
+    lh a0, 0(a1)            # A[i][j]
+    slli a1, s5, 1
+    add a1, gp, a1
+    lh a1, VECB(a1)         # B[j]
+    call __mulsi3
+    add s4, s4, a0
+    addi s5, s5, 1
+    li a0, 8
+    blt s5, a0, 3b
+    sw s4, 0(s3)
+    mv a0, s4
+    mv a1, s0
+    call crcu16
+    mv s0, a0
+    addi s2, s2, 16
+    addi s3, s3, 4
+    addi a0, gp, VECB
+    bne s2, a0, 2b
+    addi a0, gp, MATA
+    addi a1, a0, 128
+4:  lh a2, 0(a0)
+    sub a2, a2, s1
+    sh a2, 0(a0)
+    addi a0, a0, 2
+    bne a0, a1, 4b
+    mv a0, s0
+    lw ra, 28(sp)
+    lw s0, 24(sp)
+    lw s1, 20(sp)
+    lw s2, 16(sp)
+    lw s3, 12(sp)
+    lw s4, 8(sp)
+    lw s5, 4(sp)
+    addi sp, sp, 32
+    ret
+
+# unsigned short bench_state(unsigned short crc): classify the comma-separated numbers of the input
+bench_state:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    sw s2, 0(sp)
+    mv s0, a0
+    addi a0, gp, COUNTS
+    addi a1, a0, 32
+1:  sw zero, 0(a0)
+    addi a0, a0, 4
+    bne a0, a1, 1b
+    addi s1, gp, STATE_IN
+2:  lbu a0, 0(s1)
+    beqz a0, 3f
+    mv a0, s1
+    call state_token
+    mv s1, a1
+    slli a0, a0, 2
+    add a0, gp, a0
+    lw a2, COUNTS(a0)
+    addi a2, a2, 1
+    sw a2, COUNTS(a0)
+    j 2b
+3:  li s2, 0
+4:  slli a0, s2, 2
+    add a0, gp, a0
+    lw a0, COUNTS(a0)
+    mv a1, s0
+    call crcu16
+    mv s0, a0
+    addi s2, s2, 1
+    li a0, 8
+    blt s2, a0, 4b
+    mv a0, s0
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    lw s2, 0(sp)
+    addi sp, sp, 16
+    ret
+
+# state_token(char *p): returns the final state in a0 and the start of the next token in a1.
+# States: 0 start, 1 invalid, 2 sign, 3 int, 4 float, 5 exponent, 6 exponent sign, 7 scientific.
+state_token:
+    li a2, 0
+    lla t0, .Lstates
+.Lnext:
+    lbu a3, 0(a0)
+    beqz a3, .Ldone
+    addi a0, a0, 1
+    li a4, ','
+    beq a3, a4, .Ldone
+    addi a5, a3, -'0'
+    sltiu a5, a5, 10        # digit
+    slli a4, a2, 2
+    add a4, t0, a4
+    jr a4                   # into the branch table below
+.Lstart:
+    bnez a5, .Lto_int
+    li a4, '+'
+    beq a3, a4, .Lto_sign
+    li a4, '-'
+    beq a3, a4, .Lto_sign
+    li a4, '.'
+    beq a3, a4, .Lto_float
+    j .Lto_invalid
+.Lsign:
+    bnez a5, .Lto_int
+    li a4, '.'
+    beq a3, a4, .Lto_float
+    j .Lto_invalid
+.Lint:
+    bnez a5, .Lnext
+    li a4, '.'
+    beq a3, a4, .Lto_float
+    j .Lto_invalid
+.Lfloat:
+    bnez a5, .Lnext
+    li a4, 'E'
+    beq a3, a4, .Lto_exp_sign
+    li a4, 'e'
+    beq a3, a4, .Lto_exp_sign
+    j .Lto_invalid
+.Lexp_sign:
+    li a4, '+'
+    beq a3, a4, .Lto_exp
+    li a4, '-'
+    beq a3, a4, .Lto_exp
+    j .Lto_invalid
+.Lexp:
+    bnez a5, .Lto_sci
+    j .Lto_invalid
+.Lsci:
+    bnez a5, .Lnext
+.Lto_invalid:
+    li a2, 1
+    j .Lnext
+.Lto_sign:
+    li a2, 2
+    j .Lnext
+.Lto_int:
+    li a2, 3
+    j .Lnext
+.Lto_float:
+    li a2, 4
+    j .Lnext
+.Lto_exp:
+    li a2, 5
+    j .Lnext
+.Lto_exp_sign:
+    li a2, 6
+    j .Lnext
+.Lto_sci:
+    li a2, 7
+    j .Lnext
+.Ldone:
+    mv a1, a0
+    mv a0, a2
+    ret
+    .option push
+    .option norvc           # 4-byte entries, also in the rv32ic build
+.Lstates:
+    j .Lstart
+    j .Lnext
+    j .Lsign
+    j .Lint
+    j .Lfloat
+    j .Lexp
+    j .Lexp_sign
+    j .Lsci
+    .option pop
+
+# unsigned short crcu8(unsigned char data, unsigned short crc)
+crcu8:
+    li a2, 8
+    li a4, 0x4002
+    li a5, 0x8000
+1:  xor a3, a0, a1
+    andi a3, a3, 1
+    srli a0, a0, 1
+    beqz a3, 2f
+    xor a1, a1, a4
+    srli a1, a1, 1
+    or a1, a1, a5
+    j 3f
+2:  srli a1, a1, 1
+3:  addi a2, a2, -1
+    bnez a2, 1b
+    mv a0, a1
+    ret
+
+# unsigned short crcu16(unsigned short value, unsigned short crc)
+crcu16:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    srli s0, a0, 8
+    andi s0, s0, 0xff
+    andi a0, a0, 0xff
+    call crcu8
+    mv a1, a0
+    mv a0, s0
+    call crcu8
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    addi sp, sp, 16
+    ret
+
+strcpy:
+    mv a2, a0
+1:  lbu a3, 0(a1)
+    sb a3, 0(a2)
+    addi a1, a1, 1
+    addi a2, a2, 1
+    bnez a3, 1b
+    ret
+
+__mulsi3:
+    mv a2, a0
+    li a0, 0
+1:  andi a3, a1, 1
+    beqz a3, 2f
+    add a0, a0, a2
+2:  srli a1, a1, 1
+    slli a2, a2, 1
+    bnez a1, 1b
+    ret
+
+state_input:
+    .asciz "5012,1234,-874,+122,35.54400,.1234500,-110.700,+0.64400,5.500e+3,-.123e-2,-87e+832,+0.6e-12,T0.3e-1F,-T.T++Tq,1T3.4e4z,34.0e-T^"
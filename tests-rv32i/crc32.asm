@@ -0,0 +1,90 @@
+
+crc32.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       8:      	lui	gp, 16
+       c:      	auipc	ra, 0
+      10:      	jalr	24(ra)
+      14:      	li	a7, 1
+      18:      	ecall	
+      1c:      	li	a7, 10
+      20:      	ecall	
+
+00000024 <main>:
+      24:      	addi	sp, sp, -16
+      28:      	sw	ra, 12(sp)
+      2c:      	sw	s0, 8(sp)
+      30:      	sw	s1, 4(sp)
+      34:      	auipc	ra, 0
+      38:      	jalr	128(ra)
+      3c:      	addi	a0, gp, 1024
+      40:      	li	a1, 1024
+      44:      	lui	a2, 152671
+      48:      	addi	a2, a2, 1169
+      4c:      	slli	a3, a2, 13
+      50:      	xor	a2, a2, a3
+      54:      	srli	a3, a2, 17
+      58:      	xor	a2, a2, a3
+      5c:      	slli	a3, a2, 5
+      60:      	xor	a2, a2, a3
+      64:      	sb	a2, 0(a0)
+      68:      	addi	a0, a0, 1
+      6c:      	addi	a1, a1, -1
+      70:      	bnez	a1, 0x4c <main+0x28>
+      74:      	li	s0, 500
+      78:      	li	s1, 0
+      7c:      	addi	a0, gp, 1024
+      80:      	li	a1, 1024
+      84:      	mv	a2, s1
+      88:      	auipc	ra, 0
+      8c:      	jalr	116(ra)
+      90:      	mv	s1, a0
+      94:      	addi	s0, s0, -1
+      98:      	bnez	s0, 0x7c <main+0x58>
+      9c:      	mv	a0, s1
+      a0:      	lw	ra, 12(sp)
+      a4:      	lw	s0, 8(sp)
+      a8:      	lw	s1, 4(sp)
+      ac:      	addi	sp, sp, 16
+      b0:      	ret
+
+000000b4 <crc32_init>:
+      b4:      	mv	a0, gp
+      b8:      	li	a1, 0
+      bc:      	lui	a5, 973704
+      c0:      	addi	a5, a5, 800
+      c4:      	mv	a2, a1
+      c8:      	li	a3, 8
+      cc:      	andi	a4, a2, 1
+      d0:      	srli	a2, a2, 1
+      d4:      	beqz	a4, 0xdc <crc32_init+0x28>
+      d8:      	xor	a2, a2, a5
+      dc:      	addi	a3, a3, -1
+      e0:      	bnez	a3, 0xcc <crc32_init+0x18>
+      e4:      	sw	a2, 0(a0)
+      e8:      	addi	a0, a0, 4
+      ec:      	addi	a1, a1, 1
+      f0:      	li	a3, 256
+      f4:      	bne	a1, a3, 0xc4 <crc32_init+0x10>
+      f8:      	ret
+
+000000fc <crc32>:
+      fc:      	not	a2, a2
+     100:      	beqz	a1, 0x130 <crc32+0x34>
+     104:      	add	a1, a0, a1
+     108:      	lbu	a3, 0(a0)
+     10c:      	xor	a3, a3, a2
+     110:      	andi	a3, a3, 255
+     114:      	slli	a3, a3, 2
+     118:      	add	a3, gp, a3
+     11c:      	lw	a3, 0(a3)
+     120:      	srli	a2, a2, 8
+     124:      	xor	a2, a2, a3
+     128:      	addi	a0, a0, 1
+     12c:      	bne	a0, a1, 0x108 <crc32+0xc>
+     130:      	not	a0, a2
+     134:      	ret
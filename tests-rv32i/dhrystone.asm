@@ -0,0 +1,484 @@
+
+dhrystone.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       8:      	lui	gp, 16
+       c:      	auipc	ra, 0
+      10:      	jalr	24(ra)
+      14:      	li	a7, 1
+      18:      	ecall	
+      1c:      	li	a7, 10
+      20:      	ecall	
+
+00000024 <main>:
+      24:      	addi	sp, sp, -32
+      28:      	sw	ra, 28(sp)
+      2c:      	sw	s0, 24(sp)
+      30:      	sw	s1, 20(sp)
+      34:      	sw	s2, 16(sp)
+      38:      	sw	s3, 12(sp)
+      3c:      	addi	a0, gp, 320
+      40:      	sw	a0, 16(gp)
+      44:      	addi	a1, gp, 256
+      48:      	sw	a1, 12(gp)
+      4c:      	sw	a0, 0(a1)
+      50:      	sw	zero, 4(a1)
+      54:      	li	a2, 2
+      58:      	sw	a2, 8(a1)
+      5c:      	li	a2, 40
+      60:      	sw	a2, 12(a1)
+      64:      	addi	a0, a1, 16
+      68:      	auipc	a1, 0
+      6c:      	addi	a1, a1, 1448
+      70:      	auipc	ra, 0
+      74:      	jalr	1240(ra)
+      78:      	addi	a0, gp, 64
+      7c:      	auipc	a1, 0
+      80:      	addi	a1, a1, 1459
+      84:      	auipc	ra, 0
+      88:      	jalr	1220(ra)
+      8c:      	lui	a0, 17
+      90:      	addi	a0, a0, -2020
+      94:      	li	a1, 10
+      98:      	sw	a1, 0(a0)
+      9c:      	li	s0, 1
+      a0:      	lui	s1, 2
+      a4:      	addi	s1, s1, -192
+      a8:      	auipc	ra, 0
+      ac:      	jalr	720(ra)
+      b0:      	auipc	ra, 0
+      b4:      	jalr	676(ra)
+      b8:      	li	a0, 2
+      bc:      	sw	a0, 0(sp)
+      c0:      	li	s2, 3
+      c4:      	addi	a0, gp, 96
+      c8:      	auipc	a1, 0
+      cc:      	addi	a1, a1, 1414
+      d0:      	auipc	ra, 0
+      d4:      	jalr	1144(ra)
+      d8:      	li	a0, 1
+      dc:      	sw	a0, 8(sp)
+      e0:      	addi	a0, gp, 64
+      e4:      	addi	a1, gp, 96
+      e8:      	auipc	ra, 0
+      ec:      	jalr	972(ra)
+      f0:      	seqz	a0, a0
+      f4:      	sw	a0, 4(gp)
+      f8:      	lw	a0, 0(sp)
+      fc:      	bge	a0, s2, 0x130 <main+0x10c>
+     100:      	slli	a2, a0, 2
+     104:      	add	a2, a2, a0
+     108:      	sub	a2, a2, s2
+     10c:      	sw	a2, 4(sp)
+     110:      	mv	a1, s2
+     114:      	addi	a2, sp, 4
+     118:      	auipc	ra, 0
+     11c:      	jalr	768(ra)
+     120:      	lw	a0, 0(sp)
+     124:      	addi	a0, a0, 1
+     128:      	sw	a0, 0(sp)
+     12c:      	j	0xfc <main+0xd8>
+     130:      	addi	a0, gp, 512
+     134:      	lui	a1, 16
+     138:      	addi	a1, a1, 1024
+     13c:      	lw	a2, 0(sp)
+     140:      	lw	a3, 4(sp)
+     144:      	auipc	ra, 0
+     148:      	jalr	740(ra)
+     14c:      	lw	a0, 12(gp)
+     150:      	auipc	ra, 0
+     154:      	jalr	260(ra)
+     158:      	li	s3, 65
+     15c:      	lbu	a0, 9(gp)
+     160:      	bltu	a0, s3, 0x1b0 <main+0x18c>
+     164:      	mv	a0, s3
+     168:      	li	a1, 67
+     16c:      	auipc	ra, 0
+     170:      	jalr	812(ra)
+     174:      	lw	a1, 8(sp)
+     178:      	bne	a0, a1, 0x1a8 <main+0x184>
+     17c:      	li	a0, 0
+     180:      	addi	a1, sp, 8
+     184:      	auipc	ra, 0
+     188:      	jalr	516(ra)
+     18c:      	addi	a0, gp, 96
+     190:      	auipc	a1, 0
+     194:      	addi	a1, a1, 1245
+     198:      	auipc	ra, 0
+     19c:      	jalr	944(ra)
+     1a0:      	mv	s2, s0
+     1a4:      	sw	s0, 0(gp)
+     1a8:      	addi	s3, s3, 1
+     1ac:      	j	0x15c <main+0x138>
+     1b0:      	mv	a0, s2
+     1b4:      	lw	a1, 0(sp)
+     1b8:      	auipc	ra, 0
+     1bc:      	jalr	1004(ra)
+     1c0:      	mv	s2, a0
+     1c4:      	lw	a1, 4(sp)
+     1c8:      	auipc	ra, 0
+     1cc:      	jalr	1024(ra)
+     1d0:      	sw	a0, 0(sp)
+     1d4:      	lw	a1, 4(sp)
+     1d8:      	sub	a1, s2, a1
+     1dc:      	slli	s2, a1, 3
+     1e0:      	sub	s2, s2, a1
+     1e4:      	sub	s2, s2, a0
+     1e8:      	mv	a0, sp
+     1ec:      	auipc	ra, 0
+     1f0:      	jalr	288(ra)
+     1f4:      	addi	s0, s0, 1
+     1f8:      	bge	s1, s0, 0xa8 <main+0x84>
+     1fc:      	lw	a0, 0(gp)
+     200:      	lw	a1, 0(sp)
+     204:      	add	a0, a0, a1
+     208:      	add	a0, a0, s2
+     20c:      	lw	a1, 4(sp)
+     210:      	add	a0, a0, a1
+     214:      	lw	a1, 8(sp)
+     218:      	add	a0, a0, a1
+     21c:      	lui	a1, 17
+     220:      	addi	a1, a1, -2020
+     224:      	lw	a1, 0(a1)
+     228:      	add	a0, a0, a1
+     22c:      	lw	a1, 16(gp)
+     230:      	lw	a1, 12(a1)
+     234:      	add	a0, a0, a1
+     238:      	lw	ra, 28(sp)
+     23c:      	lw	s0, 24(sp)
+     240:      	lw	s1, 20(sp)
+     244:      	lw	s2, 16(sp)
+     248:      	lw	s3, 12(sp)
+     24c:      	addi	sp, sp, 32
+     250:      	ret
+
+00000254 <proc_1>:
+     254:      	addi	sp, sp, -16
+     258:      	sw	ra, 12(sp)
+     25c:      	sw	s0, 8(sp)
+     260:      	sw	s1, 4(sp)
+     264:      	mv	s0, a0
+     268:      	lw	s1, 0(a0)
+     26c:      	mv	a0, s1
+     270:      	lw	a1, 12(gp)
+     274:      	li	a2, 48
+     278:      	auipc	ra, 0
+     27c:      	jalr	780(ra)
+     280:      	li	a0, 5
+     284:      	sw	a0, 12(s0)
+     288:      	sw	a0, 12(s1)
+     28c:      	lw	a0, 0(s0)
+     290:      	sw	a0, 0(s1)
+     294:      	mv	a0, s1
+     298:      	auipc	ra, 0
+     29c:      	jalr	156(ra)
+     2a0:      	lw	a0, 4(s1)
+     2a4:      	bnez	a0, 0x2e4 <proc_1+0x90>
+     2a8:      	li	a0, 6
+     2ac:      	sw	a0, 12(s1)
+     2b0:      	lw	a0, 8(s0)
+     2b4:      	addi	a1, s1, 8
+     2b8:      	auipc	ra, 0
+     2bc:      	jalr	208(ra)
+     2c0:      	lw	a0, 12(gp)
+     2c4:      	lw	a0, 0(a0)
+     2c8:      	sw	a0, 0(s1)
+     2cc:      	lw	a0, 12(s1)
+     2d0:      	li	a1, 10
+     2d4:      	addi	a2, s1, 12
+     2d8:      	auipc	ra, 0
+     2dc:      	jalr	320(ra)
+     2e0:      	j	0x2f8 <proc_1+0xa4>
+     2e4:      	mv	a0, s0
+     2e8:      	lw	a1, 0(s0)
+     2ec:      	li	a2, 48
+     2f0:      	auipc	ra, 0
+     2f4:      	jalr	660(ra)
+     2f8:      	lw	ra, 12(sp)
+     2fc:      	lw	s0, 8(sp)
+     300:      	lw	s1, 4(sp)
+     304:      	addi	sp, sp, 16
+     308:      	ret
+
+0000030c <proc_2>:
+     30c:      	lw	a1, 0(a0)
+     310:      	addi	a1, a1, 10
+     314:      	lbu	a2, 8(gp)
+     318:      	li	a3, 65
+     31c:      	bne	a2, a3, 0x31c <proc_2+0x10>
+     320:      	addi	a1, a1, -1
+     324:      	lw	a2, 0(gp)
+     328:      	sub	a1, a1, a2
+     32c:      	sw	a1, 0(a0)
+     330:      	ret
+
+00000334 <proc_3>:
+     334:      	lw	a1, 12(gp)
+     338:      	beqz	a1, 0x344 <proc_3+0x10>
+     33c:      	lw	a2, 0(a1)
+     340:      	sw	a2, 0(a0)
+     344:      	addi	a2, a1, 12
+     348:      	lw	a1, 0(gp)
+     34c:      	li	a0, 10
+     350:      	j	0x418 <proc_7>
+
+00000354 <proc_4>:
+     354:      	lbu	a0, 8(gp)
+     358:      	addi	a0, a0, -65
+     35c:      	seqz	a0, a0
+     360:      	lw	a1, 4(gp)
+     364:      	or	a0, a0, a1
+     368:      	sw	a0, 4(gp)
+     36c:      	li	a0, 66
+     370:      	sb	a0, 9(gp)
+     374:      	ret
+
+00000378 <proc_5>:
+     378:      	li	a0, 65
+     37c:      	sb	a0, 8(gp)
+     380:      	sw	zero, 4(gp)
+     384:      	ret
+
+00000388 <proc_6>:
+     388:      	addi	sp, sp, -16
+     38c:      	sw	ra, 12(sp)
+     390:      	sw	s0, 8(sp)
+     394:      	sw	s1, 4(sp)
+     398:      	mv	s0, a0
+     39c:      	mv	s1, a1
+     3a0:      	sw	a0, 0(a1)
+     3a4:      	auipc	ra, 0
+     3a8:      	jalr	408(ra)
+     3ac:      	bnez	a0, 0x3b8 <proc_6+0x30>
+     3b0:      	li	a0, 3
+     3b4:      	sw	a0, 0(s1)
+     3b8:      	beqz	s0, 0x3dc <proc_6+0x54>
+     3bc:      	li	a0, 1
+     3c0:      	beq	s0, a0, 0x3e4 <proc_6+0x5c>
+     3c4:      	li	a0, 2
+     3c8:      	beq	s0, a0, 0x3fc <proc_6+0x74>
+     3cc:      	li	a0, 4
+     3d0:      	bne	s0, a0, 0x404 <proc_6+0x7c>
+     3d4:      	li	a0, 2
+     3d8:      	j	0x400 <proc_6+0x78>
+     3dc:      	li	a0, 0
+     3e0:      	j	0x400 <proc_6+0x78>
+     3e4:      	lw	a1, 0(gp)
+     3e8:      	li	a2, 100
+     3ec:      	li	a0, 0
+     3f0:      	blt	a2, a1, 0x400 <proc_6+0x78>
+     3f4:      	li	a0, 3
+     3f8:      	j	0x400 <proc_6+0x78>
+     3fc:      	li	a0, 1
+     400:      	sw	a0, 0(s1)
+     404:      	lw	ra, 12(sp)
+     408:      	lw	s0, 8(sp)
+     40c:      	lw	s1, 4(sp)
+     410:      	addi	sp, sp, 16
+     414:      	ret
+
+00000418 <proc_7>:
+     418:      	addi	a0, a0, 2
+     41c:      	add	a0, a0, a1
+     420:      	sw	a0, 0(a2)
+     424:      	ret
+
+00000428 <proc_8>:
+     428:      	addi	a4, a2, 5
+     42c:      	slli	a5, a4, 2
+     430:      	add	a5, a0, a5
+     434:      	sw	a3, 0(a5)
+     438:      	sw	a3, 4(a5)
+     43c:      	sw	a4, 120(a5)
+     440:      	slli	a6, a4, 7
+     444:      	add	a6, a1, a6
+     448:      	mv	t0, a4
+     44c:      	addi	t1, a4, 1
+     450:      	slli	t2, t0, 2
+     454:      	add	t2, a6, t2
+     458:      	sw	a4, 0(t2)
+     45c:      	addi	t0, t0, 1
+     460:      	bge	t1, t0, 0x450 <proc_8+0x28>
+     464:      	slli	t2, a4, 2
+     468:      	add	t2, a6, t2
+     46c:      	lw	t0, -4(t2)
+     470:      	addi	t0, t0, 1
+     474:      	sw	t0, -4(t2)
+     478:      	lw	t0, 0(a5)
+     47c:      	lui	t1, 1
+     480:      	addi	t1, t1, -1536
+     484:      	add	t2, t2, t1
+     488:      	sw	t0, 0(t2)
+     48c:      	li	t0, 5
+     490:      	sw	t0, 0(gp)
+     494:      	ret
+
+00000498 <func_1>:
+     498:      	andi	a0, a0, 255
+     49c:      	bne	a0, a1, 0x4ac <func_1+0x14>
+     4a0:      	sb	a0, 8(gp)
+     4a4:      	li	a0, 1
+     4a8:      	ret
+     4ac:      	li	a0, 0
+     4b0:      	ret
+
+000004b4 <func_2>:
+     4b4:      	addi	sp, sp, -16
+     4b8:      	sw	ra, 12(sp)
+     4bc:      	sw	s0, 8(sp)
+     4c0:      	sw	s1, 4(sp)
+     4c4:      	sw	s2, 0(sp)
+     4c8:      	mv	s0, a0
+     4cc:      	mv	s1, a1
+     4d0:      	li	s2, 2
+     4d4:      	add	a0, s0, s2
+     4d8:      	lbu	a0, 0(a0)
+     4dc:      	add	a1, s1, s2
+     4e0:      	lbu	a1, 1(a1)
+     4e4:      	auipc	ra, 0
+     4e8:      	jalr	-76(ra)
+     4ec:      	bnez	a0, 0x4d4 <func_2+0x20>
+     4f0:      	addi	s2, s2, 1
+     4f4:      	li	a0, 2
+     4f8:      	bge	a0, s2, 0x4d4 <func_2+0x20>
+     4fc:      	mv	a0, s0
+     500:      	mv	a1, s1
+     504:      	auipc	ra, 0
+     508:      	jalr	96(ra)
+     50c:      	blez	a0, 0x520 <func_2+0x6c>
+     510:      	li	a0, 10
+     514:      	sw	a0, 0(gp)
+     518:      	li	a0, 1
+     51c:      	j	0x524 <func_2+0x70>
+     520:      	li	a0, 0
+     524:      	lw	ra, 12(sp)
+     528:      	lw	s0, 8(sp)
+     52c:      	lw	s1, 4(sp)
+     530:      	lw	s2, 0(sp)
+     534:      	addi	sp, sp, 16
+     538:      	ret
+
+0000053c <func_3>:
+     53c:      	addi	a0, a0, -2
+     540:      	seqz	a0, a0
+     544:      	ret
+
+00000548 <strcpy>:
+     548:      	mv	a2, a0
+     54c:      	lbu	a3, 0(a1)
+     550:      	sb	a3, 0(a2)
+     554:      	addi	a1, a1, 1
+     558:      	addi	a2, a2, 1
+     55c:      	bnez	a3, 0x54c <strcpy+0x4>
+     560:      	ret
+
+00000564 <strcmp>:
+     564:      	lbu	a2, 0(a0)
+     568:      	lbu	a3, 0(a1)
+     56c:      	addi	a0, a0, 1
+     570:      	addi	a1, a1, 1
+     574:      	bne	a2, a3, 0x57c <strcmp+0x18>
+     578:      	bnez	a2, 0x564 <strcmp>
+     57c:      	sub	a0, a2, a3
+     580:      	ret
+
+00000584 <memcpy>:
+     584:      	mv	a3, a0
+     588:      	add	a2, a1, a2
+     58c:      	lw	a4, 0(a1)
+     590:      	sw	a4, 0(a3)
+     594:      	addi	a1, a1, 4
+     598:      	addi	a3, a3, 4
+     59c:      	bltu	a1, a2, 0x58c <memcpy+0x8>
+     5a0:      	ret
+
+000005a4 <__mulsi3>:
+     5a4:      	mv	a2, a0
+     5a8:      	li	a0, 0
+     5ac:      	andi	a3, a1, 1
+     5b0:      	beqz	a3, 0x5b8 <__mulsi3+0x14>
+     5b4:      	add	a0, a0, a2
+     5b8:      	srli	a1, a1, 1
+     5bc:      	slli	a2, a2, 1
+     5c0:      	bnez	a1, 0x5ac <__mulsi3+0x8>
+     5c4:      	ret
+
+000005c8 <__udivsi3>:
+     5c8:      	mv	a2, a1
+     5cc:      	mv	a1, a0
+     5d0:      	li	a0, -1
+     5d4:      	beqz	a2, 0x60c <__udivsi3+0x44>
+     5d8:      	li	a3, 1
+     5dc:      	bgeu	a2, a1, 0x5f0 <__udivsi3+0x28>
+     5e0:      	blez	a2, 0x5f0 <__udivsi3+0x28>
+     5e4:      	slli	a2, a2, 1
+     5e8:      	slli	a3, a3, 1
+     5ec:      	bltu	a2, a1, 0x5e0 <__udivsi3+0x18>
+     5f0:      	li	a0, 0
+     5f4:      	bltu	a1, a2, 0x600 <__udivsi3+0x38>
+     5f8:      	sub	a1, a1, a2
+     5fc:      	or	a0, a0, a3
+     600:      	srli	a3, a3, 1
+     604:      	srli	a2, a2, 1
+     608:      	bnez	a3, 0x5f4 <__udivsi3+0x2c>
+     60c:      	ret
+
+00000610 <some_string>:
+     610:      	<unknown>
+     612:      	<unknown>
+     614:      	<unknown>
+     618:      	<unknown>
+     61a:      	<unknown>
+     61c:      	<unknown>
+     620:      	<unknown>
+     622:      	<unknown>
+     624:      	<unknown>
+     628:      	<unknown>
+     62c:      	<unknown>
+     62e:      	<unknown>
+
+0000062f <first_string>:
+     62f:      	<unknown>
+     631:      	<unknown>
+     633:      	<unknown>
+     637:      	<unknown>
+     639:      	<unknown>
+     63b:      	<unknown>
+     63f:      	<unknown>
+     641:      	<unknown>
+     643:      	<unknown>
+     647:      	<unknown>
+     64b:      	<unknown>
+     64d:      	<unknown>
+
+0000064e <second_string>:
+     64e:      	<unknown>
+     650:      	<unknown>
+     652:      	<unknown>
+     656:      	<unknown>
+     658:      	<unknown>
+     65a:      	<unknown>
+     65e:      	<unknown>
+     660:      	<unknown>
+     662:      	<unknown>
+     666:      	<unknown>
+     66a:      	<unknown>
+     66c:      	<unknown>
+
+0000066d <third_string>:
+     66d:      	<unknown>
+     66f:      	<unknown>
+     671:      	<unknown>
+     675:      	<unknown>
+     677:      	<unknown>
+     679:      	<unknown>
+     67d:      	<unknown>
+     67f:      	<unknown>
+     681:      	<unknown>
+     685:      	<unknown>
+     689:      	<unknown>
+     68b:      	<unknown>
@@ -0,0 +1,127 @@
+
+matmult.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       8:      	lui	gp, 16
+       c:      	auipc	ra, 0
+      10:      	jalr	24(ra)
+      14:      	li	a7, 1
+      18:      	ecall	
+      1c:      	li	a7, 10
+      20:      	ecall	
+
+00000024 <main>:
+      24:      	addi	sp, sp, -16
+      28:      	sw	ra, 12(sp)
+      2c:      	sw	s0, 8(sp)
+      30:      	sw	s1, 4(sp)
+      34:      	mv	a0, gp
+      38:      	li	a1, 800
+      3c:      	lui	a2, 152671
+      40:      	addi	a2, a2, 1169
+      44:      	li	a4, 1023
+      48:      	slli	a3, a2, 13
+      4c:      	xor	a2, a2, a3
+      50:      	srli	a3, a2, 17
+      54:      	xor	a2, a2, a3
+      58:      	slli	a3, a2, 5
+      5c:      	xor	a2, a2, a3
+      60:      	and	a3, a2, a4
+      64:      	li	a5, 400
+      68:      	blt	a5, a1, 0x70 <main+0x4c>
+      6c:      	andi	a3, a3, 63
+      70:      	sw	a3, 0(a0)
+      74:      	addi	a0, a0, 4
+      78:      	addi	a1, a1, -1
+      7c:      	bnez	a1, 0x48 <main+0x24>
+      80:      	li	s0, 15
+      84:      	li	s1, 0
+      88:      	mv	a0, gp
+      8c:      	lui	a1, 16
+      90:      	addi	a1, a1, 1600
+      94:      	lui	a2, 17
+      98:      	addi	a2, a2, -896
+      9c:      	auipc	ra, 0
+      a0:      	jalr	84(ra)
+      a4:      	lui	a0, 17
+      a8:      	addi	a0, a0, -896
+      ac:      	li	a1, 400
+      b0:      	lw	a2, 0(a0)
+      b4:      	add	s1, s1, a2
+      b8:      	addi	a0, a0, 4
+      bc:      	addi	a1, a1, -1
+      c0:      	bnez	a1, 0xb0 <main+0x8c>
+      c4:      	lw	a0, 0(gp)
+      c8:      	addi	a0, a0, 1
+      cc:      	sw	a0, 0(gp)
+      d0:      	addi	s0, s0, -1
+      d4:      	bnez	s0, 0x88 <main+0x64>
+      d8:      	mv	a0, s1
+      dc:      	lw	ra, 12(sp)
+      e0:      	lw	s0, 8(sp)
+      e4:      	lw	s1, 4(sp)
+      e8:      	addi	sp, sp, 16
+      ec:      	ret
+
+000000f0 <matmult>:
+      f0:      	addi	sp, sp, -48
+      f4:      	sw	ra, 44(sp)
+      f8:      	sw	s0, 40(sp)
+      fc:      	sw	s1, 36(sp)
+     100:      	sw	s2, 32(sp)
+     104:      	sw	s3, 28(sp)
+     108:      	sw	s4, 24(sp)
+     10c:      	sw	s5, 20(sp)
+     110:      	sw	s6, 16(sp)
+     114:      	sw	s7, 12(sp)
+     118:      	mv	s0, a0
+     11c:      	mv	s1, a1
+     120:      	mv	s2, a2
+     124:      	addi	s7, a0, 1600
+     128:      	li	s3, 0
+     12c:      	li	s4, 0
+     130:      	mv	s5, s0
+     134:      	slli	a0, s3, 2
+     138:      	add	s6, s1, a0
+     13c:      	lw	a0, 0(s5)
+     140:      	lw	a1, 0(s6)
+     144:      	auipc	ra, 0
+     148:      	jalr	100(ra)
+     14c:      	add	s4, s4, a0
+     150:      	addi	s5, s5, 4
+     154:      	addi	s6, s6, 80
+     158:      	addi	a0, s0, 80
+     15c:      	bne	s5, a0, 0x13c <matmult+0x4c>
+     160:      	sw	s4, 0(s2)
+     164:      	addi	s2, s2, 4
+     168:      	addi	s3, s3, 1
+     16c:      	li	a0, 20
+     170:      	bne	s3, a0, 0x12c <matmult+0x3c>
+     174:      	addi	s0, s0, 80
+     178:      	bne	s0, s7, 0x128 <matmult+0x38>
+     17c:      	lw	ra, 44(sp)
+     180:      	lw	s0, 40(sp)
+     184:      	lw	s1, 36(sp)
+     188:      	lw	s2, 32(sp)
+     18c:      	lw	s3, 28(sp)
+     190:      	lw	s4, 24(sp)
+     194:      	lw	s5, 20(sp)
+     198:      	lw	s6, 16(sp)
+     19c:      	lw	s7, 12(sp)
+     1a0:      	addi	sp, sp, 48
+     1a4:      	ret
+
+000001a8 <__mulsi3>:
+     1a8:      	mv	a2, a0
+     1ac:      	li	a0, 0
+     1b0:      	andi	a3, a1, 1
+     1b4:      	beqz	a3, 0x1bc <__mulsi3+0x14>
+     1b8:      	add	a0, a0, a2
+     1bc:      	srli	a1, a1, 1
+     1c0:      	slli	a2, a2, 1
+     1c4:      	bnez	a1, 0x1b0 <__mulsi3+0x8>
+     1c8:      	ret
@@ -0,0 +1,110 @@
+
+qsort.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       8:      	lui	gp, 16
+       c:      	auipc	ra, 0
+      10:      	jalr	24(ra)
+      14:      	li	a7, 1
+      18:      	ecall	
+      1c:      	li	a7, 10
+      20:      	ecall	
+
+00000024 <main>:
+      24:      	addi	sp, sp, -16
+      28:      	sw	ra, 12(sp)
+      2c:      	sw	s0, 8(sp)
+      30:      	sw	s1, 4(sp)
+      34:      	sw	s2, 0(sp)
+      38:      	li	s0, 100
+      3c:      	lui	s1, 152671
+      40:      	addi	s1, s1, 1169
+      44:      	li	s2, 0
+      48:      	mv	a0, gp
+      4c:      	li	a1, 512
+      50:      	slli	a2, s1, 13
+      54:      	xor	s1, s1, a2
+      58:      	srli	a2, s1, 17
+      5c:      	xor	s1, s1, a2
+      60:      	slli	a2, s1, 5
+      64:      	xor	s1, s1, a2
+      68:      	sw	s1, 0(a0)
+      6c:      	addi	a0, a0, 4
+      70:      	addi	a1, a1, -1
+      74:      	bnez	a1, 0x50 <main+0x2c>
+      78:      	mv	a0, gp
+      7c:      	addi	a1, a0, 2044
+      80:      	auipc	ra, 0
+      84:      	jalr	104(ra)
+      88:      	mv	a0, gp
+      8c:      	addi	a1, a0, 2044
+      90:      	lw	a2, 0(a0)
+      94:      	slli	a3, s2, 1
+      98:      	srli	s2, s2, 31
+      9c:      	or	s2, s2, a3
+      a0:      	xor	s2, s2, a2
+      a4:      	beq	a0, a1, 0xbc <main+0x98>
+      a8:      	addi	a0, a0, 4
+      ac:      	lw	a3, 0(a0)
+      b0:      	blt	a3, a2, 0xcc <main+0xa8>
+      b4:      	mv	a2, a3
+      b8:      	j	0x94 <main+0x70>
+      bc:      	addi	s0, s0, -1
+      c0:      	bnez	s0, 0x48 <main+0x24>
+      c4:      	mv	a0, s2
+      c8:      	j	0xd0 <main+0xac>
+      cc:      	li	a0, -1
+      d0:      	lw	ra, 12(sp)
+      d4:      	lw	s0, 8(sp)
+      d8:      	lw	s1, 4(sp)
+      dc:      	lw	s2, 0(sp)
+      e0:      	addi	sp, sp, 16
+      e4:      	ret
+
+000000e8 <quicksort>:
+      e8:      	bgeu	a0, a1, 0x18c <quicksort+0xa4>
+      ec:      	addi	sp, sp, -16
+      f0:      	sw	ra, 12(sp)
+      f4:      	sw	s0, 8(sp)
+      f8:      	sw	s1, 4(sp)
+      fc:      	mv	s0, a0
+     100:      	mv	s1, a1
+     104:      	sub	a2, a1, a0
+     108:      	srli	a2, a2, 3
+     10c:      	slli	a2, a2, 2
+     110:      	add	a2, a0, a2
+     114:      	lw	a2, 0(a2)
+     118:      	mv	a3, a0
+     11c:      	mv	a4, a1
+     120:      	lw	a5, 0(a3)
+     124:      	bge	a5, a2, 0x130 <quicksort+0x48>
+     128:      	addi	a3, a3, 4
+     12c:      	j	0x120 <quicksort+0x38>
+     130:      	lw	a6, 0(a4)
+     134:      	bge	a2, a6, 0x140 <quicksort+0x58>
+     138:      	addi	a4, a4, -4
+     13c:      	j	0x130 <quicksort+0x48>
+     140:      	bltu	a4, a3, 0x158 <quicksort+0x70>
+     144:      	sw	a6, 0(a3)
+     148:      	sw	a5, 0(a4)
+     14c:      	addi	a3, a3, 4
+     150:      	addi	a4, a4, -4
+     154:      	bgeu	a4, a3, 0x120 <quicksort+0x38>
+     158:      	sw	a3, 0(sp)
+     15c:      	mv	a0, s0
+     160:      	mv	a1, a4
+     164:      	auipc	ra, 0
+     168:      	jalr	-124(ra)
+     16c:      	lw	a0, 0(sp)
+     170:      	mv	a1, s1
+     174:      	auipc	ra, 0
+     178:      	jalr	-140(ra)
+     17c:      	lw	ra, 12(sp)
+     180:      	lw	s0, 8(sp)
+     184:      	lw	s1, 4(sp)
+     188:      	addi	sp, sp, 16
+     18c:      	ret
@@ -0,0 +1,110 @@
+# Sorting benchmark: 512 pseudo-random words are sorted with a recursive quicksort (middle pivot, Hoare
+# partition), checked and folded into a checksum, then refilled for the next pass. Prints the checksum, or -1
+# if a pass did not come out sorted.
+    .equ PASSES, 100
+    .equ DATA, 0x10000
+    .equ ARRAY, 0x000
+    .equ COUNT, 512
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main
+    li a7, 1
+    ecall
+    li a7, 10
+    ecall
+
+main:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    sw s2, 0(sp)
+    li s0, PASSES
+    li s1, 0x2545f491       # xorshift32 state
+    li s2, 0                # checksum
+1:  addi a0, gp, ARRAY
+    li a1, COUNT
+2:  slli a2, s1, 13
+    xor s1, s1, a2
+    srli a2, s1, 17
+    xor s1, s1, a2
+    slli a2, s1, 5
+    xor s1, s1, a2
+    sw s1, 0(a0)
+    addi a0, a0, 4
+    addi a1, a1, -1
+    bnez a1, 2b
+    addi a0, gp, ARRAY
+    addi a1, a0, (COUNT - 1) * 4
+    call quicksort
+    # sorted check, and checksum = rotate-left-by-one and xor of every element
+    addi a0, gp, ARRAY
+    addi a1, a0, (COUNT - 1) * 4
+    lw a2, 0(a0)
+3:  slli a3, s2, 1
+    srli s2, s2, 31
+    or s2, s2, a3
+    xor s2, s2, a2
+    beq a0, a1, 4f
+    addi a0, a0, 4
+    lw a3, 0(a0)
+    bgt a2, a3, 5f
+    mv a2, a3
+    j 3b
+4:  addi s0, s0, -1
+    bnez s0, 1b
+    mv a0, s2
+    j 6f
+5:  li a0, -1
+6:  lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    lw s2, 0(sp)
+    addi sp, sp, 16
+    ret
+
+# void quicksort(int *lo, int *hi): sorts lo[0] up to and including *hi
+quicksort:
+    bgeu a0, a1, 5f
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    mv s0, a0
+    mv s1, a1
+    sub a2, a1, a0
+    srli a2, a2, 3
+    slli a2, a2, 2
+    add a2, a0, a2
+    lw a2, 0(a2)            # pivot
+    mv a3, a0               # i
+    mv a4, a1               # j
+1:  lw a5, 0(a3)
+    bge a5, a2, 2f
+    addi a3, a3, 4
+    j 1b
+2:  lw a6, 0(a4)
+    ble a6, a2, 3f
+    addi a4, a4, -4
+    j 2b
+3:  bgtu a3, a4, 4f
+    sw a6, 0(a3)
+    sw a5, 0(a4)
+    addi a3, a3, 4
+    addi a4, a4, -4
+    bleu a3, a4, 1b
+4:  sw a3, 0(sp)
+    mv a0, s0
+    mv a1, a4
+    call quicksort
+    lw a0, 0(sp)
+    mv a1, s1
+    call quicksort
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+5:  ret
@@ -0,0 +1,449 @@
+
+coremark.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       6:      	lui	gp, 16
+       8:      	auipc	ra, 0
+       c:      	jalr	20(ra)
+      10:      	li	a7, 1
+      12:      	ecall	
+      16:      	li	a7, 10
+      18:      	ecall	
+
+0000001c <main>:
+      1c:      	addi	sp, sp, -16
+      1e:      	sw	ra, 12(sp)
+      20:      	sw	s0, 8(sp)
+      22:      	sw	s1, 4(sp)
+      24:      	auipc	ra, 0
+      28:      	jalr	86(ra)
+      2c:      	auipc	ra, 0
+      30:      	jalr	140(ra)
+      34:      	addi	a0, gp, 1024
+      38:      	auipc	a1, 0
+      3c:      	addi	a1, a1, 954
+      40:      	auipc	ra, 0
+      44:      	jalr	908(ra)
+      48:      	li	s0, 320
+      4c:      	li	s1, 0
+      4e:      	mv	a0, s1
+      50:      	auipc	ra, 0
+      54:      	jalr	146(ra)
+      58:      	auipc	ra, 0
+      5c:      	jalr	312(ra)
+      60:      	auipc	ra, 0
+      64:      	jalr	476(ra)
+      68:      	mv	s1, a0
+      6a:      	addi	s0, s0, -1
+      6c:      	bnez	s0, 0x4e <main+0x32>
+      6e:      	mv	a0, s1
+      70:      	lw	ra, 12(sp)
+      72:      	lw	s0, 8(sp)
+      74:      	lw	s1, 4(sp)
+      76:      	addi	sp, sp, 16
+      78:      	ret
+
+0000007a <list_init>:
+      7a:      	mv	a0, gp
+      7c:      	sw	a0, 1536(gp)
+      80:      	li	a1, 0
+      82:      	lui	a2, 1
+      84:      	addi	a2, a2, 564
+      88:      	li	a3, 32
+      8c:      	slli	a4, a2, 2
+      90:      	add	a2, a2, a4
+      92:      	addi	a2, a2, 935
+      96:      	slli	a2, a2, 16
+      98:      	srli	a2, a2, 16
+      9a:      	sh	a2, 4(a0)
+      9e:      	sh	a1, 6(a0)
+      a2:      	addi	a4, a0, 8
+      a6:      	addi	a1, a1, 1
+      a8:      	bne	a1, a3, 0xae <list_init+0x34>
+      ac:      	li	a4, 0
+      ae:      	sw	a4, 0(a0)
+      b0:      	addi	a0, a0, 8
+      b2:      	bne	a1, a3, 0x8c <list_init+0x12>
+      b6:      	ret
+
+000000b8 <matrix_init>:
+      b8:      	addi	a0, gp, 256
+      bc:      	li	a1, 72
+      c0:      	li	a2, 753
+      c4:      	slli	a3, a2, 2
+      c8:      	add	a2, a2, a3
+      ca:      	addi	a2, a2, 935
+      ce:      	slli	a2, a2, 16
+      d0:      	srli	a2, a2, 16
+      d2:      	andi	a3, a2, 127
+      d6:      	sh	a3, 0(a0)
+      da:      	addi	a0, a0, 2
+      dc:      	addi	a1, a1, -1
+      de:      	bnez	a1, 0xc4 <matrix_init+0xc>
+      e0:      	ret
+
+000000e2 <bench_list>:
+      e2:      	addi	sp, sp, -32
+      e4:      	sw	ra, 28(sp)
+      e6:      	sw	s0, 24(sp)
+      e8:      	sw	s1, 20(sp)
+      ea:      	sw	s2, 16(sp)
+      ec:      	sw	s3, 12(sp)
+      ee:      	mv	s0, a0
+      f0:      	li	s1, 0
+      f2:      	li	s3, 0
+      f4:      	lw	a0, 1536(gp)
+      f8:      	slli	a1, s1, 3
+      fc:      	sub	a1, a1, s1
+      fe:      	add	a1, a1, s0
+     100:      	andi	a1, a1, 255
+     104:      	auipc	ra, 0
+     108:      	jalr	106(ra)
+     10c:      	beqz	a0, 0x116 <bench_list+0x34>
+     10e:      	lhu	a0, 6(a0)
+     112:      	add	s3, s3, a0
+     114:      	j	0x118 <bench_list+0x36>
+     116:      	addi	s3, s3, -1
+     118:      	addi	s1, s1, 1
+     11a:      	li	a0, 8
+     11c:      	blt	s1, a0, 0xf4 <bench_list+0x12>
+     120:      	lw	a0, 1536(gp)
+     124:      	auipc	ra, 0
+     128:      	jalr	90(ra)
+     12c:      	sw	a0, 1536(gp)
+     130:      	mv	s2, a0
+     132:      	beqz	s2, 0x154 <bench_list+0x72>
+     136:      	lhu	a0, 4(s2)
+     13a:      	addi	a1, a0, 1
+     13e:      	sh	a1, 4(s2)
+     142:      	mv	a1, s0
+     144:      	auipc	ra, 0
+     148:      	jalr	602(ra)
+     14c:      	mv	s0, a0
+     14e:      	lw	s2, 0(s2)
+     152:      	j	0x132 <bench_list+0x50>
+     154:      	mv	a0, s3
+     156:      	mv	a1, s0
+     158:      	auipc	ra, 0
+     15c:      	jalr	582(ra)
+     160:      	lw	ra, 28(sp)
+     162:      	lw	s0, 24(sp)
+     164:      	lw	s1, 20(sp)
+     166:      	lw	s2, 16(sp)
+     168:      	lw	s3, 12(sp)
+     16a:      	addi	sp, sp, 32
+     16c:      	ret
+
+0000016e <list_find>:
+     16e:      	beqz	a0, 0x17c <list_find+0xe>
+     170:      	lbu	a2, 4(a0)
+     174:      	beq	a2, a1, 0x17c <list_find+0xe>
+     178:      	lw	a0, 0(a0)
+     17a:      	j	0x16e <list_find>
+     17c:      	ret
+
+0000017e <list_reverse>:
+     17e:      	li	a1, 0
+     180:      	beqz	a0, 0x18c <list_reverse+0xe>
+     182:      	lw	a2, 0(a0)
+     184:      	sw	a1, 0(a0)
+     186:      	mv	a1, a0
+     188:      	mv	a0, a2
+     18a:      	j	0x180 <list_reverse+0x2>
+     18c:      	mv	a0, a1
+     18e:      	ret
+
+00000190 <bench_matrix>:
+     190:      	addi	sp, sp, -32
+     192:      	sw	ra, 28(sp)
+     194:      	sw	s0, 24(sp)
+     196:      	sw	s1, 20(sp)
+     198:      	sw	s2, 16(sp)
+     19a:      	sw	s3, 12(sp)
+     19c:      	sw	s4, 8(sp)
+     19e:      	sw	s5, 4(sp)
+     1a0:      	mv	s0, a0
+     1a2:      	andi	s1, a0, 15
+     1a6:      	addi	a0, gp, 256
+     1aa:      	addi	a1, a0, 128
+     1ae:      	lh	a2, 0(a0)
+     1b2:      	add	a2, a2, s1
+     1b4:      	sh	a2, 0(a0)
+     1b8:      	addi	a0, a0, 2
+     1ba:      	bne	a0, a1, 0x1ae <bench_matrix+0x1e>
+     1be:      	addi	s2, gp, 256
+     1c2:      	addi	s3, gp, 512
+     1c6:      	li	s4, 0
+     1c8:      	li	s5, 0
+     1ca:      	slli	a0, s5, 1
+     1ce:      	add	a1, s2, a0
+     1d2:      	lh	a0, 0(a1)
+     1d6:      	slli	a1, s5, 1
+     1da:      	add	a1, a1, gp
+     1dc:      	lh	a1, 384(a1)
+     1e0:      	auipc	ra, 0
+     1e4:      	jalr	510(ra)
+     1e8:      	add	s4, s4, a0
+     1ea:      	addi	s5, s5, 1
+     1ec:      	li	a0, 8
+     1ee:      	blt	s5, a0, 0x1ca <bench_matrix+0x3a>
+     1f2:      	sw	s4, 0(s3)
+     1f6:      	mv	a0, s4
+     1f8:      	mv	a1, s0
+     1fa:      	auipc	ra, 0
+     1fe:      	jalr	420(ra)
+     202:      	mv	s0, a0
+     204:      	addi	s2, s2, 16
+     206:      	addi	s3, s3, 4
+     208:      	addi	a0, gp, 384
+     20c:      	bne	s2, a0, 0x1c6 <bench_matrix+0x36>
+     210:      	addi	a0, gp, 256
+     214:      	addi	a1, a0, 128
+     218:      	lh	a2, 0(a0)
+     21c:      	sub	a2, a2, s1
+     21e:      	sh	a2, 0(a0)
+     222:      	addi	a0, a0, 2
+     224:      	bne	a0, a1, 0x218 <bench_matrix+0x88>
+     228:      	mv	a0, s0
+     22a:      	lw	ra, 28(sp)
+     22c:      	lw	s0, 24(sp)
+     22e:      	lw	s1, 20(sp)
+     230:      	lw	s2, 16(sp)
+     232:      	lw	s3, 12(sp)
+     234:      	lw	s4, 8(sp)
+     236:      	lw	s5, 4(sp)
+     238:      	addi	sp, sp, 32
+     23a:      	ret
+
+0000023c <bench_state>:
+     23c:      	addi	sp, sp, -16
+     23e:      	sw	ra, 12(sp)
+     240:      	sw	s0, 8(sp)
+     242:      	sw	s1, 4(sp)
+     244:      	sw	s2, 0(sp)
+     246:      	mv	s0, a0
+     248:      	addi	a0, gp, 1280
+     24c:      	addi	a1, a0, 32
+     250:      	sw	zero, 0(a0)
+     254:      	addi	a0, a0, 4
+     256:      	bne	a0, a1, 0x250 <bench_state+0x14>
+     25a:      	addi	s1, gp, 1024
+     25e:      	lbu	a0, 0(s1)
+     262:      	beqz	a0, 0x280 <bench_state+0x44>
+     264:      	mv	a0, s1
+     266:      	auipc	ra, 0
+     26a:      	jalr	72(ra)
+     26e:      	mv	s1, a1
+     270:      	slli	a0, a0, 2
+     272:      	add	a0, a0, gp
+     274:      	lw	a2, 1280(a0)
+     278:      	addi	a2, a2, 1
+     27a:      	sw	a2, 1280(a0)
+     27e:      	j	0x25e <bench_state+0x22>
+     280:      	li	s2, 0
+     282:      	slli	a0, s2, 2
+     286:      	add	a0, a0, gp
+     288:      	lw	a0, 1280(a0)
+     28c:      	mv	a1, s0
+     28e:      	auipc	ra, 0
+     292:      	jalr	272(ra)
+     296:      	mv	s0, a0
+     298:      	addi	s2, s2, 1
+     29a:      	li	a0, 8
+     29c:      	blt	s2, a0, 0x282 <bench_state+0x46>
+     2a0:      	mv	a0, s0
+     2a2:      	lw	ra, 12(sp)
+     2a4:      	lw	s0, 8(sp)
+     2a6:      	lw	s1, 4(sp)
+     2a8:      	lw	s2, 0(sp)
+     2aa:      	addi	sp, sp, 16
+     2ac:      	ret
+
+000002ae <state_token>:
+     2ae:      	li	a2, 0
+     2b0:      	auipc	t0, 0
+     2b4:      	addi	t0, t0, 170
+     2b8:      	lbu	a3, 0(a0)
+     2bc:      	beqz	a3, 0x354 <state_token+0xa6>
+     2be:      	addi	a0, a0, 1
+     2c0:      	li	a4, 44
+     2c4:      	beq	a3, a4, 0x354 <state_token+0xa6>
+     2c8:      	addi	a5, a3, -48
+     2cc:      	sltiu	a5, a5, 10
+     2d0:      	slli	a4, a2, 2
+     2d4:      	add	a4, a4, t0
+     2d6:      	jr	a4
+     2d8:      	bnez	a5, 0x340 <state_token+0x92>
+     2da:      	li	a4, 43
+     2de:      	beq	a3, a4, 0x33c <state_token+0x8e>
+     2e2:      	li	a4, 45
+     2e6:      	beq	a3, a4, 0x33c <state_token+0x8e>
+     2ea:      	li	a4, 46
+     2ee:      	beq	a3, a4, 0x344 <state_token+0x96>
+     2f2:      	j	0x338 <state_token+0x8a>
+     2f4:      	bnez	a5, 0x340 <state_token+0x92>
+     2f6:      	li	a4, 46
+     2fa:      	beq	a3, a4, 0x344 <state_token+0x96>
+     2fe:      	j	0x338 <state_token+0x8a>
+     300:      	bnez	a5, 0x2b8 <state_token+0xa>
+     302:      	li	a4, 46
+     306:      	beq	a3, a4, 0x344 <state_token+0x96>
+     30a:      	j	0x338 <state_token+0x8a>
+     30c:      	bnez	a5, 0x2b8 <state_token+0xa>
+     30e:      	li	a4, 69
+     312:      	beq	a3, a4, 0x34c <state_token+0x9e>
+     316:      	li	a4, 101
+     31a:      	beq	a3, a4, 0x34c <state_token+0x9e>
+     31e:      	j	0x338 <state_token+0x8a>
+     320:      	li	a4, 43
+     324:      	beq	a3, a4, 0x348 <state_token+0x9a>
+     328:      	li	a4, 45
+     32c:      	beq	a3, a4, 0x348 <state_token+0x9a>
+     330:      	j	0x338 <state_token+0x8a>
+     332:      	bnez	a5, 0x350 <state_token+0xa2>
+     334:      	j	0x338 <state_token+0x8a>
+     336:      	bnez	a5, 0x2b8 <state_token+0xa>
+     338:      	li	a2, 1
+     33a:      	j	0x2b8 <state_token+0xa>
+     33c:      	li	a2, 2
+     33e:      	j	0x2b8 <state_token+0xa>
+     340:      	li	a2, 3
+     342:      	j	0x2b8 <state_token+0xa>
+     344:      	li	a2, 4
+     346:      	j	0x2b8 <state_token+0xa>
+     348:      	li	a2, 5
+     34a:      	j	0x2b8 <state_token+0xa>
+     34c:      	li	a2, 6
+     34e:      	j	0x2b8 <state_token+0xa>
+     350:      	li	a2, 7
+     352:      	j	0x2b8 <state_token+0xa>
+     354:      	mv	a1, a0
+     356:      	mv	a0, a2
+     358:      	ret
+     35a:      	j	0x2d8 <state_token+0x2a>
+     35e:      	j	0x2b8 <state_token+0xa>
+     362:      	j	0x2f4 <state_token+0x46>
+     366:      	j	0x300 <state_token+0x52>
+     36a:      	j	0x30c <state_token+0x5e>
+     36e:      	j	0x332 <state_token+0x84>
+     372:      	j	0x320 <state_token+0x72>
+     376:      	j	0x336 <state_token+0x88>
+
+0000037a <crcu8>:
+     37a:      	li	a2, 8
+     37c:      	lui	a4, 4
+     37e:      	addi	a4, a4, 2
+     380:      	lui	a5, 8
+     382:      	xor	a3, a0, a1
+     386:      	andi	a3, a3, 1
+     388:      	srli	a0, a0, 1
+     38a:      	beqz	a3, 0x394 <crcu8+0x1a>
+     38c:      	xor	a1, a1, a4
+     38e:      	srli	a1, a1, 1
+     390:      	or	a1, a1, a5
+     392:      	j	0x396 <crcu8+0x1c>
+     394:      	srli	a1, a1, 1
+     396:      	addi	a2, a2, -1
+     398:      	bnez	a2, 0x382 <crcu8+0x8>
+     39a:      	mv	a0, a1
+     39c:      	ret
+
+0000039e <crcu16>:
+     39e:      	addi	sp, sp, -16
+     3a0:      	sw	ra, 12(sp)
+     3a2:      	sw	s0, 8(sp)
+     3a4:      	srli	s0, a0, 8
+     3a8:      	andi	s0, s0, 255
+     3ac:      	andi	a0, a0, 255
+     3b0:      	auipc	ra, 0
+     3b4:      	jalr	-54(ra)
+     3b8:      	mv	a1, a0
+     3ba:      	mv	a0, s0
+     3bc:      	auipc	ra, 0
+     3c0:      	jalr	-66(ra)
+     3c4:      	lw	ra, 12(sp)
+     3c6:      	lw	s0, 8(sp)
+     3c8:      	addi	sp, sp, 16
+     3ca:      	ret
+
+000003cc <strcpy>:
+     3cc:      	mv	a2, a0
+     3ce:      	lbu	a3, 0(a1)
+     3d2:      	sb	a3, 0(a2)
+     3d6:      	addi	a1, a1, 1
+     3d8:      	addi	a2, a2, 1
+     3da:      	bnez	a3, 0x3ce <strcpy+0x2>
+     3dc:      	ret
+
+000003de <__mulsi3>:
+     3de:      	mv	a2, a0
+     3e0:      	li	a0, 0
+     3e2:      	andi	a3, a1, 1
+     3e6:      	beqz	a3, 0x3ea <__mulsi3+0xc>
+     3e8:      	add	a0, a0, a2
+     3ea:      	srli	a1, a1, 1
+     3ec:      	slli	a2, a2, 1
+     3ee:      	bnez	a1, 0x3e2 <__mulsi3+0x4>
+     3f0:      	ret
+
+000003f2 <state_input>:
+     3f2:      	jal	0xfffffc1e <state_input+0xfffffffffffff82c>
+     3f4:      	jal	0xfffffd00 <state_input+0xfffffffffffff90e>
+     3f6:      	<unknown>
+     3f8:      	<unknown>
+     3fa:      	<unknown>
+     3fc:      	jal	0xfffffc36 <state_input+0xfffffffffffff844>
+     3fe:      	lui	s0, 176835
+     402:      	jal	0xfffffd0e <state_input+0xfffffffffffff91c>
+     404:      	<unknown>
+     406:      	<unknown>
+     40a:      	<unknown>
+     40c:      	<unknown>
+     40e:      	<unknown>
+     410:      	jal	0xfffffd1c <state_input+0xfffffffffffff92a>
+     412:      	<unknown>
+     416:      	<unknown>
+     418:      	jal	0x42 <main+0x26>
+     41a:      	jal	0xfffffc26 <state_input+0xfffffffffffff834>
+     41c:      	<unknown>
+     41e:      	<unknown>
+     420:      	<unknown>
+     422:      	<unknown>
+     424:      	<unknown>
+     426:      	<unknown>
+     428:      	<unknown>
+     42a:      	jal	0x766 <state_input+0x374>
+     42c:      	jal	0xfffffc58 <state_input+0xfffffffffffff866>
+     42e:      	<unknown>
+     430:      	<unknown>
+     434:      	<unknown>
+     436:      	<unknown>
+     438:      	jal	0xaf0 <state_input+0x6fe>
+     43a:      	<unknown>
+     43c:      	jal	0xfffffc76 <state_input+0xfffffffffffff884>
+     43e:      	lui	a0, 230070
+     442:      	<unknown>
+     446:      	<unknown>
+     448:      	<unknown>
+     44a:      	jal	0x74 <main+0x58>
+     44c:      	<unknown>
+     44e:      	<unknown>
+     450:      	<unknown>
+     452:      	jal	0xb0a <state_input+0x718>
+     454:      	li	a2, 12
+     456:      	<unknown>
+     458:      	<unknown>
+     45a:      	<unknown>
+     45c:      	<unknown>
+     460:      	li	s0, -20
+     462:      	<unknown>
+     466:      	<unknown>
+     468:      	<unknown>
+     46a:      	<unknown>
+     46c:      	<unknown>
+     46e:      	li	s0, -21
+     470:      	c.slli	zero, 23
@@ -0,0 +1,90 @@
+
+crc32.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       6:      	lui	gp, 16
+       8:      	auipc	ra, 0
+       c:      	jalr	20(ra)
+      10:      	li	a7, 1
+      12:      	ecall	
+      16:      	li	a7, 10
+      18:      	ecall	
+
+0000001c <main>:
+      1c:      	addi	sp, sp, -16
+      1e:      	sw	ra, 12(sp)
+      20:      	sw	s0, 8(sp)
+      22:      	sw	s1, 4(sp)
+      24:      	auipc	ra, 0
+      28:      	jalr	94(ra)
+      2c:      	addi	a0, gp, 1024
+      30:      	li	a1, 1024
+      34:      	lui	a2, 152671
+      38:      	addi	a2, a2, 1169
+      3c:      	slli	a3, a2, 13
+      40:      	xor	a2, a2, a3
+      42:      	srli	a3, a2, 17
+      46:      	xor	a2, a2, a3
+      48:      	slli	a3, a2, 5
+      4c:      	xor	a2, a2, a3
+      4e:      	sb	a2, 0(a0)
+      52:      	addi	a0, a0, 1
+      54:      	addi	a1, a1, -1
+      56:      	bnez	a1, 0x3c <main+0x20>
+      58:      	li	s0, 500
+      5c:      	li	s1, 0
+      5e:      	addi	a0, gp, 1024
+      62:      	li	a1, 1024
+      66:      	mv	a2, s1
+      68:      	auipc	ra, 0
+      6c:      	jalr	72(ra)
+      70:      	mv	s1, a0
+      72:      	addi	s0, s0, -1
+      74:      	bnez	s0, 0x5e <main+0x42>
+      76:      	mv	a0, s1
+      78:      	lw	ra, 12(sp)
+      7a:      	lw	s0, 8(sp)
+      7c:      	lw	s1, 4(sp)
+      7e:      	addi	sp, sp, 16
+      80:      	ret
+
+00000082 <crc32_init>:
+      82:      	mv	a0, gp
+      84:      	li	a1, 0
+      86:      	lui	a5, 973704
+      8a:      	addi	a5, a5, 800
+      8e:      	mv	a2, a1
+      90:      	li	a3, 8
+      92:      	andi	a4, a2, 1
+      96:      	srli	a2, a2, 1
+      98:      	beqz	a4, 0x9c <crc32_init+0x1a>
+      9a:      	xor	a2, a2, a5
+      9c:      	addi	a3, a3, -1
+      9e:      	bnez	a3, 0x92 <crc32_init+0x10>
+      a0:      	sw	a2, 0(a0)
+      a2:      	addi	a0, a0, 4
+      a4:      	addi	a1, a1, 1
+      a6:      	li	a3, 256
+      aa:      	bne	a1, a3, 0x8e <crc32_init+0xc>
+      ae:      	ret
+
+000000b0 <crc32>:
+      b0:      	not	a2, a2
+      b4:      	beqz	a1, 0xd2 <crc32+0x22>
+      b6:      	add	a1, a1, a0
+      b8:      	lbu	a3, 0(a0)
+      bc:      	xor	a3, a3, a2
+      be:      	andi	a3, a3, 255
+      c2:      	slli	a3, a3, 2
+      c4:      	add	a3, a3, gp
+      c6:      	lw	a3, 0(a3)
+      c8:      	srli	a2, a2, 8
+      ca:      	xor	a2, a2, a3
+      cc:      	addi	a0, a0, 1
+      ce:      	bne	a0, a1, 0xb8 <crc32+0x8>
+      d2:      	not	a0, a2
+      d6:      	ret
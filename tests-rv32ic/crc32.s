@@ -0,0 +1,92 @@
+# CRC-32 benchmark in the style of Embench's crc32: a 256-entry table is built bit by bit, then a 1 KB buffer
+# of pseudo-random bytes is checksummed with the table again and again, each pass starting from the last CRC.
+# Prints the final CRC.
+    .equ PASSES, 500
+    .equ DATA, 0x10000
+    .equ TABLE, 0x000       # 256 words
+    .equ BUFFER, 0x400
+    .equ BUFFER_SIZE, 1024
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main
+    li a7, 1
+    ecall
+    li a7, 10
+    ecall
+
+main:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    call crc32_init
+    # xorshift32 bytes
+    addi a0, gp, BUFFER
+    li a1, BUFFER_SIZE
+    li a2, 0x2545f491
+1:  slli a3, a2, 13
+    xor a2, a2, a3
+    srli a3, a2, 17
+    xor a2, a2, a3
+    slli a3, a2, 5
+    xor a2, a2, a3
+    sb a2, 0(a0)
+    addi a0, a0, 1
+    addi a1, a1, -1
+    bnez a1, 1b
+    li s0, PASSES
+    li s1, 0
+2:  addi a0, gp, BUFFER
+    li a1, BUFFER_SIZE
+    mv a2, s1
+    call crc32
+    mv s1, a0
+    addi s0, s0, -1
+    bnez s0, 2b
+    mv a0, s1
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+    ret
+
+# the table for the reflected polynomial 0xEDB88320
+crc32_init:
+    addi a0, gp, TABLE
+    li a1, 0                # n
+    li a5, 0xedb88320
+1:  mv a2, a1
+    li a3, 8
+2:  andi a4, a2, 1
+    srli a2, a2, 1
+    beqz a4, 3f
+    xor a2, a2, a5
+3:  addi a3, a3, -1
+    bnez a3, 2b
+    sw a2, 0(a0)
+    addi a0, a0, 4
+    addi a1, a1, 1
+    li a3, 256
+    bne a1, a3, 1b
+    ret
+
+# unsigned int crc32(const unsigned char *buf, int len, unsigned int crc)
+crc32:
+    not a2, a2
+    beqz a1, 2f
+    add a1, a0, a1
+1:  lbu a3, 0(a0)
+    xor a3, a3, a2
+    andi a3, a3, 0xff
+    slli a3, a3, 2
+    add a3, gp, a3
+    lw a3, TABLE(a3)
+    srli a2, a2, 8
+    xor a2, a2, a3
+    addi a0, a0, 1
+    bne a0, a1, 1b
+2:  not a0, a2
+    ret
@@ -0,0 +1,484 @@
+
+dhrystone.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       6:      	lui	gp, 16
+       8:      	auipc	ra, 0
+       c:      	jalr	20(ra)
+      10:      	li	a7, 1
+      12:      	ecall	
+      16:      	li	a7, 10
+      18:      	ecall	
+
+0000001c <main>:
+      1c:      	addi	sp, sp, -32
+      1e:      	sw	ra, 28(sp)
+      20:      	sw	s0, 24(sp)
+      22:      	sw	s1, 20(sp)
+      24:      	sw	s2, 16(sp)
+      26:      	sw	s3, 12(sp)
+      28:      	addi	a0, gp, 320
+      2c:      	sw	a0, 16(gp)
+      30:      	addi	a1, gp, 256
+      34:      	sw	a1, 12(gp)
+      38:      	sw	a0, 0(a1)
+      3a:      	sw	zero, 4(a1)
+      3e:      	li	a2, 2
+      40:      	sw	a2, 8(a1)
+      42:      	li	a2, 40
+      46:      	sw	a2, 12(a1)
+      48:      	addi	a0, a1, 16
+      4c:      	auipc	a1, 0
+      50:      	addi	a1, a1, 1022
+      54:      	auipc	ra, 0
+      58:      	jalr	890(ra)
+      5c:      	addi	a0, gp, 64
+      60:      	auipc	a1, 0
+      64:      	addi	a1, a1, 1033
+      68:      	auipc	ra, 0
+      6c:      	jalr	870(ra)
+      70:      	lui	a0, 17
+      72:      	addi	a0, a0, -2020
+      76:      	li	a1, 10
+      78:      	sw	a1, 0(a0)
+      7a:      	li	s0, 1
+      7c:      	lui	s1, 2
+      7e:      	addi	s1, s1, -192
+      82:      	auipc	ra, 0
+      86:      	jalr	532(ra)
+      8a:      	auipc	ra, 0
+      8e:      	jalr	492(ra)
+      92:      	li	a0, 2
+      94:      	sw	a0, 0(sp)
+      96:      	li	s2, 3
+      98:      	addi	a0, gp, 96
+      9c:      	auipc	a1, 0
+      a0:      	addi	a1, a1, 1004
+      a4:      	auipc	ra, 0
+      a8:      	jalr	810(ra)
+      ac:      	li	a0, 1
+      ae:      	sw	a0, 8(sp)
+      b0:      	addi	a0, gp, 64
+      b4:      	addi	a1, gp, 96
+      b8:      	auipc	ra, 0
+      bc:      	jalr	692(ra)
+      c0:      	seqz	a0, a0
+      c4:      	sw	a0, 4(gp)
+      c8:      	lw	a0, 0(sp)
+      ca:      	bge	a0, s2, 0xee <main+0xd2>
+      ce:      	slli	a2, a0, 2
+      d2:      	add	a2, a2, a0
+      d4:      	sub	a2, a2, s2
+      d8:      	sw	a2, 4(sp)
+      da:      	mv	a1, s2
+      dc:      	addi	a2, sp, 4
+      de:      	auipc	ra, 0
+      e2:      	jalr	542(ra)
+      e6:      	lw	a0, 0(sp)
+      e8:      	addi	a0, a0, 1
+      ea:      	sw	a0, 0(sp)
+      ec:      	j	0xca <main+0xae>
+      ee:      	addi	a0, gp, 512
+      f2:      	lui	a1, 16
+      f4:      	addi	a1, a1, 1024
+      f8:      	lw	a2, 0(sp)
+      fa:      	lw	a3, 4(sp)
+      fc:      	auipc	ra, 0
+     100:      	jalr	520(ra)
+     104:      	lw	a0, 12(gp)
+     108:      	auipc	ra, 0
+     10c:      	jalr	192(ra)
+     110:      	li	s3, 65
+     114:      	lbu	a0, 9(gp)
+     118:      	bltu	a0, s3, 0x15a <main+0x13e>
+     11c:      	mv	a0, s3
+     11e:      	li	a1, 67
+     122:      	auipc	ra, 0
+     126:      	jalr	566(ra)
+     12a:      	lw	a1, 8(sp)
+     12c:      	bne	a0, a1, 0x156 <main+0x13a>
+     130:      	li	a0, 0
+     132:      	addi	a1, sp, 8
+     134:      	auipc	ra, 0
+     138:      	jalr	368(ra)
+     13c:      	addi	a0, gp, 96
+     140:      	auipc	a1, 0
+     144:      	addi	a1, a1, 871
+     148:      	auipc	ra, 0
+     14c:      	jalr	646(ra)
+     150:      	mv	s2, s0
+     152:      	sw	s0, 0(gp)
+     156:      	addi	s3, s3, 1
+     158:      	j	0x114 <main+0xf8>
+     15a:      	mv	a0, s2
+     15c:      	lw	a1, 0(sp)
+     15e:      	auipc	ra, 0
+     162:      	jalr	684(ra)
+     166:      	mv	s2, a0
+     168:      	lw	a1, 4(sp)
+     16a:      	auipc	ra, 0
+     16e:      	jalr	692(ra)
+     172:      	sw	a0, 0(sp)
+     174:      	lw	a1, 4(sp)
+     176:      	sub	a1, s2, a1
+     17a:      	slli	s2, a1, 3
+     17e:      	sub	s2, s2, a1
+     182:      	sub	s2, s2, a0
+     186:      	mv	a0, sp
+     188:      	auipc	ra, 0
+     18c:      	jalr	188(ra)
+     190:      	addi	s0, s0, 1
+     192:      	bge	s1, s0, 0x82 <main+0x66>
+     196:      	lw	a0, 0(gp)
+     19a:      	lw	a1, 0(sp)
+     19c:      	add	a0, a0, a1
+     19e:      	add	a0, a0, s2
+     1a0:      	lw	a1, 4(sp)
+     1a2:      	add	a0, a0, a1
+     1a4:      	lw	a1, 8(sp)
+     1a6:      	add	a0, a0, a1
+     1a8:      	lui	a1, 17
+     1aa:      	addi	a1, a1, -2020
+     1ae:      	lw	a1, 0(a1)
+     1b0:      	add	a0, a0, a1
+     1b2:      	lw	a1, 16(gp)
+     1b6:      	lw	a1, 12(a1)
+     1b8:      	add	a0, a0, a1
+     1ba:      	lw	ra, 28(sp)
+     1bc:      	lw	s0, 24(sp)
+     1be:      	lw	s1, 20(sp)
+     1c0:      	lw	s2, 16(sp)
+     1c2:      	lw	s3, 12(sp)
+     1c4:      	addi	sp, sp, 32
+     1c6:      	ret
+
+000001c8 <proc_1>:
+     1c8:      	addi	sp, sp, -16
+     1ca:      	sw	ra, 12(sp)
+     1cc:      	sw	s0, 8(sp)
+     1ce:      	sw	s1, 4(sp)
+     1d0:      	mv	s0, a0
+     1d2:      	lw	s1, 0(a0)
+     1d4:      	mv	a0, s1
+     1d6:      	lw	a1, 12(gp)
+     1da:      	li	a2, 48
+     1de:      	auipc	ra, 0
+     1e2:      	jalr	538(ra)
+     1e6:      	li	a0, 5
+     1e8:      	sw	a0, 12(s0)
+     1ea:      	sw	a0, 12(s1)
+     1ec:      	lw	a0, 0(s0)
+     1ee:      	sw	a0, 0(s1)
+     1f0:      	mv	a0, s1
+     1f2:      	auipc	ra, 0
+     1f6:      	jalr	110(ra)
+     1fa:      	lw	a0, 4(s1)
+     1fc:      	bnez	a0, 0x22a <proc_1+0x62>
+     1fe:      	li	a0, 6
+     200:      	sw	a0, 12(s1)
+     202:      	lw	a0, 8(s0)
+     204:      	addi	a1, s1, 8
+     208:      	auipc	ra, 0
+     20c:      	jalr	156(ra)
+     210:      	lw	a0, 12(gp)
+     214:      	lw	a0, 0(a0)
+     216:      	sw	a0, 0(s1)
+     218:      	lw	a0, 12(s1)
+     21a:      	li	a1, 10
+     21c:      	addi	a2, s1, 12
+     220:      	auipc	ra, 0
+     224:      	jalr	220(ra)
+     228:      	j	0x23a <proc_1+0x72>
+     22a:      	mv	a0, s0
+     22c:      	lw	a1, 0(s0)
+     22e:      	li	a2, 48
+     232:      	auipc	ra, 0
+     236:      	jalr	454(ra)
+     23a:      	lw	ra, 12(sp)
+     23c:      	lw	s0, 8(sp)
+     23e:      	lw	s1, 4(sp)
+     240:      	addi	sp, sp, 16
+     242:      	ret
+
+00000244 <proc_2>:
+     244:      	lw	a1, 0(a0)
+     246:      	addi	a1, a1, 10
+     248:      	lbu	a2, 8(gp)
+     24c:      	li	a3, 65
+     250:      	bne	a2, a3, 0x250 <proc_2+0xc>
+     254:      	addi	a1, a1, -1
+     256:      	lw	a2, 0(gp)
+     25a:      	sub	a1, a1, a2
+     25c:      	sw	a1, 0(a0)
+     25e:      	ret
+
+00000260 <proc_3>:
+     260:      	lw	a1, 12(gp)
+     264:      	beqz	a1, 0x26a <proc_3+0xa>
+     266:      	lw	a2, 0(a1)
+     268:      	sw	a2, 0(a0)
+     26a:      	addi	a2, a1, 12
+     26e:      	lw	a1, 0(gp)
+     272:      	li	a0, 10
+     274:      	j	0x2fc <proc_7>
+
+00000276 <proc_4>:
+     276:      	lbu	a0, 8(gp)
+     27a:      	addi	a0, a0, -65
+     27e:      	seqz	a0, a0
+     282:      	lw	a1, 4(gp)
+     286:      	or	a0, a0, a1
+     288:      	sw	a0, 4(gp)
+     28c:      	li	a0, 66
+     290:      	sb	a0, 9(gp)
+     294:      	ret
+
+00000296 <proc_5>:
+     296:      	li	a0, 65
+     29a:      	sb	a0, 8(gp)
+     29e:      	sw	zero, 4(gp)
+     2a2:      	ret
+
+000002a4 <proc_6>:
+     2a4:      	addi	sp, sp, -16
+     2a6:      	sw	ra, 12(sp)
+     2a8:      	sw	s0, 8(sp)
+     2aa:      	sw	s1, 4(sp)
+     2ac:      	mv	s0, a0
+     2ae:      	mv	s1, a1
+     2b0:      	sw	a0, 0(a1)
+     2b2:      	auipc	ra, 0
+     2b6:      	jalr	276(ra)
+     2ba:      	bnez	a0, 0x2c0 <proc_6+0x1c>
+     2bc:      	li	a0, 3
+     2be:      	sw	a0, 0(s1)
+     2c0:      	beqz	s0, 0x2d8 <proc_6+0x34>
+     2c2:      	li	a0, 1
+     2c4:      	beq	s0, a0, 0x2dc <proc_6+0x38>
+     2c8:      	li	a0, 2
+     2ca:      	beq	s0, a0, 0x2ee <proc_6+0x4a>
+     2ce:      	li	a0, 4
+     2d0:      	bne	s0, a0, 0x2f2 <proc_6+0x4e>
+     2d4:      	li	a0, 2
+     2d6:      	j	0x2f0 <proc_6+0x4c>
+     2d8:      	li	a0, 0
+     2da:      	j	0x2f0 <proc_6+0x4c>
+     2dc:      	lw	a1, 0(gp)
+     2e0:      	li	a2, 100
+     2e4:      	li	a0, 0
+     2e6:      	blt	a2, a1, 0x2f0 <proc_6+0x4c>
+     2ea:      	li	a0, 3
+     2ec:      	j	0x2f0 <proc_6+0x4c>
+     2ee:      	li	a0, 1
+     2f0:      	sw	a0, 0(s1)
+     2f2:      	lw	ra, 12(sp)
+     2f4:      	lw	s0, 8(sp)
+     2f6:      	lw	s1, 4(sp)
+     2f8:      	addi	sp, sp, 16
+     2fa:      	ret
+
+000002fc <proc_7>:
+     2fc:      	addi	a0, a0, 2
+     2fe:      	add	a0, a0, a1
+     300:      	sw	a0, 0(a2)
+     302:      	ret
+
+00000304 <proc_8>:
+     304:      	addi	a4, a2, 5
+     308:      	slli	a5, a4, 2
+     30c:      	add	a5, a5, a0
+     30e:      	sw	a3, 0(a5)
+     310:      	sw	a3, 4(a5)
+     312:      	sw	a4, 120(a5)
+     314:      	slli	a6, a4, 7
+     318:      	add	a6, a6, a1
+     31a:      	mv	t0, a4
+     31c:      	addi	t1, a4, 1
+     320:      	slli	t2, t0, 2
+     324:      	add	t2, t2, a6
+     326:      	sw	a4, 0(t2)
+     32a:      	addi	t0, t0, 1
+     32c:      	bge	t1, t0, 0x320 <proc_8+0x1c>
+     330:      	slli	t2, a4, 2
+     334:      	add	t2, t2, a6
+     336:      	lw	t0, -4(t2)
+     33a:      	addi	t0, t0, 1
+     33c:      	sw	t0, -4(t2)
+     340:      	lw	t0, 0(a5)
+     344:      	lui	t1, 1
+     346:      	addi	t1, t1, -1536
+     34a:      	add	t2, t2, t1
+     34c:      	sw	t0, 0(t2)
+     350:      	li	t0, 5
+     352:      	sw	t0, 0(gp)
+     356:      	ret
+
+00000358 <func_1>:
+     358:      	andi	a0, a0, 255
+     35c:      	bne	a0, a1, 0x368 <func_1+0x10>
+     360:      	sb	a0, 8(gp)
+     364:      	li	a0, 1
+     366:      	ret
+     368:      	li	a0, 0
+     36a:      	ret
+
+0000036c <func_2>:
+     36c:      	addi	sp, sp, -16
+     36e:      	sw	ra, 12(sp)
+     370:      	sw	s0, 8(sp)
+     372:      	sw	s1, 4(sp)
+     374:      	sw	s2, 0(sp)
+     376:      	mv	s0, a0
+     378:      	mv	s1, a1
+     37a:      	li	s2, 2
+     37c:      	add	a0, s0, s2
+     380:      	lbu	a0, 0(a0)
+     384:      	add	a1, s1, s2
+     388:      	lbu	a1, 1(a1)
+     38c:      	auipc	ra, 0
+     390:      	jalr	-52(ra)
+     394:      	bnez	a0, 0x37c <func_2+0x10>
+     396:      	addi	s2, s2, 1
+     398:      	li	a0, 2
+     39a:      	bge	a0, s2, 0x37c <func_2+0x10>
+     39e:      	mv	a0, s0
+     3a0:      	mv	a1, s1
+     3a2:      	auipc	ra, 0
+     3a6:      	jalr	62(ra)
+     3aa:      	blez	a0, 0x3b8 <func_2+0x4c>
+     3ae:      	li	a0, 10
+     3b0:      	sw	a0, 0(gp)
+     3b4:      	li	a0, 1
+     3b6:      	j	0x3ba <func_2+0x4e>
+     3b8:      	li	a0, 0
+     3ba:      	lw	ra, 12(sp)
+     3bc:      	lw	s0, 8(sp)
+     3be:      	lw	s1, 4(sp)
+     3c0:      	lw	s2, 0(sp)
+     3c2:      	addi	sp, sp, 16
+     3c4:      	ret
+
+000003c6 <func_3>:
+     3c6:      	addi	a0, a0, -2
+     3c8:      	seqz	a0, a0
+     3cc:      	ret
+
+000003ce <strcpy>:
+     3ce:      	mv	a2, a0
+     3d0:      	lbu	a3, 0(a1)
+     3d4:      	sb	a3, 0(a2)
+     3d8:      	addi	a1, a1, 1
+     3da:      	addi	a2, a2, 1
+     3dc:      	bnez	a3, 0x3d0 <strcpy+0x2>
+     3de:      	ret
+
+000003e0 <strcmp>:
+     3e0:      	lbu	a2, 0(a0)
+     3e4:      	lbu	a3, 0(a1)
+     3e8:      	addi	a0, a0, 1
+     3ea:      	addi	a1, a1, 1
+     3ec:      	bne	a2, a3, 0x3f2 <strcmp+0x12>
+     3f0:      	bnez	a2, 0x3e0 <strcmp>
+     3f2:      	sub	a0, a2, a3
+     3f6:      	ret
+
+000003f8 <memcpy>:
+     3f8:      	mv	a3, a0
+     3fa:      	add	a2, a2, a1
+     3fc:      	lw	a4, 0(a1)
+     3fe:      	sw	a4, 0(a3)
+     400:      	addi	a1, a1, 4
+     402:      	addi	a3, a3, 4
+     404:      	bltu	a1, a2, 0x3fc <memcpy+0x4>
+     408:      	ret
+
+0000040a <__mulsi3>:
+     40a:      	mv	a2, a0
+     40c:      	li	a0, 0
+     40e:      	andi	a3, a1, 1
+     412:      	beqz	a3, 0x416 <__mulsi3+0xc>
+     414:      	add	a0, a0, a2
+     416:      	srli	a1, a1, 1
+     418:      	slli	a2, a2, 1
+     41a:      	bnez	a1, 0x40e <__mulsi3+0x4>
+     41c:      	ret
+
+0000041e <__udivsi3>:
+     41e:      	mv	a2, a1
+     420:      	mv	a1, a0
+     422:      	li	a0, -1
+     424:      	beqz	a2, 0x448 <__udivsi3+0x2a>
+     426:      	li	a3, 1
+     428:      	bgeu	a2, a1, 0x438 <__udivsi3+0x1a>
+     42c:      	blez	a2, 0x438 <__udivsi3+0x1a>
+     430:      	slli	a2, a2, 1
+     432:      	slli	a3, a3, 1
+     434:      	bltu	a2, a1, 0x42c <__udivsi3+0xe>
+     438:      	li	a0, 0
+     43a:      	bltu	a1, a2, 0x442 <__udivsi3+0x24>
+     43e:      	sub	a1, a1, a2
+     440:      	or	a0, a0, a3
+     442:      	srli	a3, a3, 1
+     444:      	srli	a2, a2, 1
+     446:      	bnez	a3, 0x43a <__udivsi3+0x1c>
+     448:      	ret
+
+0000044a <some_string>:
+     44a:      	lw	s1, 20(s0)
+     44c:      	lw	s2, 52(sp)
+     44e:      	<unknown>
+     452:      	jal	0x4f2 <third_string+0x4b>
+     454:      	lw	a2, 36(a2)
+     456:      	<unknown>
+     45a:      	jal	0x70c <third_string+0x265>
+     45c:      	lw	s0, 96(a4)
+     45e:      	<unknown>
+     462:      	<unknown>
+     466:      	lw	a4, 208(sp)
+     468:      	lw	s0, 8(s0)
+
+00000469 <first_string>:
+     469:      	lw	s1, 20(s0)
+     46b:      	lw	s2, 52(sp)
+     46d:      	<unknown>
+     471:      	jal	0x511 <third_string+0x6a>
+     473:      	lw	a2, 36(a2)
+     475:      	<unknown>
+     479:      	jal	0x72b <third_string+0x284>
+     47b:      	<unknown>
+     47d:      	<unknown>
+     481:      	<unknown>
+     485:      	lw	a4, 208(sp)
+     487:      	lw	s0, 8(s0)
+
+00000488 <second_string>:
+     488:      	lw	s1, 20(s0)
+     48a:      	lw	s2, 52(sp)
+     48c:      	<unknown>
+     490:      	jal	0x530 <third_string+0x89>
+     492:      	lw	a2, 36(a2)
+     494:      	<unknown>
+     498:      	jal	0x74a <third_string+0x2a3>
+     49a:      	<unknown>
+     49c:      	<unknown>
+     4a0:      	<unknown>
+     4a4:      	lw	a4, 208(sp)
+     4a6:      	lw	s0, 8(s0)
+
+000004a7 <third_string>:
+     4a7:      	lw	s1, 20(s0)
+     4a9:      	lw	s2, 52(sp)
+     4ab:      	<unknown>
+     4af:      	jal	0x54f <third_string+0xa8>
+     4b1:      	lw	a2, 36(a2)
+     4b3:      	<unknown>
+     4b7:      	jal	0x769 <third_string+0x2c2>
+     4b9:      	<unknown>
+     4bb:      	<unknown>
+     4bf:      	<unknown>
+     4c3:      	lw	a4, 208(sp)
+     4c5:      	<unknown>
@@ -0,0 +1,442 @@
+# Dhrystone-style benchmark, after Weicker's Dhrystone 2.1: procedure calls, record copies, string copies and
+# compares, and array accesses. Written the way an -O2 build for rv32i comes out, so multiply and divide are
+# library calls. Prints a checksum that depends on every run (Arr_2[8][7] counts them).
+    .equ RUNS, 8000
+    .equ DATA, 0x10000
+    .equ INT_GLOB, 0
+    .equ BOOL_GLOB, 4
+    .equ CH_1_GLOB, 8
+    .equ CH_2_GLOB, 9
+    .equ PTR_GLOB, 12
+    .equ NEXT_PTR_GLOB, 16
+    .equ STR_1, 0x40
+    .equ STR_2, 0x60
+    .equ REC_A, 0x100
+    .equ REC_B, 0x140
+    .equ ARR_1, 0x200
+    .equ ARR_2, 0x400       # 32 x 32 words
+    # record fields
+    .equ PTR_COMP, 0
+    .equ DISCR, 4
+    .equ ENUM_COMP, 8
+    .equ INT_COMP, 12
+    .equ STR_COMP, 16
+    .equ REC_SIZE, 48
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main
+    li a7, 1
+    ecall
+    li a7, 10
+    ecall
+
+main:
+    addi sp, sp, -32
+    sw ra, 28(sp)
+    sw s0, 24(sp)
+    sw s1, 20(sp)
+    sw s2, 16(sp)
+    sw s3, 12(sp)
+    addi a0, gp, REC_B
+    sw a0, NEXT_PTR_GLOB(gp)
+    addi a1, gp, REC_A
+    sw a1, PTR_GLOB(gp)
+    sw a0, PTR_COMP(a1)
+    sw zero, DISCR(a1)
+    li a2, 2
+    sw a2, ENUM_COMP(a1)
+    li a2, 40
+    sw a2, INT_COMP(a1)
+    addi a0, a1, STR_COMP
+    lla a1, some_string
+    call strcpy
+    addi a0, gp, STR_1
+    lla a1, first_string
+    call strcpy
+    li a0, DATA + ARR_2 + 8 * 128 + 7 * 4
+    li a1, 10
+    sw a1, 0(a0)
+
+    li s0, 1                # Run_Index
+    li s1, RUNS
+.Lrun:
+    call proc_5
+    call proc_4
+    li a0, 2
+    sw a0, 0(sp)            # Int_1_Loc
+    li s2, 3                # Int_2_Loc
+    addi a0, gp, STR_2
+    lla a1, second_string
+    call strcpy
+    li a0, 1
+    sw a0, 8(sp)            # Enum_Loc = Ident_2
+    addi a0, gp, STR_1
+    addi a1, gp, STR_2
+    call func_2
+    seqz a0, a0
+    sw a0, BOOL_GLOB(gp)
+    lw a0, 0(sp)
+.Lwhile:
+    bge a0, s2, .Lwhile_end
+    slli a2, a0, 2
+    add a2, a2, a0
+    sub a2, a2, s2
+    sw a2, 4(sp)            # Int_3_Loc = 5 * Int_1_Loc - Int_2_Loc
+    mv a1, s2
+    addi a2, sp, 4
+    call proc_7
+    lw a0, 0(sp)
+    addi a0, a0, 1
+    sw a0, 0(sp)
+    j .Lwhile
+.Lwhile_end:
+    addi a0, gp, ARR_1
+    li a1, DATA + ARR_2
+    lw a2, 0(sp)
+    lw a3, 4(sp)
+    call proc_8
+    lw a0, PTR_GLOB(gp)
+    call proc_1
+    li s3, 'A'              # Ch_Index
+.Lfor:
+    lbu a0, CH_2_GLOB(gp)
+    bltu a0, s3, .Lfor_end
+    mv a0, s3
+    li a1, 'C'
+    call func_1
+    lw a1, 8(sp)
+    bne a0, a1, .Lfor_next
+    li a0, 0
+    addi a1, sp, 8
+    call proc_6
+    addi a0, gp, STR_2
+    lla a1, third_string
+    call strcpy
+    mv s2, s0
+    sw s0, INT_GLOB(gp)
+.Lfor_next:
+    addi s3, s3, 1
+    j .Lfor
+.Lfor_end:
+    mv a0, s2
+    lw a1, 0(sp)
+    call __mulsi3
+    mv s2, a0               # Int_2_Loc = Int_2_Loc * Int_1_Loc
+    lw a1, 4(sp)
+    call __udivsi3
+    sw a0, 0(sp)            # Int_1_Loc = Int_2_Loc / Int_3_Loc
+    lw a1, 4(sp)
+    sub a1, s2, a1
+    slli s2, a1, 3
+    sub s2, s2, a1
+    sub s2, s2, a0          # Int_2_Loc = 7 * (Int_2_Loc - Int_3_Loc) - Int_1_Loc
+    mv a0, sp
+    call proc_2
+    addi s0, s0, 1
+    ble s0, s1, .Lrun
+
+    lw a0, INT_GLOB(gp)
+    lw a1, 0(sp)
+    add a0, a0, a1
+    add a0, a0, s2
+    lw a1, 4(sp)
+    add a0, a0, a1
+    lw a1, 8(sp)
+    add a0, a0, a1
+    li a1, DATA + ARR_2 + 8 * 128 + 7 * 4
+    lw a1, 0(a1)
+    add a0, a0, a1
+    lw a1, NEXT_PTR_GLOB(gp)
+    lw a1, INT_COMP(a1)
+    add a0, a0, a1
+    lw ra, 28(sp)
+    lw s0, 24(sp)
+    lw s1, 20(sp)
+    lw s2, 16(sp)
+    lw s3, 12(sp)
+    addi sp, sp, 32
+    ret
+
+# void proc_1(Rec_Pointer Ptr_Val_Par)
+proc_1:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    mv s0, a0
+    lw s1, PTR_COMP(a0)     # Next_Record
+    mv a0, s1
+    lw a1, PTR_GLOB(gp)
+    li a2, REC_SIZE
+    call memcpy             # *Ptr_Val_Par->Ptr_Comp = *Ptr_Glob
+    li a0, 5
+    sw a0, INT_COMP(s0)
+    sw a0, INT_COMP(s1)
+    lw a0, PTR_COMP(s0)
+    sw a0, PTR_COMP(s1)
+    addi a0, s1, PTR_COMP
+    call proc_3
+    lw a0, DISCR(s1)
+    bnez a0, 1f
+    li a0, 6
+    sw a0, INT_COMP(s1)
+    lw a0, ENUM_COMP(s0)
+    addi a1, s1, ENUM_COMP
+    call proc_6
+    lw a0, PTR_GLOB(gp)
+    lw a0, PTR_COMP(a0)
+    sw a0, PTR_COMP(s1)
+    lw a0, INT_COMP(s1)
+    li a1, 10
+    addi a2, s1, INT_COMP
+    call proc_7
+    j 2f
+1:  mv a0, s0
+    lw a1, PTR_COMP(s0)
+    li a2, REC_SIZE
+    call memcpy
+2:  lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+    ret
+
+# void proc_2(int *Int_Par_Ref)
+proc_2:
+    lw a1, 0(a0)
+    addi a1, a1, 10
+    lbu a2, CH_1_GLOB(gp)
+    li a3, 'A'
+1:  bne a2, a3, 1b          # Enum_Loc only changes when Ch_1_Glob is 'A'
+    addi a1, a1, -1
+    lw a2, INT_GLOB(gp)
+    sub a1, a1, a2
+    sw a1, 0(a0)
+    ret
+
+# void proc_3(Rec_Pointer *Ptr_Ref_Par)
+proc_3:
+    lw a1, PTR_GLOB(gp)
+    beqz a1, 1f
+    lw a2, PTR_COMP(a1)
+    sw a2, 0(a0)
+1:  addi a2, a1, INT_COMP
+    lw a1, INT_GLOB(gp)
+    li a0, 10
+    j proc_7
+
+proc_4:
+    lbu a0, CH_1_GLOB(gp)
+    addi a0, a0, -'A'
+    seqz a0, a0
+    lw a1, BOOL_GLOB(gp)
+    or a0, a0, a1
+    sw a0, BOOL_GLOB(gp)
+    li a0, 'B'
+    sb a0, CH_2_GLOB(gp)
+    ret
+
+proc_5:
+    li a0, 'A'
+    sb a0, CH_1_GLOB(gp)
+    sw zero, BOOL_GLOB(gp)
+    ret
+
+# void proc_6(Enumeration Enum_Val_Par, Enumeration *Enum_Ref_Par)
+proc_6:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    mv s0, a0
+    mv s1, a1
+    sw a0, 0(a1)
+    call func_3
+    bnez a0, 1f
+    li a0, 3
+    sw a0, 0(s1)            # Ident_4
+1:  beqz s0, 2f
+    li a0, 1
+    beq s0, a0, 3f
+    li a0, 2
+    beq s0, a0, 4f
+    li a0, 4
+    bne s0, a0, 6f
+    li a0, 2                # Ident_5 -> Ident_3
+    j 5f
+2:  li a0, 0
+    j 5f
+3:  lw a1, INT_GLOB(gp)
+    li a2, 100
+    li a0, 0
+    bgt a1, a2, 5f
+    li a0, 3
+    j 5f
+4:  li a0, 1
+5:  sw a0, 0(s1)
+6:  lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+    ret
+
+# void proc_7(int Int_1_Par_Val, int Int_2_Par_Val, int *Int_Par_Ref)
+proc_7:
+    addi a0, a0, 2
+    add a0, a0, a1
+    sw a0, 0(a2)
+    ret
+
+# void proc_8(int Arr_1_Par_Ref[], int Arr_2_Par_Ref[][32], int Int_1_Par_Val, int Int_2_Par_Val)
+proc_8:
+    addi a4, a2, 5          # Int_Loc
+    slli a5, a4, 2
+    add a5, a0, a5
+    sw a3, 0(a5)
+    sw a3, 4(a5)
+    sw a4, 120(a5)          # Arr_1[Int_Loc + 30]
+    slli a6, a4, 7
+    add a6, a1, a6          # Arr_2[Int_Loc]
+    mv t0, a4
+    addi t1, a4, 1
+1:  slli t2, t0, 2
+    add t2, a6, t2
+    sw a4, 0(t2)
+    addi t0, t0, 1
+    ble t0, t1, 1b
+    slli t2, a4, 2
+    add t2, a6, t2
+    lw t0, -4(t2)
+    addi t0, t0, 1
+    sw t0, -4(t2)           # Arr_2[Int_Loc][Int_Loc - 1] += 1
+    lw t0, 0(a5)
+    li t1, 20 * 128
+    add t2, t2, t1
+    sw t0, 0(t2)            # Arr_2[Int_Loc + 20][Int_Loc] = Arr_1[Int_Loc]
+    li t0, 5
+    sw t0, INT_GLOB(gp)
+    ret
+
+# Enumeration func_1(char Ch_1_Par_Val, char Ch_2_Par_Val)
+func_1:
+    andi a0, a0, 0xff
+    bne a0, a1, 1f
+    sb a0, CH_1_GLOB(gp)
+    li a0, 1
+    ret
+1:  li a0, 0
+    ret
+
+# bool func_2(char *Str_1_Par_Ref, char *Str_2_Par_Ref)
+func_2:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    sw s2, 0(sp)
+    mv s0, a0
+    mv s1, a1
+    li s2, 2                # Int_Loc
+1:  add a0, s0, s2
+    lbu a0, 0(a0)
+    add a1, s1, s2
+    lbu a1, 1(a1)
+    call func_1
+    bnez a0, 1b
+    addi s2, s2, 1
+    li a0, 2
+    ble s2, a0, 1b
+    mv a0, s0
+    mv a1, s1
+    call strcmp
+    blez a0, 2f
+    li a0, 10
+    sw a0, INT_GLOB(gp)
+    li a0, 1
+    j 3f
+2:  li a0, 0
+3:  lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    lw s2, 0(sp)
+    addi sp, sp, 16
+    ret
+
+# bool func_3(Enumeration Enum_Par_Val)
+func_3:
+    addi a0, a0, -2
+    seqz a0, a0
+    ret
+
+strcpy:
+    mv a2, a0
+1:  lbu a3, 0(a1)
+    sb a3, 0(a2)
+    addi a1, a1, 1
+    addi a2, a2, 1
+    bnez a3, 1b
+    ret
+
+strcmp:
+1:  lbu a2, 0(a0)
+    lbu a3, 0(a1)
+    addi a0, a0, 1
+    addi a1, a1, 1
+    bne a2, a3, 2f
+    bnez a2, 1b
+2:  sub a0, a2, a3
+    ret
+
+# word copy; the records are word aligned
+memcpy:
+    mv a3, a0
+    add a2, a1, a2
+1:  lw a4, 0(a1)
+    sw a4, 0(a3)
+    addi a1, a1, 4
+    addi a3, a3, 4
+    bltu a1, a2, 1b
+    ret
+
+__mulsi3:
+    mv a2, a0
+    li a0, 0
+1:  andi a3, a1, 1
+    beqz a3, 2f
+    add a0, a0, a2
+2:  srli a1, a1, 1
+    slli a2, a2, 1
+    bnez a1, 1b
+    ret
+
+__udivsi3:
+    mv a2, a1
+    mv a1, a0
+    li a0, -1
+    beqz a2, 5f
+    li a3, 1
+    bgeu a2, a1, 2f
+1:  blez a2, 2f
+    slli a2, a2, 1
+    slli a3, a3, 1
+    bgtu a1, a2, 1b
+2:  li a0, 0
+3:  bltu a1, a2, 4f
+    sub a1, a1, a2
+    or a0, a0, a3
+4:  srli a3, a3, 1
+    srli a2, a2, 1
+    bnez a3, 3b
+5:  ret
+
+some_string:
+    .asciz "DHRYSTONE PROGRAM, SOME STRING"
+first_string:
+    .asciz "DHRYSTONE PROGRAM, 1'ST STRING"
+second_string:
+    .asciz "DHRYSTONE PROGRAM, 2'ND STRING"
+third_string:
+    .asciz "DHRYSTONE PROGRAM, 3'RD STRING"
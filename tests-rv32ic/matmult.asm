@@ -0,0 +1,127 @@
+
+matmult.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       6:      	lui	gp, 16
+       8:      	auipc	ra, 0
+       c:      	jalr	20(ra)
+      10:      	li	a7, 1
+      12:      	ecall	
+      16:      	li	a7, 10
+      18:      	ecall	
+
+0000001c <main>:
+      1c:      	addi	sp, sp, -16
+      1e:      	sw	ra, 12(sp)
+      20:      	sw	s0, 8(sp)
+      22:      	sw	s1, 4(sp)
+      24:      	mv	a0, gp
+      26:      	li	a1, 800
+      2a:      	lui	a2, 152671
+      2e:      	addi	a2, a2, 1169
+      32:      	li	a4, 1023
+      36:      	slli	a3, a2, 13
+      3a:      	xor	a2, a2, a3
+      3c:      	srli	a3, a2, 17
+      40:      	xor	a2, a2, a3
+      42:      	slli	a3, a2, 5
+      46:      	xor	a2, a2, a3
+      48:      	and	a3, a2, a4
+      4c:      	li	a5, 400
+      50:      	blt	a5, a1, 0x58 <main+0x3c>
+      54:      	andi	a3, a3, 63
+      58:      	sw	a3, 0(a0)
+      5a:      	addi	a0, a0, 4
+      5c:      	addi	a1, a1, -1
+      5e:      	bnez	a1, 0x36 <main+0x1a>
+      60:      	li	s0, 15
+      62:      	li	s1, 0
+      64:      	mv	a0, gp
+      66:      	lui	a1, 16
+      68:      	addi	a1, a1, 1600
+      6c:      	lui	a2, 17
+      6e:      	addi	a2, a2, -896
+      72:      	auipc	ra, 0
+      76:      	jalr	54(ra)
+      7a:      	lui	a0, 17
+      7c:      	addi	a0, a0, -896
+      80:      	li	a1, 400
+      84:      	lw	a2, 0(a0)
+      86:      	add	s1, s1, a2
+      88:      	addi	a0, a0, 4
+      8a:      	addi	a1, a1, -1
+      8c:      	bnez	a1, 0x84 <main+0x68>
+      8e:      	lw	a0, 0(gp)
+      92:      	addi	a0, a0, 1
+      94:      	sw	a0, 0(gp)
+      98:      	addi	s0, s0, -1
+      9a:      	bnez	s0, 0x64 <main+0x48>
+      9c:      	mv	a0, s1
+      9e:      	lw	ra, 12(sp)
+      a0:      	lw	s0, 8(sp)
+      a2:      	lw	s1, 4(sp)
+      a4:      	addi	sp, sp, 16
+      a6:      	ret
+
+000000a8 <matmult>:
+      a8:      	addi	sp, sp, -48
+      aa:      	sw	ra, 44(sp)
+      ac:      	sw	s0, 40(sp)
+      ae:      	sw	s1, 36(sp)
+      b0:      	sw	s2, 32(sp)
+      b2:      	sw	s3, 28(sp)
+      b4:      	sw	s4, 24(sp)
+      b6:      	sw	s5, 20(sp)
+      b8:      	sw	s6, 16(sp)
+      ba:      	sw	s7, 12(sp)
+      bc:      	mv	s0, a0
+      be:      	mv	s1, a1
+      c0:      	mv	s2, a2
+      c2:      	addi	s7, a0, 1600
+      c6:      	li	s3, 0
+      c8:      	li	s4, 0
+      ca:      	mv	s5, s0
+      cc:      	slli	a0, s3, 2
+      d0:      	add	s6, s1, a0
+      d4:      	lw	a0, 0(s5)
+      d8:      	lw	a1, 0(s6)
+      dc:      	auipc	ra, 0
+      e0:      	jalr	68(ra)
+      e4:      	add	s4, s4, a0
+      e6:      	addi	s5, s5, 4
+      e8:      	addi	s6, s6, 80
+      ec:      	addi	a0, s0, 80
+      f0:      	bne	s5, a0, 0xd4 <matmult+0x2c>
+      f4:      	sw	s4, 0(s2)
+      f8:      	addi	s2, s2, 4
+      fa:      	addi	s3, s3, 1
+      fc:      	li	a0, 20
+      fe:      	bne	s3, a0, 0xc8 <matmult+0x20>
+     102:      	addi	s0, s0, 80
+     106:      	bne	s0, s7, 0xc6 <matmult+0x1e>
+     10a:      	lw	ra, 44(sp)
+     10c:      	lw	s0, 40(sp)
+     10e:      	lw	s1, 36(sp)
+     110:      	lw	s2, 32(sp)
+     112:      	lw	s3, 28(sp)
+     114:      	lw	s4, 24(sp)
+     116:      	lw	s5, 20(sp)
+     118:      	lw	s6, 16(sp)
+     11a:      	lw	s7, 12(sp)
+     11c:      	addi	sp, sp, 48
+     11e:      	ret
+
+00000120 <__mulsi3>:
+     120:      	mv	a2, a0
+     122:      	li	a0, 0
+     124:      	andi	a3, a1, 1
+     128:      	beqz	a3, 0x12c <__mulsi3+0xc>
+     12a:      	add	a0, a0, a2
+     12c:      	srli	a1, a1, 1
+     12e:      	slli	a2, a2, 1
+     130:      	bnez	a1, 0x124 <__mulsi3+0x4>
+     132:      	ret
@@ -0,0 +1,128 @@
+# Integer matrix multiply in the style of Embench's matmult-int: C = A * B for 20 x 20 matrices of
+# pseudo-random values, with the multiplies done by __mulsi3 as in any rv32i build. After each pass the sum
+# of C is added to the checksum and A[0][0] is incremented. Prints the checksum.
+    .equ PASSES, 15
+    .equ DATA, 0x10000
+    .equ UPPER, 20
+    .equ ROW, UPPER * 4
+    .equ MATA, 0x000
+    .equ MATB, MATA + UPPER * ROW
+    .equ MATC, MATB + UPPER * ROW
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main
+    li a7, 1
+    ecall
+    li a7, 10
+    ecall
+
+main:
+    addi sp, sp, -16
+    sw ra, 12(sp)
+    sw s0, 8(sp)
+    sw s1, 4(sp)
+    # A gets values below 1024, B below 64 (xorshift32)
+    addi a0, gp, MATA
+    li a1, UPPER * UPPER * 2
+    li a2, 0x2545f491
+    li a4, 1023
+1:  slli a3, a2, 13
+    xor a2, a2, a3
+    srli a3, a2, 17
+    xor a2, a2, a3
+    slli a3, a2, 5
+    xor a2, a2, a3
+    and a3, a2, a4
+    li a5, UPPER * UPPER
+    bgt a1, a5, 2f
+    andi a3, a3, 63
+2:  sw a3, 0(a0)
+    addi a0, a0, 4
+    addi a1, a1, -1
+    bnez a1, 1b
+    li s0, PASSES
+    li s1, 0
+3:  addi a0, gp, MATA
+    li a1, DATA + MATB
+    li a2, DATA + MATC
+    call matmult
+    li a0, DATA + MATC
+    li a1, UPPER * UPPER
+4:  lw a2, 0(a0)
+    add s1, s1, a2
+    addi a0, a0, 4
+    addi a1, a1, -1
+    bnez a1, 4b
+    lw a0, MATA(gp)
+    addi a0, a0, 1
+    sw a0, MATA(gp)
+    addi s0, s0, -1
+    bnez s0, 3b
+    mv a0, s1
+    lw ra, 12(sp)
+    lw s0, 8(sp)
+    lw s1, 4(sp)
+    addi sp, sp, 16
+    ret
+
+# void matmult(int A[][UPPER], int B[][UPPER], int C[][UPPER])
+matmult:
+    addi sp, sp, -48
+    sw ra, 44(sp)
+    sw s0, 40(sp)
+    sw s1, 36(sp)
+    sw s2, 32(sp)
+    sw s3, 28(sp)
+    sw s4, 24(sp)
+    sw s5, 20(sp)
+    sw s6, 16(sp)
+    sw s7, 12(sp)
+    mv s0, a0               # row of A
+    mv s1, a1
+    mv s2, a2               # element of C
+    addi s7, a0, UPPER * ROW
+1:  li s3, 0                # j
+2:  li s4, 0                # sum
+    mv s5, s0               # A[i][k]
+    slli a0, s3, 2
+    add s6, s1, a0          # B[k][j]
+3:  lw a0, 0(s5)
+    lw a1, 0(s6)
+    call __mulsi3
+    add s4, s4, a0
+    addi s5, s5, 4
+    addi s6, s6, ROW
+    addi a0, s0, ROW
+    bne s5, a0, 3b
+    sw s4, 0(s2)
+    addi s2, s2, 4
+    addi s3, s3, 1
+    li a0, UPPER
+    bne s3, a0, 2b
+    addi s0, s0, ROW
+    bne s0, s7, 1b
+    lw ra, 44(sp)
+    lw s0, 40(sp)
+    lw s1, 36(sp)
+    lw s2, 32(sp)
+    lw s3, 28(sp)
+    lw s4, 24(sp)
+    lw s5, 20(sp)
+    lw s6, 16(sp)
+    lw s7, 12(sp)
+    addi sp, sp, 48
+    ret
+
+__mulsi3:
+    mv a2, a0
+    li a0, 0
+1:  andi a3, a1, 1
+    beqz a3, 2f
+    add a0, a0, a2
+2:  srli a1, a1, 1
+    slli a2, a2, 1
+    bnez a1, 1b
+    ret
@@ -0,0 +1,110 @@
+
+qsort.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0:      	lui	sp, 20
+       4:      	addi	sp, sp, -16
+       6:      	lui	gp, 16
+       8:      	auipc	ra, 0
+       c:      	jalr	20(ra)
+      10:      	li	a7, 1
+      12:      	ecall	
+      16:      	li	a7, 10
+      18:      	ecall	
+
+0000001c <main>:
+      1c:      	addi	sp, sp, -16
+      1e:      	sw	ra, 12(sp)
+      20:      	sw	s0, 8(sp)
+      22:      	sw	s1, 4(sp)
+      24:      	sw	s2, 0(sp)
+      26:      	li	s0, 100
+      2a:      	lui	s1, 152671
+      2e:      	addi	s1, s1, 1169
+      32:      	li	s2, 0
+      34:      	mv	a0, gp
+      36:      	li	a1, 512
+      3a:      	slli	a2, s1, 13
+      3e:      	xor	s1, s1, a2
+      40:      	srli	a2, s1, 17
+      44:      	xor	s1, s1, a2
+      46:      	slli	a2, s1, 5
+      4a:      	xor	s1, s1, a2
+      4c:      	sw	s1, 0(a0)
+      4e:      	addi	a0, a0, 4
+      50:      	addi	a1, a1, -1
+      52:      	bnez	a1, 0x3a <main+0x1e>
+      54:      	mv	a0, gp
+      56:      	addi	a1, a0, 2044
+      5a:      	auipc	ra, 0
+      5e:      	jalr	70(ra)
+      62:      	mv	a0, gp
+      64:      	addi	a1, a0, 2044
+      68:      	lw	a2, 0(a0)
+      6a:      	slli	a3, s2, 1
+      6e:      	srli	s2, s2, 31
+      72:      	or	s2, s2, a3
+      76:      	xor	s2, s2, a2
+      7a:      	beq	a0, a1, 0x8a <main+0x6e>
+      7e:      	addi	a0, a0, 4
+      80:      	lw	a3, 0(a0)
+      82:      	blt	a3, a2, 0x92 <main+0x76>
+      86:      	mv	a2, a3
+      88:      	j	0x6a <main+0x4e>
+      8a:      	addi	s0, s0, -1
+      8c:      	bnez	s0, 0x34 <main+0x18>
+      8e:      	mv	a0, s2
+      90:      	j	0x94 <main+0x78>
+      92:      	li	a0, -1
+      94:      	lw	ra, 12(sp)
+      96:      	lw	s0, 8(sp)
+      98:      	lw	s1, 4(sp)
+      9a:      	lw	s2, 0(sp)
+      9c:      	addi	sp, sp, 16
+      9e:      	ret
+
+000000a0 <quicksort>:
+      a0:      	bgeu	a0, a1, 0x10a <quicksort+0x6a>
+      a4:      	addi	sp, sp, -16
+      a6:      	sw	ra, 12(sp)
+      a8:      	sw	s0, 8(sp)
+      aa:      	sw	s1, 4(sp)
+      ac:      	mv	s0, a0
+      ae:      	mv	s1, a1
+      b0:      	sub	a2, a1, a0
+      b4:      	srli	a2, a2, 3
+      b6:      	slli	a2, a2, 2
+      b8:      	add	a2, a2, a0
+      ba:      	lw	a2, 0(a2)
+      bc:      	mv	a3, a0
+      be:      	mv	a4, a1
+      c0:      	lw	a5, 0(a3)
+      c2:      	bge	a5, a2, 0xca <quicksort+0x2a>
+      c6:      	addi	a3, a3, 4
+      c8:      	j	0xc0 <quicksort+0x20>
+      ca:      	lw	a6, 0(a4)
+      ce:      	bge	a2, a6, 0xd6 <quicksort+0x36>
+      d2:      	addi	a4, a4, -4
+      d4:      	j	0xca <quicksort+0x2a>
+      d6:      	bltu	a4, a3, 0xe8 <quicksort+0x48>
+      da:      	sw	a6, 0(a3)
+      de:      	sw	a5, 0(a4)
+      e0:      	addi	a3, a3, 4
+      e2:      	addi	a4, a4, -4
+      e4:      	bgeu	a4, a3, 0xc0 <quicksort+0x20>
+      e8:      	sw	a3, 0(sp)
+      ea:      	mv	a0, s0
+      ec:      	mv	a1, a4
+      ee:      	auipc	ra, 0
+      f2:      	jalr	-78(ra)
+      f6:      	lw	a0, 0(sp)
+      f8:      	mv	a1, s1
+      fa:      	auipc	ra, 0
+      fe:      	jalr	-90(ra)
+     102:      	lw	ra, 12(sp)
+     104:      	lw	s0, 8(sp)
+     106:      	lw	s1, 4(sp)
+     108:      	addi	sp, sp, 16
+     10a:      	ret
@@ -0,0 +1,75 @@
+
+rvc.o:	file format elf32-littleriscv
+
+Disassembly of section .text:
+
+00000000 <_start>:
+       0: 37 41 01 00  	lui	sp, 20
+       4: 41 11        	addi	sp, sp, -16
+       6: c1 61        	lui	gp, 16
+       8: 97 00 00 00  	auipc	ra, 0
+       c: e7 80 60 01  	jalr	22(ra)
+      10: a9 48        	li	a7, 10
+      12: 73 00 00 00  	ecall	
+
+00000016 <print>:
+      16: 85 48        	li	a7, 1
+      18: 73 00 00 00  	ecall	
+      1c: 82 80        	ret
+
+0000001e <main>:
+      1e: 01 71        	addi	sp, sp, -512
+      20: 23 2e 11 1e  	sw	ra, 508(sp)
+      24: e8 1f        	addi	a0, sp, 1020
+      26: 33 05 25 40  	sub	a0, a0, sp
+      2a: 97 00 00 00  	auipc	ra, 0
+      2e: e7 80 c0 fe  	jalr	-20(ra)
+      32: 93 05 20 4d  	li	a1, 1234
+      36: ae df        	sw	a1, 252(sp)
+      38: 03 25 c1 0f  	lw	a0, 252(sp)
+      3c: 97 00 00 00  	auipc	ra, 0
+      40: e7 80 a0 fd  	jalr	-38(ra)
+      44: 7e 55        	lw	a0, 252(sp)
+      46: 97 00 00 00  	auipc	ra, 0
+      4a: e7 80 00 fd  	jalr	-48(ra)
+      4e: 85 65        	lui	a1, 1
+      50: 93 85 e5 62  	addi	a1, a1, 1582
+      54: 23 20 b1 0a  	sw	a1, 160(sp)
+      58: 0a 55        	lw	a0, 160(sp)
+      5a: 97 00 00 00  	auipc	ra, 0
+      5e: e7 80 c0 fb  	jalr	-68(ra)
+      62: 0e 84        	mv	s0, gp
+      64: 85 64        	lui	s1, 1
+      66: 93 84 14 0e  	addi	s1, s1, 225
+      6a: 64 dc        	sw	s1, 124(s0)
+      6c: 03 a5 c1 07  	lw	a0, 124(gp)
+      70: 97 00 00 00  	auipc	ra, 0
+      74: e7 80 60 fa  	jalr	-90(ra)
+      78: 68 5c        	lw	a0, 124(s0)
+      7a: 97 00 00 00  	auipc	ra, 0
+      7e: e7 80 c0 f9  	jalr	-100(ra)
+      82: 89 65        	lui	a1, 2
+      84: 93 85 d5 23  	addi	a1, a1, 573
+      88: 23 a0 b1 04  	sw	a1, 64(gp)
+      8c: 28 40        	lw	a0, 64(s0)
+      8e: 97 00 00 00  	auipc	ra, 0
+      92: e7 80 80 f8  	jalr	-120(ra)
+      96: b7 04 00 80  	lui	s1, 524288
+      9a: e1 80        	srli	s1, s1, 24
+      9c: 26 85        	mv	a0, s1
+      9e: 97 00 00 00  	auipc	ra, 0
+      a2: e7 80 80 f7  	jalr	-136(ra)
+      a6: b7 04 00 80  	lui	s1, 524288
+      aa: d1 84        	srai	s1, s1, 20
+      ac: 26 85        	mv	a0, s1
+      ae: 97 00 00 00  	auipc	ra, 0
+      b2: e7 80 80 f6  	jalr	-152(ra)
+      b6: 85 64        	lui	s1, 1
+      b8: 93 84 44 23  	addi	s1, s1, 564
+      bc: c1 98        	andi	s1, s1, -16
+      be: 26 85        	mv	a0, s1
+      c0: 97 00 00 00  	auipc	ra, 0
+      c4: e7 80 60 f5  	jalr	-170(ra)
+      c8: 83 20 c1 1f  	lw	ra, 508(sp)
+      cc: 13 01 01 20  	addi	sp, sp, 512
+      d0: 82 80        	ret
@@ -0,0 +1,84 @@
+# Regression test for the RVC expansions and JALR fixed together: each line of output is checked against
+# tests-rv32ic/rvc.out. Only for the tests-rv32ic build: the c. forms are written out, and the 32-bit loads and
+# stores they are compared with are kept uncompressed with .option norvc.
+    .equ DATA, 0x10000
+
+    .text
+_start:
+    li sp, 0x13ff0
+    li gp, DATA
+    call main               # auipc ra; jalr ra, ra, off: the target is read before the link is written
+    li a7, 10
+    ecall
+
+# prints a0
+print:
+    li a7, 1
+    ecall
+    ret
+
+main:
+    addi sp, sp, -512
+    sw ra, 508(sp)
+
+    # C.ADDI4SPN with imm[9] set: 1020
+    c.addi4spn a0, sp, 1020
+    sub a0, a0, sp
+    call print
+
+    # C.SWSP and C.LWSP at offsets with bits 5 to 7 set, against the 32-bit forms: 1234 1234 5678
+    li a1, 1234
+    c.swsp a1, 252(sp)
+    .option push
+    .option norvc
+    lw a0, 252(sp)
+    .option pop
+    call print
+    c.lwsp a0, 252(sp)
+    call print
+    li a1, 5678
+    .option push
+    .option norvc
+    sw a1, 160(sp)
+    .option pop
+    c.lwsp a0, 160(sp)
+    call print
+
+    # C.SW (source rs2', base rs1') and C.LW at offsets with bit 6 set: 4321 4321 8765
+    mv s0, gp
+    li s1, 4321
+    c.sw s1, 124(s0)
+    .option push
+    .option norvc
+    lw a0, 124(gp)
+    .option pop
+    call print
+    c.lw a0, 124(s0)
+    call print
+    li a1, 8765
+    .option push
+    .option norvc
+    sw a1, 64(gp)
+    .option pop
+    c.lw a0, 64(s0)
+    call print
+
+    # C.SRLI and C.SRAI with a shift amount of 16 or more: 128 -2048
+    li s1, 0x80000000
+    c.srli s1, 24
+    mv a0, s1
+    call print
+    li s1, 0x80000000
+    c.srai s1, 20
+    mv a0, s1
+    call print
+
+    # C.ANDI with a negative immediate: 4656
+    li s1, 0x1234
+    c.andi s1, -16
+    mv a0, s1
+    call print
+
+    lw ra, 508(sp)
+    addi sp, sp, 512
+    ret